@@ -1,67 +1,105 @@
 #ifndef ANALYTICS_CPP
 #define ANALYTICS_CPP
 #include "Analytics.h"
+#include "Metrics.h"
+#include "ScratchArena.h"
 #include <iostream>
 #include <algorithm>
 #include <map>
+#include <cmath>
 
 //SMA & EMA... for intervalAmount paramater, call for intervalAmount = values.size() + (periods - 1)
 
+//Every kernel records its calls as a Metrics stage named after it. A kernel's time includes the kernels it calls
+//(ADOSC includes ChaikinAD and ExponentialMovingAverage)
+
 
 std::vector<std::pair<std::string, double>> Analytics::ChaikinAD(std::string symbol, std::string intervalLength, int intervalAmount){ 
-    //populate global data structure
+    //populate global data structure with a fresh window, then compute on it
+    valuesTS->clear();
     setValuesTS(symbol, intervalLength, std::to_string(intervalAmount));
+    return ChaikinAD(intervalAmount);
+}
+
+std::vector<std::pair<std::string, double>> Analytics::ChaikinAD(int intervalAmount){
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *adValues = arena.allocate<double>(OutputSize(intervalAmount));
+    ChaikinAD(intervalAmount, adValues);
+    //newest to oldest, as the bars
+    std::vector<std::pair<std::string, double>> result(intervalAmount);
+    for(int i = 0; i < intervalAmount; i++){
+        result[i] = {getTimeStampTSAt(i), adValues[i]};
+    }
+    return result;
+}
+
+void Analytics::ChaikinAD(int intervalAmount, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("ChaikinAD");
+    Metrics::Span span(STAGE);
     if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
         throw std::invalid_argument("Analytics.cpp @ ChaikinAD: Invalid paramater argument 'intervalAmount'\n");
     }
-    std::vector<std::pair<std::string, double>> result;
-    //Chakincurrent = Chaikinprevious + MFVcurrent
-    double currentMFV; //Money Flow Volume for current interval
-    double chaikinVal = 0.0; // initial chaikinVal
+    //Chakincurrent = Chaikinprevious + MFVcurrent, accumulated from the oldest interval to the newest
+    double chaikinVal = 0.0;
     for(int i = (intervalAmount - 1); i > -1; i--){
-        //get MFV for current interval
-        currentMFV = MoneyFlowVolume(i);
-        //calculate chaikinVal for next interval given perious chaikin
-        chaikinVal = chaikinVal + currentMFV;
-        //get timestamp for the current interval and chaikinVal and push into data struct
-        result.push_back({getTimeStampTSAt(i), chaikinVal});
-        
+        chaikinVal = chaikinVal + MoneyFlowVolume(i);
+        out[i] = chaikinVal;
     }
-    //return vector ordered from oldest to newest interval. 
-    //Reverse to preserve original ordering: newest to oldest
-    std::reverse(result.begin(), result.end());
-    return result;
 }
 
 std::vector<std::pair<std::string,double>> Analytics::ADOSC(std::string symbol, std::string intervalLength, int intervalAmount, int shortEMA, int longEMA){
-    std::vector<std::pair<std::string,double>> adoscValues;
     //validate EMA paramaters
-    if(longEMA < shortEMA || intervalAmount < 0){
-        throw std::invalid_argument("Analytics.cpp @ ADOSC: longEMA < shortEMA  OR intervalAmount < 0");
-    }
-    //get Chaikin AD line values
-    std::vector<std::pair<std::string, double>> adValues = ChaikinAD(symbol, intervalLength, intervalAmount + longEMA);
-    //validate success of ChaikinAD function
-    if(adValues.size() == 0){
-        throw std::invalid_argument("Analytics.cpp @ ADOSC: adValues.size() is 0... ChaikinAD() function returned an empty vector");
-    }
-    //cast from pair vector, to single type vector, and extract numeric data
-    std::vector<double> extractedADValues;
-    for (auto pair : adValues) {
-        extractedADValues.push_back(pair.second);
-    }
-    //EMA for short and long periods
-    std::vector<double> longEMAValues = ExponentialMovingAverage(extractedADValues, longEMA);
-    std::vector<double> shortEMAValues = ExponentialMovingAverage(extractedADValues, shortEMA );
-    //value pair variables for return vector
-    double valADOSC; std::string time;
+    if(shortEMA <= 0 || longEMA < shortEMA || intervalAmount < 0){
+        throw std::invalid_argument("Analytics.cpp @ ADOSC: shortEMA <= 0, longEMA < shortEMA  OR intervalAmount < 0");
+    }
+    //one fetch covering the EMA lookback, ChaikinAD below works on it without fetching again
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(intervalAmount + LookbackADOSC(longEMA)));
+    return ADOSC(intervalAmount, shortEMA, longEMA);
+}
+
+std::vector<std::pair<std::string,double>> Analytics::ADOSC(int intervalAmount, int shortEMA, int longEMA){
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *adoscValues = arena.allocate<double>(OutputSize(intervalAmount));
+    ADOSC(intervalAmount, shortEMA, longEMA, adoscValues);
+    std::vector<std::pair<std::string,double>> result(intervalAmount);
+    for(int i = 0; i < intervalAmount; i++){
+        result[i] = {getTimeStampTSAt(i), adoscValues[i]};
+    }
+    return result;
+}
+
+void Analytics::ADOSC(int intervalAmount, int shortEMA, int longEMA, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("ADOSC");
+    Metrics::Span span(STAGE);
+    //validate EMA paramaters
+    if(shortEMA <= 0 || longEMA < shortEMA || intervalAmount < 0){
+        throw std::invalid_argument("Analytics.cpp @ ADOSC: shortEMA <= 0, longEMA < shortEMA  OR intervalAmount < 0");
+    }
+    int bars = intervalAmount + LookbackADOSC(longEMA);
+    if(static_cast<size_t>(bars) > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ ADOSC: valuesTS holds less than intervalAmount + LookbackADOSC(longEMA) bars");
+    }
+    //the A/D line and both EMAs of it are temporaries of this call, given back together when 'scope' ends
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *adValues = arena.allocate<double>(bars);
+    double *longEMAValues = arena.allocate<double>(bars - longEMA + 1);
+    double *shortEMAValues = arena.allocate<double>(bars - shortEMA + 1);
+    ChaikinAD(bars, adValues);
+    ExponentialMovingAverage(adValues, bars, longEMA, longEMAValues);
+    ExponentialMovingAverage(adValues, bars, shortEMA, shortEMAValues);
     //run through ADOSC equation and get 'intervalAmount' data points
     for(int i = 0; i < intervalAmount; i++){
-        valADOSC = shortEMAValues.at(i) - longEMAValues.at(i);
-        time = adValues.at(i).first;
-        adoscValues.push_back({time, valADOSC});
+        out[i] = shortEMAValues[i] - longEMAValues[i];
     }
-    return adoscValues;
+}
+
+int Analytics::LookbackADOSC(int longEMA){
+    //the AD line is taken over 'longEMA' extra intervals so both EMAs have data behind the oldest output
+    return longEMA;
 }
 
 std::vector<std::pair<std::string, double>> Analytics::ADX(std::string symbol, std::string intervalLength, std::string intervalAmount){
@@ -69,6 +107,901 @@ std::vector<std::pair<std::string, double>> Analytics::ADX(std::string symbol, s
 }
 
 
+//PRICE TRANSFORMS
+//symbol versions fetch a fresh window and format it, the int versions run the kernels straight on the columns
+
+//outputsize the API uses when none is given
+static const std::string DEFAULT_INTERVAL_AMOUNT = "30";
+
+std::vector<std::string> Analytics::AVGPRICE(std::string symbol, std::string intervalLength, std::string intervalAmount){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, intervalAmount);
+    return DateValueStrings(AVGPRICE(static_cast<int>(valuesTS->size())));
+}
+
+std::vector<double> Analytics::AVGPRICE(int intervalAmount){
+    std::vector<double> result(OutputSize(intervalAmount));
+    AVGPRICE(intervalAmount, result.data());
+    return result;
+}
+
+void Analytics::AVGPRICE(int intervalAmount, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("AVGPRICE");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ AVGPRICE: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::AvgPrice(valuesTS->getOpens().data(), valuesTS->getHighs().data(), valuesTS->getLows().data(),
+                             valuesTS->getCloses().data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::BOP(std::string symbol, std::string intervalLength, std::string intervalAmount){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, intervalAmount);
+    return DateValueStrings(BOP(static_cast<int>(valuesTS->size())));
+}
+
+std::vector<double> Analytics::BOP(int intervalAmount){
+    std::vector<double> result(OutputSize(intervalAmount));
+    BOP(intervalAmount, result.data());
+    return result;
+}
+
+void Analytics::BOP(int intervalAmount, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("BOP");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ BOP: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Bop(valuesTS->getOpens().data(), valuesTS->getHighs().data(), valuesTS->getLows().data(),
+                        valuesTS->getCloses().data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::CEIL(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string typeOfData){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, intervalAmount);
+    return DateValueStrings(CEIL(static_cast<int>(valuesTS->size()), typeOfData.empty() ? "close" : typeOfData));
+}
+
+std::vector<double> Analytics::CEIL(int intervalAmount, std::string typeOfData){
+    std::vector<double> result(OutputSize(intervalAmount));
+    CEIL(intervalAmount, typeOfData, result.data());
+    return result;
+}
+
+void Analytics::CEIL(int intervalAmount, std::string typeOfData, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("CEIL");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ CEIL: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Ceil(getSeries(typeOfData).data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::DIV(std::string symbol, std::string intervalLength, std::string seriesType1, std::string seriesType2){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, DEFAULT_INTERVAL_AMOUNT);
+    return DateValueStrings(DIV(static_cast<int>(valuesTS->size()), seriesType1, seriesType2));
+}
+
+std::vector<double> Analytics::DIV(int intervalAmount, std::string seriesType1, std::string seriesType2){
+    std::vector<double> result(OutputSize(intervalAmount));
+    DIV(intervalAmount, seriesType1, seriesType2, result.data());
+    return result;
+}
+
+void Analytics::DIV(int intervalAmount, std::string seriesType1, std::string seriesType2, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("DIV");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ DIV: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Div(getSeries(seriesType1).data(), getSeries(seriesType2).data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::EXP(std::string symbol, std::string intervalLength, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, DEFAULT_INTERVAL_AMOUNT);
+    return DateValueStrings(EXP(static_cast<int>(valuesTS->size()), seriesType));
+}
+
+std::vector<double> Analytics::EXP(int intervalAmount, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    EXP(intervalAmount, seriesType, result.data());
+    return result;
+}
+
+void Analytics::EXP(int intervalAmount, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("EXP");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ EXP: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Exp(getSeries(seriesType).data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::FLOOR(std::string symbol, std::string intervalLength, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, DEFAULT_INTERVAL_AMOUNT);
+    return DateValueStrings(FLOOR(static_cast<int>(valuesTS->size()), seriesType));
+}
+
+std::vector<double> Analytics::FLOOR(int intervalAmount, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    FLOOR(intervalAmount, seriesType, result.data());
+    return result;
+}
+
+void Analytics::FLOOR(int intervalAmount, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("FLOOR");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ FLOOR: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Floor(getSeries(seriesType).data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::HLC3(std::string symbol, std::string intervalLength){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, DEFAULT_INTERVAL_AMOUNT);
+    return DateValueStrings(HLC3(static_cast<int>(valuesTS->size())));
+}
+
+std::vector<double> Analytics::HLC3(int intervalAmount){
+    std::vector<double> result(OutputSize(intervalAmount));
+    HLC3(intervalAmount, result.data());
+    return result;
+}
+
+void Analytics::HLC3(int intervalAmount, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("HLC3");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ HLC3: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::TypPrice(valuesTS->getHighs().data(), valuesTS->getLows().data(), valuesTS->getCloses().data(),
+                             out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::LN(std::string symbol, std::string intervalLength, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, DEFAULT_INTERVAL_AMOUNT);
+    return DateValueStrings(LN(static_cast<int>(valuesTS->size()), seriesType));
+}
+
+std::vector<double> Analytics::LN(int intervalAmount, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    LN(intervalAmount, seriesType, result.data());
+    return result;
+}
+
+void Analytics::LN(int intervalAmount, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("LN");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ LN: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Ln(getSeries(seriesType).data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::LOG10(std::string symbol, std::string intervalLength, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, DEFAULT_INTERVAL_AMOUNT);
+    return DateValueStrings(LOG10(static_cast<int>(valuesTS->size()), seriesType));
+}
+
+std::vector<double> Analytics::LOG10(int intervalAmount, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    LOG10(intervalAmount, seriesType, result.data());
+    return result;
+}
+
+void Analytics::LOG10(int intervalAmount, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("LOG10");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ LOG10: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Log10(getSeries(seriesType).data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::MEDPRICE(std::string symbol, std::string intervalLength, std::string intervalAmount){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, intervalAmount);
+    return DateValueStrings(MEDPRICE(static_cast<int>(valuesTS->size())));
+}
+
+std::vector<double> Analytics::MEDPRICE(int intervalAmount){
+    std::vector<double> result(OutputSize(intervalAmount));
+    MEDPRICE(intervalAmount, result.data());
+    return result;
+}
+
+void Analytics::MEDPRICE(int intervalAmount, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("MEDPRICE");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ MEDPRICE: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::MedPrice(valuesTS->getHighs().data(), valuesTS->getLows().data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::MULT(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType1, std::string seriesType2){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, intervalAmount);
+    return DateValueStrings(MULT(static_cast<int>(valuesTS->size()), seriesType1, seriesType2));
+}
+
+std::vector<double> Analytics::MULT(int intervalAmount, std::string seriesType1, std::string seriesType2){
+    std::vector<double> result(OutputSize(intervalAmount));
+    MULT(intervalAmount, seriesType1, seriesType2, result.data());
+    return result;
+}
+
+void Analytics::MULT(int intervalAmount, std::string seriesType1, std::string seriesType2, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("MULT");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ MULT: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Mult(getSeries(seriesType1).data(), getSeries(seriesType2).data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::SQRT(std::string symbol, std::string intervalLength, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, DEFAULT_INTERVAL_AMOUNT);
+    return DateValueStrings(SQRT(static_cast<int>(valuesTS->size()), seriesType));
+}
+
+std::vector<double> Analytics::SQRT(int intervalAmount, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    SQRT(intervalAmount, seriesType, result.data());
+    return result;
+}
+
+void Analytics::SQRT(int intervalAmount, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("SQRT");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ SQRT: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Sqrt(getSeries(seriesType).data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::SUB(std::string symbol, std::string intervalLength, std::string seriesType1, std::string seriesType2, std::string intervalAmount){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, intervalAmount);
+    return DateValueStrings(SUB(static_cast<int>(valuesTS->size()), seriesType1, seriesType2));
+}
+
+std::vector<double> Analytics::SUB(int intervalAmount, std::string seriesType1, std::string seriesType2){
+    std::vector<double> result(OutputSize(intervalAmount));
+    SUB(intervalAmount, seriesType1, seriesType2, result.data());
+    return result;
+}
+
+void Analytics::SUB(int intervalAmount, std::string seriesType1, std::string seriesType2, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("SUB");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ SUB: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::Sub(getSeries(seriesType1).data(), getSeries(seriesType2).data(), out, intervalAmount);
+}
+
+std::vector<std::string> Analytics::TYPPRICE(std::string symbol, std::string intervalLength, std::string intervalAmount){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, intervalAmount);
+    return DateValueStrings(TYPPRICE(static_cast<int>(valuesTS->size())));
+}
+
+std::vector<double> Analytics::TYPPRICE(int intervalAmount){
+    std::vector<double> result(OutputSize(intervalAmount));
+    TYPPRICE(intervalAmount, result.data());
+    return result;
+}
+
+void Analytics::TYPPRICE(int intervalAmount, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("TYPPRICE");
+    Metrics::Span span(STAGE);
+    //same formula as HLC3
+    HLC3(intervalAmount, out);
+}
+
+std::vector<std::string> Analytics::WCLPRICE(std::string symbol, std::string intervalLength, std::string intervalAmount){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, intervalAmount);
+    return DateValueStrings(WCLPRICE(static_cast<int>(valuesTS->size())));
+}
+
+std::vector<double> Analytics::WCLPRICE(int intervalAmount){
+    std::vector<double> result(OutputSize(intervalAmount));
+    WCLPRICE(intervalAmount, result.data());
+    return result;
+}
+
+void Analytics::WCLPRICE(int intervalAmount, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("WCLPRICE");
+    Metrics::Span span(STAGE);
+    if(intervalAmount < 0 || intervalAmount > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ WCLPRICE: Invalid paramater argument 'intervalAmount'");
+    }
+    PriceTransform::WclPrice(valuesTS->getHighs().data(), valuesTS->getLows().data(), valuesTS->getCloses().data(),
+                             out, intervalAmount);
+}
+
+
+
+//ROLLING EXTREMA
+//symbol versions fetch intervalAmount outputs plus their window, the int versions work on 'valuesTS' as it is
+
+//outputs a fetched window supports, at most 'wanted'
+static int WindowOutputs(size_t bars, int wanted, int timePeriod){
+    int available = static_cast<int>(bars) - timePeriod + 1;
+    return std::max(0, std::min(wanted, available));
+}
+
+std::vector<std::string> Analytics::AROON(std::string symbol, std::string intervalLength, std::string numPeriodsToExamine){
+    int periods = std::stoi(numPeriodsToExamine);
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(DEFAULT_INTERVAL_AMOUNT) + periods));
+    std::vector<std::array<double, 3>> aroon = AROON(WindowOutputs(valuesTS->size(), std::stoi(DEFAULT_INTERVAL_AMOUNT), periods + 1), periods);
+    std::vector<std::string> result;
+    for(size_t i = 0; i < aroon.size(); i++){
+        result.push_back(getTimeStampTSAt(static_cast<int>(i)));
+        result.push_back(FormatPrice(aroon[i][0]));
+        result.push_back(FormatPrice(aroon[i][1]));
+        result.push_back(FormatPrice(aroon[i][2]));
+    }
+    return result;
+}
+
+std::vector<std::string> Analytics::AROON(std::string symbol, std::string intervalLength){
+    return AROON(symbol, intervalLength, "14");
+}
+
+std::vector<std::array<double, 3>> Analytics::AROON(int intervalAmount, int numPeriodsToExamine){
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *up = arena.allocate<double>(OutputSize(intervalAmount));
+    double *down = arena.allocate<double>(OutputSize(intervalAmount));
+    double *oscillator = arena.allocate<double>(OutputSize(intervalAmount));
+    AROON(intervalAmount, numPeriodsToExamine, up, down, oscillator);
+    std::vector<std::array<double, 3>> result(intervalAmount);
+    for(int i = 0; i < intervalAmount; i++){
+        result[i] = {{up[i], down[i], oscillator[i]}};
+    }
+    return result;
+}
+
+void Analytics::AROON(int intervalAmount, int numPeriodsToExamine, double *up, double *down, double *oscillator){
+    static const Metrics::Stage STAGE = Metrics::Register("AROON");
+    Metrics::Span span(STAGE);
+    //periods since the high range from 0 to numPeriodsToExamine, so the window holds one bar more
+    ValidateWindow("AROON", intervalAmount, numPeriodsToExamine + 1);
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    size_t *lowIndex = arena.allocate<size_t>(intervalAmount);
+    size_t *highIndex = arena.allocate<size_t>(intervalAmount);
+    RollingExtrema::Window(valuesTS->getHighs().data(), valuesTS->size(), numPeriodsToExamine + 1, intervalAmount,
+                           nullptr, nullptr, nullptr, highIndex);
+    RollingExtrema::Window(valuesTS->getLows().data(), valuesTS->size(), numPeriodsToExamine + 1, intervalAmount,
+                           nullptr, nullptr, lowIndex, nullptr);
+    for(int i = 0; i < intervalAmount; i++){
+        //index i is the current bar, a larger index is further back
+        up[i] = (static_cast<double>(numPeriodsToExamine) - (highIndex[i] - i)) / numPeriodsToExamine * 100.0;
+        down[i] = (static_cast<double>(numPeriodsToExamine) - (lowIndex[i] - i)) / numPeriodsToExamine * 100.0;
+        oscillator[i] = up[i] - down[i];
+    }
+}
+
+std::vector<std::string> Analytics::MAXINDEX(std::string symbol, std::string intervalLength, int timePeriod, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(DEFAULT_INTERVAL_AMOUNT) + timePeriod - 1));
+    std::vector<int> indexes = MAXINDEX(WindowOutputs(valuesTS->size(), std::stoi(DEFAULT_INTERVAL_AMOUNT), timePeriod), timePeriod, seriesType);
+    std::vector<std::string> result;
+    for(size_t i = 0; i < indexes.size(); i++){
+        result.push_back(getTimeStampTSAt(static_cast<int>(i)));
+        result.push_back(std::to_string(indexes[i]));
+    }
+    return result;
+}
+
+std::vector<int> Analytics::MAXINDEX(int intervalAmount, int timePeriod, std::string seriesType){
+    std::vector<int> result(OutputSize(intervalAmount));
+    MAXINDEX(intervalAmount, timePeriod, seriesType, result.data());
+    return result;
+}
+
+void Analytics::MAXINDEX(int intervalAmount, int timePeriod, std::string seriesType, int *out){
+    static const Metrics::Stage STAGE = Metrics::Register("MAXINDEX");
+    Metrics::Span span(STAGE);
+    ValidateWindow("MAXINDEX", intervalAmount, timePeriod);
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    size_t *maxIndex = arena.allocate<size_t>(intervalAmount);
+    RollingExtrema::Window(getSeries(seriesType).data(), valuesTS->size(), timePeriod, intervalAmount,
+                           nullptr, nullptr, nullptr, maxIndex);
+    std::copy(maxIndex, maxIndex + intervalAmount, out);
+}
+
+std::vector<std::string> Analytics::MIDPOINT(std::string symbol, std::string intervalLength, int timePeriod, std::string dataType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(DEFAULT_INTERVAL_AMOUNT) + timePeriod - 1));
+    return DateValueStrings(MIDPOINT(WindowOutputs(valuesTS->size(), std::stoi(DEFAULT_INTERVAL_AMOUNT), timePeriod), timePeriod, dataType));
+}
+
+std::vector<double> Analytics::MIDPOINT(int intervalAmount, int timePeriod, std::string dataType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    MIDPOINT(intervalAmount, timePeriod, dataType, result.data());
+    return result;
+}
+
+void Analytics::MIDPOINT(int intervalAmount, int timePeriod, std::string dataType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("MIDPOINT");
+    Metrics::Span span(STAGE);
+    ValidateWindow("MIDPOINT", intervalAmount, timePeriod);
+    //the highs go to 'out' and become the midpoints in place
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *lowest = arena.allocate<double>(intervalAmount);
+    RollingExtrema::Window(getSeries(dataType).data(), valuesTS->size(), timePeriod, intervalAmount,
+                           lowest, out, nullptr, nullptr);
+    for(int i = 0; i < intervalAmount; i++){
+        out[i] = (out[i] + lowest[i]) / 2.0;
+    }
+}
+
+std::vector<std::string> Analytics::MIDPRICE(std::string symbol, std::string intervalLength, int timePeriod, std::string intervalAmount){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(intervalAmount) + timePeriod - 1));
+    return DateValueStrings(MIDPRICE(WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), timePeriod), timePeriod));
+}
+
+std::vector<double> Analytics::MIDPRICE(int intervalAmount, int timePeriod){
+    std::vector<double> result(OutputSize(intervalAmount));
+    MIDPRICE(intervalAmount, timePeriod, result.data());
+    return result;
+}
+
+void Analytics::MIDPRICE(int intervalAmount, int timePeriod, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("MIDPRICE");
+    Metrics::Span span(STAGE);
+    ValidateWindow("MIDPRICE", intervalAmount, timePeriod);
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *lowest = arena.allocate<double>(intervalAmount);
+    RollingExtrema::Window(valuesTS->getHighs().data(), valuesTS->size(), timePeriod, intervalAmount,
+                           nullptr, out, nullptr, nullptr);
+    RollingExtrema::Window(valuesTS->getLows().data(), valuesTS->size(), timePeriod, intervalAmount,
+                           lowest, nullptr, nullptr, nullptr);
+    for(int i = 0; i < intervalAmount; i++){
+        out[i] = (out[i] + lowest[i]) / 2.0;
+    }
+}
+
+std::vector<std::string> Analytics::MIN(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType, int timePeriod){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(intervalAmount) + timePeriod - 1));
+    return DateValueStrings(MIN(WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), timePeriod), timePeriod, seriesType));
+}
+
+std::vector<double> Analytics::MIN(int intervalAmount, int timePeriod, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    MIN(intervalAmount, timePeriod, seriesType, result.data());
+    return result;
+}
+
+void Analytics::MIN(int intervalAmount, int timePeriod, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("MIN");
+    Metrics::Span span(STAGE);
+    ValidateWindow("MIN", intervalAmount, timePeriod);
+    RollingExtrema::Window(getSeries(seriesType).data(), valuesTS->size(), timePeriod, intervalAmount,
+                           out, nullptr, nullptr, nullptr);
+}
+
+std::vector<std::string> Analytics::MININDEX(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType, int timePeriod){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(intervalAmount) + timePeriod - 1));
+    std::vector<int> indexes = MININDEX(WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), timePeriod), timePeriod, seriesType);
+    std::vector<std::string> result;
+    for(size_t i = 0; i < indexes.size(); i++){
+        result.push_back(getTimeStampTSAt(static_cast<int>(i)));
+        result.push_back(std::to_string(indexes[i]));
+    }
+    return result;
+}
+
+std::vector<int> Analytics::MININDEX(int intervalAmount, int timePeriod, std::string seriesType){
+    std::vector<int> result(OutputSize(intervalAmount));
+    MININDEX(intervalAmount, timePeriod, seriesType, result.data());
+    return result;
+}
+
+void Analytics::MININDEX(int intervalAmount, int timePeriod, std::string seriesType, int *out){
+    static const Metrics::Stage STAGE = Metrics::Register("MININDEX");
+    Metrics::Span span(STAGE);
+    ValidateWindow("MININDEX", intervalAmount, timePeriod);
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    size_t *minIndex = arena.allocate<size_t>(intervalAmount);
+    RollingExtrema::Window(getSeries(seriesType).data(), valuesTS->size(), timePeriod, intervalAmount,
+                           nullptr, nullptr, minIndex, nullptr);
+    std::copy(minIndex, minIndex + intervalAmount, out);
+}
+
+std::vector<std::string> Analytics::MINMAX(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType, int timePeriod){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(intervalAmount) + timePeriod - 1));
+    std::vector<std::pair<double, double>> minMax = MINMAX(WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), timePeriod), timePeriod, seriesType);
+    std::vector<std::string> result;
+    for(size_t i = 0; i < minMax.size(); i++){
+        result.push_back(getTimeStampTSAt(static_cast<int>(i)));
+        result.push_back(FormatPrice(minMax[i].first));
+        result.push_back(FormatPrice(minMax[i].second));
+    }
+    return result;
+}
+
+std::vector<std::pair<double, double>> Analytics::MINMAX(int intervalAmount, int timePeriod, std::string seriesType){
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *lowest = arena.allocate<double>(OutputSize(intervalAmount));
+    double *highest = arena.allocate<double>(OutputSize(intervalAmount));
+    MINMAX(intervalAmount, timePeriod, seriesType, lowest, highest);
+    std::vector<std::pair<double, double>> result(intervalAmount);
+    for(int i = 0; i < intervalAmount; i++){
+        result[i] = {lowest[i], highest[i]};
+    }
+    return result;
+}
+
+void Analytics::MINMAX(int intervalAmount, int timePeriod, std::string seriesType, double *min, double *max){
+    static const Metrics::Stage STAGE = Metrics::Register("MINMAX");
+    Metrics::Span span(STAGE);
+    ValidateWindow("MINMAX", intervalAmount, timePeriod);
+    RollingExtrema::Window(getSeries(seriesType).data(), valuesTS->size(), timePeriod, intervalAmount,
+                           min, max, nullptr, nullptr);
+}
+
+std::vector<std::string> Analytics::MINMAXINDEX(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType, int timePeriod){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(intervalAmount) + timePeriod - 1));
+    std::vector<std::pair<int, int>> indexes = MINMAXINDEX(WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), timePeriod), timePeriod, seriesType);
+    std::vector<std::string> result;
+    for(size_t i = 0; i < indexes.size(); i++){
+        result.push_back(getTimeStampTSAt(static_cast<int>(i)));
+        result.push_back(std::to_string(indexes[i].first));
+        result.push_back(std::to_string(indexes[i].second));
+    }
+    return result;
+}
+
+std::vector<std::pair<int, int>> Analytics::MINMAXINDEX(int intervalAmount, int timePeriod, std::string seriesType){
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    int *minIndex = arena.allocate<int>(OutputSize(intervalAmount));
+    int *maxIndex = arena.allocate<int>(OutputSize(intervalAmount));
+    MINMAXINDEX(intervalAmount, timePeriod, seriesType, minIndex, maxIndex);
+    std::vector<std::pair<int, int>> result(intervalAmount);
+    for(int i = 0; i < intervalAmount; i++){
+        result[i] = {minIndex[i], maxIndex[i]};
+    }
+    return result;
+}
+
+void Analytics::MINMAXINDEX(int intervalAmount, int timePeriod, std::string seriesType, int *minIndex, int *maxIndex){
+    static const Metrics::Stage STAGE = Metrics::Register("MINMAXINDEX");
+    Metrics::Span span(STAGE);
+    ValidateWindow("MINMAXINDEX", intervalAmount, timePeriod);
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    size_t *minPosition = arena.allocate<size_t>(intervalAmount);
+    size_t *maxPosition = arena.allocate<size_t>(intervalAmount);
+    RollingExtrema::Window(getSeries(seriesType).data(), valuesTS->size(), timePeriod, intervalAmount,
+                           nullptr, nullptr, minPosition, maxPosition);
+    std::copy(minPosition, minPosition + intervalAmount, minIndex);
+    std::copy(maxPosition, maxPosition + intervalAmount, maxIndex);
+}
+
+std::vector<std::string> Analytics::WILLR(std::string symbol, std::string interval, int timePeriod){
+    valuesTS->clear();
+    setValuesTS(symbol, interval, std::to_string(std::stoi(DEFAULT_INTERVAL_AMOUNT) + timePeriod - 1));
+    return DateValueStrings(WILLR(WindowOutputs(valuesTS->size(), std::stoi(DEFAULT_INTERVAL_AMOUNT), timePeriod), timePeriod));
+}
+
+std::vector<double> Analytics::WILLR(int intervalAmount, int timePeriod){
+    std::vector<double> result(OutputSize(intervalAmount));
+    WILLR(intervalAmount, timePeriod, result.data());
+    return result;
+}
+
+void Analytics::WILLR(int intervalAmount, int timePeriod, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("WILLR");
+    Metrics::Span span(STAGE);
+    ValidateWindow("WILLR", intervalAmount, timePeriod);
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *lowest = arena.allocate<double>(intervalAmount);
+    double *highest = arena.allocate<double>(intervalAmount);
+    RollingExtrema::Window(valuesTS->getHighs().data(), valuesTS->size(), timePeriod, intervalAmount,
+                           nullptr, highest, nullptr, nullptr);
+    RollingExtrema::Window(valuesTS->getLows().data(), valuesTS->size(), timePeriod, intervalAmount,
+                           lowest, nullptr, nullptr, nullptr);
+    ColumnView<double> closes = valuesTS->getCloses();
+    for(int i = 0; i < intervalAmount; i++){
+        double range = highest[i] - lowest[i];
+        out[i] = range > 0.0 ? (highest[i] - closes[i]) / range * -100.0 : 0.0;
+    }
+}
+
+
+//ROLLING STATISTICS
+//symbol versions fetch intervalAmount outputs plus their window, the int versions work on 'valuesTS' as it is
+
+std::vector<std::string> Analytics::BBANDS(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string maType, std::string stdDeviationMultiplier, std::string typeOfData){
+    const int timePeriod = 20;
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(intervalAmount) + timePeriod - 1));
+    std::vector<std::array<double, 3>> bands = BBANDS(WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), timePeriod), timePeriod,
+                                                      std::stod(stdDeviationMultiplier), maType, typeOfData);
+    std::vector<std::string> result;
+    for(size_t i = 0; i < bands.size(); i++){
+        result.push_back(getTimeStampTSAt(static_cast<int>(i)));
+        result.push_back(FormatPrice(bands[i][0]));
+        result.push_back(FormatPrice(bands[i][1]));
+        result.push_back(FormatPrice(bands[i][2]));
+    }
+    return result;
+}
+
+std::vector<std::array<double, 3>> Analytics::BBANDS(int intervalAmount, int timePeriod, double stdDeviationMultiplier, std::string maType, std::string typeOfData){
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *upper = arena.allocate<double>(OutputSize(intervalAmount));
+    double *middle = arena.allocate<double>(OutputSize(intervalAmount));
+    double *lower = arena.allocate<double>(OutputSize(intervalAmount));
+    BBANDS(intervalAmount, timePeriod, stdDeviationMultiplier, maType, typeOfData, upper, middle, lower);
+    std::vector<std::array<double, 3>> result(intervalAmount);
+    for(int i = 0; i < intervalAmount; i++){
+        result[i] = {{upper[i], middle[i], lower[i]}};
+    }
+    return result;
+}
+
+void Analytics::BBANDS(int intervalAmount, int timePeriod, double stdDeviationMultiplier, std::string maType, std::string typeOfData,
+                       double *upper, double *middle, double *lower){
+    static const Metrics::Stage STAGE = Metrics::Register("BBANDS");
+    Metrics::Span span(STAGE);
+    if(maType != "SMA" && maType != "MA" && maType != "EMA"){
+        throw std::invalid_argument("Analytics.cpp @ BBANDS: 'maType' must be one of {SMA, MA, EMA}");
+    }
+    //the deviation is parked in 'upper' until the bands are formed
+    MovingStatistic("BBANDS", intervalAmount, timePeriod, typeOfData, &RollingMoments::getStdDev, upper);
+    if(maType == "EMA"){
+        //straight from the column, the EMA kernel reads through a pointer
+        ExponentialMovingAverage(getSeries(typeOfData).data(), static_cast<size_t>(intervalAmount) + timePeriod - 1, timePeriod, middle);
+    }
+    else{
+        MovingStatistic("BBANDS", intervalAmount, timePeriod, typeOfData, &RollingMoments::getMean, middle);
+    }
+    for(int i = 0; i < intervalAmount; i++){
+        double width = stdDeviationMultiplier * upper[i];
+        upper[i] = middle[i] + width;
+        lower[i] = middle[i] - width;
+    }
+}
+
+std::vector<std::string> Analytics::CORREL(std::string symbol1, std::string symbol2, std::string intervalLength, std::string intervalAmount, std::string seriesType1, std::string seriesType2){
+    const int timePeriod = 9;
+    //reject an unknown series before anything is fetched
+    SeriesOf(*valuesTS, seriesType1);
+    SeriesOf(*valuesTS, seriesType2);
+    std::string bars = std::to_string(std::stoi(intervalAmount) + timePeriod - 1);
+    //both series in one round trip
+    std::vector<BatchResultTS> fetched = FetchValuesTSBatch({{symbol1, intervalLength, bars}, {symbol2, intervalLength, bars}});
+    for(size_t i = 0; i < fetched.size(); i++){
+        if(!fetched[i].ok){
+            throw std::runtime_error("Analytics.cpp @ CORREL: " + fetched[i].error);
+        }
+    }
+    //pair the bars by timestamp, both stores are newest first. valuesTS keeps symbol1's bars that have a partner
+    const BarStore& first = fetched[0].bars;
+    const BarStore& second = fetched[1].bars;
+    ColumnView<int64_t> firstTimes = first.getTimeStamps();
+    ColumnView<int64_t> secondTimes = second.getTimeStamps();
+    ColumnView<double> secondValues = SeriesOf(second, seriesType2);
+    valuesTS->clear();
+    valuesTS->setHasTimeOfDay(first.hasTimeOfDay());
+    std::vector<double> paired;
+    size_t j = 0;
+    for(size_t i = 0; i < first.size(); i++){
+        while(j < second.size() && secondTimes[j] > firstTimes[i]){
+            j++;
+        }
+        if(j < second.size() && secondTimes[j] == firstTimes[i]){
+            valuesTS->append(first, i, i + 1);
+            paired.push_back(secondValues[j]);
+        }
+    }
+    int outputs = WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), timePeriod);
+    std::vector<double> correlation(outputs);
+    RollingCorrelation(getSeries(seriesType1).data(), paired.data(), outputs, timePeriod, correlation.data());
+    return DateValueStrings(correlation);
+}
+
+std::vector<double> Analytics::CORREL(int intervalAmount, int timePeriod, std::string seriesType1, std::string seriesType2){
+    std::vector<double> result(OutputSize(intervalAmount));
+    CORREL(intervalAmount, timePeriod, seriesType1, seriesType2, result.data());
+    return result;
+}
+
+void Analytics::CORREL(int intervalAmount, int timePeriod, std::string seriesType1, std::string seriesType2, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("CORREL");
+    Metrics::Span span(STAGE);
+    ValidateWindow("CORREL", intervalAmount, timePeriod);
+    RollingCorrelation(getSeries(seriesType1).data(), getSeries(seriesType2).data(), intervalAmount, timePeriod, out);
+}
+
+std::vector<std::string> Analytics::LINEARREG(std::string symbol, std::string intervalLength, int timePeriod, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(DEFAULT_INTERVAL_AMOUNT) + timePeriod - 1));
+    return DateValueStrings(LINEARREG(WindowOutputs(valuesTS->size(), std::stoi(DEFAULT_INTERVAL_AMOUNT), timePeriod), timePeriod, seriesType));
+}
+
+std::vector<double> Analytics::LINEARREG(int intervalAmount, int timePeriod, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    LINEARREG(intervalAmount, timePeriod, seriesType, result.data());
+    return result;
+}
+
+void Analytics::LINEARREG(int intervalAmount, int timePeriod, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("LINEARREG");
+    Metrics::Span span(STAGE);
+    MovingStatistic("LINEARREG", intervalAmount, timePeriod, seriesType, &RollingMoments::getLinearReg, out);
+}
+
+std::vector<std::string> Analytics::LINEARREGANGLE(std::string symbol, std::string intervalLength, int timePeriod, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(DEFAULT_INTERVAL_AMOUNT) + timePeriod - 1));
+    return DateValueStrings(LINEARREGANGLE(WindowOutputs(valuesTS->size(), std::stoi(DEFAULT_INTERVAL_AMOUNT), timePeriod), timePeriod, seriesType));
+}
+
+std::vector<double> Analytics::LINEARREGANGLE(int intervalAmount, int timePeriod, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    LINEARREGANGLE(intervalAmount, timePeriod, seriesType, result.data());
+    return result;
+}
+
+void Analytics::LINEARREGANGLE(int intervalAmount, int timePeriod, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("LINEARREGANGLE");
+    Metrics::Span span(STAGE);
+    MovingStatistic("LINEARREGANGLE", intervalAmount, timePeriod, seriesType, &RollingMoments::getSlope, out);
+    for(int i = 0; i < intervalAmount; i++){
+        out[i] = std::atan(out[i]) * 180.0 / 3.14159265358979323846;
+    }
+}
+
+std::vector<std::string> Analytics::LINEARREGINTERCEPT(std::string symbol, std::string intervalLength, int timePeriod, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(DEFAULT_INTERVAL_AMOUNT) + timePeriod - 1));
+    return DateValueStrings(LINEARREGINTERCEPT(WindowOutputs(valuesTS->size(), std::stoi(DEFAULT_INTERVAL_AMOUNT), timePeriod), timePeriod, seriesType));
+}
+
+std::vector<double> Analytics::LINEARREGINTERCEPT(int intervalAmount, int timePeriod, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    LINEARREGINTERCEPT(intervalAmount, timePeriod, seriesType, result.data());
+    return result;
+}
+
+void Analytics::LINEARREGINTERCEPT(int intervalAmount, int timePeriod, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("LINEARREGINTERCEPT");
+    Metrics::Span span(STAGE);
+    MovingStatistic("LINEARREGINTERCEPT", intervalAmount, timePeriod, seriesType, &RollingMoments::getLinearRegIntercept, out);
+}
+
+std::vector<std::string> Analytics::LINEARREGSLOPE(std::string symbol, std::string intervalLength, int timePeriod, std::string seriesType){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(DEFAULT_INTERVAL_AMOUNT) + timePeriod - 1));
+    return DateValueStrings(LINEARREGSLOPE(WindowOutputs(valuesTS->size(), std::stoi(DEFAULT_INTERVAL_AMOUNT), timePeriod), timePeriod, seriesType));
+}
+
+std::vector<double> Analytics::LINEARREGSLOPE(int intervalAmount, int timePeriod, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    LINEARREGSLOPE(intervalAmount, timePeriod, seriesType, result.data());
+    return result;
+}
+
+void Analytics::LINEARREGSLOPE(int intervalAmount, int timePeriod, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("LINEARREGSLOPE");
+    Metrics::Span span(STAGE);
+    MovingStatistic("LINEARREGSLOPE", intervalAmount, timePeriod, seriesType, &RollingMoments::getSlope, out);
+}
+
+std::vector<std::string> Analytics::PERCENT_B(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string timePeriod, std::string maType, std::string sd){
+    int periods = std::stoi(timePeriod);
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(intervalAmount) + periods - 1));
+    return DateValueStrings(PERCENT_B(WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), periods), periods, std::stod(sd), maType));
+}
+
+std::vector<double> Analytics::PERCENT_B(int intervalAmount, int timePeriod, double sd, std::string maType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    PERCENT_B(intervalAmount, timePeriod, sd, maType, result.data());
+    return result;
+}
+
+void Analytics::PERCENT_B(int intervalAmount, int timePeriod, double sd, std::string maType, double *out){
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    double *upper = arena.allocate<double>(OutputSize(intervalAmount));
+    double *middle = arena.allocate<double>(OutputSize(intervalAmount));
+    double *lower = arena.allocate<double>(OutputSize(intervalAmount));
+    BBANDS(intervalAmount, timePeriod, sd, maType, "close", upper, middle, lower);
+    ColumnView<double> closes = valuesTS->getCloses();
+    for(int i = 0; i < intervalAmount; i++){
+        double width = upper[i] - lower[i];
+        out[i] = width > 0.0 ? (closes[i] - lower[i]) / width : 0.5;
+    }
+}
+
+std::vector<std::string> Analytics::STDDEV(std::string symbol, std::string intervalLength, std::string seriesType, int timePeriod, int sd){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(DEFAULT_INTERVAL_AMOUNT) + timePeriod - 1));
+    return DateValueStrings(STDDEV(WindowOutputs(valuesTS->size(), std::stoi(DEFAULT_INTERVAL_AMOUNT), timePeriod), timePeriod, seriesType, sd));
+}
+
+std::vector<double> Analytics::STDDEV(int intervalAmount, int timePeriod, std::string seriesType, int sd){
+    std::vector<double> result(OutputSize(intervalAmount));
+    STDDEV(intervalAmount, timePeriod, seriesType, sd, result.data());
+    return result;
+}
+
+void Analytics::STDDEV(int intervalAmount, int timePeriod, std::string seriesType, int sd, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("STDDEV");
+    Metrics::Span span(STAGE);
+    MovingStatistic("STDDEV", intervalAmount, timePeriod, seriesType, &RollingMoments::getStdDev, out);
+    for(int i = 0; i < intervalAmount; i++){
+        out[i] *= sd;
+    }
+}
+
+std::vector<std::string> Analytics::TSF(std::string symbol, std::string intervalLength, int timePeriod, std::string seriesType, std::string intervalAmount){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(intervalAmount) + timePeriod - 1));
+    return DateValueStrings(TSF(WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), timePeriod), timePeriod, seriesType));
+}
+
+std::vector<double> Analytics::TSF(int intervalAmount, int timePeriod, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    TSF(intervalAmount, timePeriod, seriesType, result.data());
+    return result;
+}
+
+void Analytics::TSF(int intervalAmount, int timePeriod, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("TSF");
+    Metrics::Span span(STAGE);
+    MovingStatistic("TSF", intervalAmount, timePeriod, seriesType, &RollingMoments::getForecast, out);
+}
+
+std::vector<std::string> Analytics::VAR(std::string symbol, std::string intervalLength, int timePeriod, std::string seriesType, std::string intervalAmount){
+    valuesTS->clear();
+    setValuesTS(symbol, intervalLength, std::to_string(std::stoi(intervalAmount) + timePeriod - 1));
+    return DateValueStrings(VAR(WindowOutputs(valuesTS->size(), std::stoi(intervalAmount), timePeriod), timePeriod, seriesType));
+}
+
+std::vector<double> Analytics::VAR(int intervalAmount, int timePeriod, std::string seriesType){
+    std::vector<double> result(OutputSize(intervalAmount));
+    VAR(intervalAmount, timePeriod, seriesType, result.data());
+    return result;
+}
+
+void Analytics::VAR(int intervalAmount, int timePeriod, std::string seriesType, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("VAR");
+    Metrics::Span span(STAGE);
+    MovingStatistic("VAR", intervalAmount, timePeriod, seriesType, &RollingMoments::getVariance, out);
+}
+
 
 
 
@@ -79,9 +1012,9 @@ double Analytics::MoneyFlowMultiplier(int interval){
         throw std::invalid_argument("Analytics.cpp @ MoneyFlowMultiplier: Invalid paramater argument 'interval'\n");
     }
     //pull data values close high and low from response
-    double close = std::stod(valuesTS->at(interval).close);
-    double high = std::stod(valuesTS->at(interval).high);
-    double low = std::stod(valuesTS->at(interval).low);
+    double close = valuesTS->getCloses()[interval];
+    double high = valuesTS->getHighs()[interval];
+    double low = valuesTS->getLows()[interval];
     //check for division by 0
     if(high == low){
         throw std::runtime_error("Analytics.cpp @ MoneyFlowMultiplier: high and low values are equal resulting in division by 0\n");
@@ -95,96 +1028,146 @@ double Analytics::MoneyFlowVolume(int interval){
         throw std::invalid_argument("Analytics.cpp @ MoneyFlowVolume: Invalid paramater argument 'interval'\n");
     }
     double MFM = MoneyFlowMultiplier(interval);
-    double volume = std::stod(valuesTS->at(interval).volume);
+    double volume = static_cast<double>(valuesTS->getVolumes()[interval]);
     //MFV = MFM(current) * volume(current)
     return MFM * volume;
 }
 
-std::vector<double> Analytics::ExponentialMovingAverage(std::vector<double> values, int periods){
-    std::vector<double> emaValues;
-    if(periods <= 0 || values.size() < periods){
+std::vector<double> Analytics::ExponentialMovingAverage(const std::vector<double>& values, int periods){
+    std::vector<double> emaValues(periods > 0 && values.size() >= static_cast<size_t>(periods) ? values.size() - periods + 1 : 0);
+    ExponentialMovingAverage(values.data(), values.size(), periods, emaValues.data());
+    return emaValues;
+}
+
+void Analytics::ExponentialMovingAverage(const double *values, size_t count, int periods, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("ExponentialMovingAverage");
+    Metrics::Span span(STAGE);
+    if(periods <= 0 || count < static_cast<size_t>(periods)){
         throw std::invalid_argument("Analytics.cpp @ ExponentialMovingAverage: Invalid argument 'periods' or values.size() < periods");
     }
     double k = 2.0 / (static_cast<double>(periods) + 1.0); //smothing factor for EMA equation
     double sum = 0; //sum to calculate SMA value for initialEMA
-    for (int i = values.size() - periods; i < values.size(); i++){
-        sum += values.at(i);
-    }
-    //get SMA of the last element in 'values' 
-    double smaValue = (sum / periods);
-    //run SMA of last element through EMA equation to get initialEMA
-    double initialEMA = smaValue; 
-    emaValues.push_back(initialEMA);
-    //run through EMA equation starting with initialEMA
-    double emaToday;
-    double emaYesterday = initialEMA;
-    for(int i = values.size() - periods -1; i > -1; i--){
-        emaToday = (values.at(i) * k) + (emaYesterday * (1 - k));
-        emaValues.push_back(emaToday);
+    for (size_t i = count - periods; i < count; i++){
+        sum += values[i];
+    }
+    //the oldest output is the SMA of the oldest 'periods' values, the initialEMA
+    size_t oldest = count - periods;
+    out[oldest] = sum / periods;
+    //run through EMA equation towards the newest value, written in place so nothing needs reversing
+    double emaYesterday = out[oldest];
+    for(size_t i = oldest; i-- > 0;){
+        double emaToday = (values[i] * k) + (emaYesterday * (1 - k));
+        out[i] = emaToday;
         emaYesterday = emaToday;
     }
-    std::reverse(emaValues.begin(), emaValues.end());
-    return emaValues;
 }
 
-std::vector<double> Analytics::SimpleMovingAverage(std::vector<double> values, int periods){
+std::vector<double> Analytics::SimpleMovingAverage(const std::vector<double>& values, int periods){
     //call for setvalues (intervalAmount = values.size() + (periods -1) )
     //assuming 'values' is what we want
     //behind the scenes, we API call for 'values.size + periods' intervals, to initialize oldest value
     //needs those extra intervals provided by periods or else 'values' would get cut down by magnitude of 'periods'
-    std::vector<double> smaValues;
-    if(periods <= 0 || values.size() < periods){
+    std::vector<double> smaValues(periods > 0 && values.size() >= static_cast<size_t>(periods) ? values.size() - periods + 1 : 0);
+    SimpleMovingAverage(values.data(), values.size(), periods, smaValues.data());
+    return smaValues;
+}
+
+void Analytics::SimpleMovingAverage(const double *values, size_t count, int periods, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("SimpleMovingAverage");
+    Metrics::Span span(STAGE);
+    if(periods <= 0 || count < static_cast<size_t>(periods)){
         throw std::invalid_argument("Analytics.cpp @ SimpleMovingAverage: Invalid paramater argument 'periods' or values.size() < periods");
     }
+    //count - periods + 1 outputs. Window sum from the oldest output on: one bar newer adds the new value and drops the oldest.
+    //The window is summed afresh every 'periods' outputs so rounding cannot pile up on long series
+    size_t outputs = count - periods + 1;
     double sum = 0;
-    for (int i = values.size() - periods; i < values.size(); i++){
-        sum += values.at(i);
+    int untilResum = 0;
+    for(size_t i = outputs; i-- > 0;){
+        if(untilResum == 0){
+            sum = 0;
+            for(int j = 0; j < periods; j++){
+                sum += values[i + j];
+            }
+            untilResum = periods;
+        }
+        else{
+            sum += values[i] - values[i + periods];
+        }
+        untilResum--;
+        out[i] = sum / periods;
     }
-    //initial SMA value 
-    smaValues.push_back((sum / periods));
+}
 
-    int shiftOffset = 1;
-    for(int i = values.size() - periods -1; i > -1; i--){
-        sum = sum - values.at(values.size() - shiftOffset) + values.at(values.size() - periods - shiftOffset);
-        shiftOffset++;
+std::vector<double> Analytics::WeightedMovingAverage(const std::vector<double>& values, int periods){
+    std::vector<double> wmaValues(periods > 0 && values.size() >= static_cast<size_t>(periods) ? values.size() - periods + 1 : 0);
+    WeightedMovingAverage(values.data(), values.size(), periods, wmaValues.data());
+    return wmaValues;
+}
 
-        smaValues.push_back((sum / periods));
+void Analytics::WeightedMovingAverage(const double *values, size_t count, int periods, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("WeightedMovingAverage");
+    Metrics::Span span(STAGE);
+    if(periods <= 0 || count < static_cast<size_t>(periods)){
+        throw std::invalid_argument("Analytics.cpp @ WeightedMovingAverage: Invalid paramater argument 'periods' or values.size() < periods");
+    }
+    //count - periods + 1 outputs. Output i weights values[i] (newest) by 'periods' down to values[i + periods - 1] by 1
+    size_t outputs = count - periods + 1;
+    double divisor = periods * (periods + 1) / 2.0;
+    //window sums from the oldest output on. One bar newer takes one weight off every value in the window (the oldest drops out)
+    //and adds the new one at full weight. The window is summed afresh every 'periods' outputs so rounding cannot pile up
+    double sum = 0, weighted = 0;
+    for(size_t i = outputs; i-- > 0;){
+        if((outputs - 1 - i) % periods == 0){
+            sum = 0;
+            weighted = 0;
+            for(int j = 0; j < periods; j++){
+                sum += values[i + j];
+                weighted += (periods - j) * values[i + j];
+            }
+        }
+        else{
+            weighted += periods * values[i] - sum;
+            sum += values[i] - values[i + periods];
+        }
+        out[i] = weighted / divisor;
     }
-    std::reverse(smaValues.begin() , smaValues.end());
-
-    //size of return vector is values.size() - periods + 1
-    return smaValues;
 }
 
 std::vector<double> Analytics::TrueRange(int intervalAmount){
+    std::vector<double> trueRange(OutputSize(intervalAmount));
+    TrueRange(intervalAmount, trueRange.data());
+    return trueRange;
+}
+
+void Analytics::TrueRange(int intervalAmount, double *out){
+    static const Metrics::Stage STAGE = Metrics::Register("TrueRange");
+    Metrics::Span span(STAGE);
     //values.size() must be at least 'intervalAmount + 1'
     //intervalAmount to determine size of return vector
     //values ordered from newest data to oldest 
-    if(valuesTS->size() < intervalAmount +1){
+    if(intervalAmount < 0 || valuesTS->size() < intervalAmount +1){
         throw std::invalid_argument("Analytics.cpp @ TrueRange: size of valuesTS not big enough for trueRange to calculate given 'intervalAmount'");
     }
-    
-    std::vector<double> trueRange;
 
-    std::vector<double> highVals = getHighs();
-    std::vector<double> lowVals = getLows();
-    std::vector<double> closeVals = getCloses();
+    //views straight into the parsed columns, nothing is copied
+    ColumnView<double> highVals = getHighs();
+    ColumnView<double> lowVals = getLows();
+    ColumnView<double> closeVals = getCloses();
 
   
     double highLowRange;     // currentHigh - currentLow
     double absHighPrevClose; // |(currentHigh - previousClose)|
     double absLowPrevClose;  // |(currentLow - previousClose)|
 
-    for(int i = intervalAmount -1; i > -1; i--){
-        highLowRange     = highVals.at(i) - lowVals.at(i);
-        absHighPrevClose = std::abs(highVals.at(i) - closeVals.at(i + 1));
-        absLowPrevClose  = std::abs(lowVals.at(i) - closeVals.at(i + 1));
-        //take maximum value of all 3 and push into vector
-        trueRange.push_back(std::max({highLowRange, absHighPrevClose, absLowPrevClose}));
+    //filled newest to oldest, the previous close of bar i is close i + 1
+    for(int i = 0; i < intervalAmount; i++){
+        highLowRange     = highVals[i] - lowVals[i];
+        absHighPrevClose = std::abs(highVals[i] - closeVals[i + 1]);
+        absLowPrevClose  = std::abs(lowVals[i] - closeVals[i + 1]);
+        //take maximum value of all 3
+        out[i] = std::max({highLowRange, absHighPrevClose, absLowPrevClose});
     }
-    std::reverse(trueRange.begin(), trueRange.end());
-
-    return trueRange;
 }
 
 std::vector<double> Analytics::PositiveDirectionalMovement(std::vector<double> values, int intervalAmount){
@@ -199,52 +1182,98 @@ std::vector<double> Analytics::NegativeDirectionalMovement(std::vector<double> v
 
 
 
-std::vector<double> Analytics::getHighs(){
+ColumnView<double> Analytics::getHighs(){
     if(valuesTS->size() <= 0){
         throw std::invalid_argument("Analytics.cpp @ getHighs: valuesTS is empty");
     }
-    std::vector<double> highValues;
-    for(int i = 0; i < valuesTS->size(); i++){
-        highValues.push_back(std::stod(valuesTS->at(i).high));
-
-    }
-    return highValues;
+    return valuesTS->getHighs();
 }
-std::vector<double> Analytics::getLows(){
+ColumnView<double> Analytics::getLows(){
     if(valuesTS->size() <= 0){
         throw std::invalid_argument("Analytics.cpp @ getLows: valuesTS is empty");
     }
-    std::vector<double> lowValues;
-    for(int i = 0; i < valuesTS->size(); i++){
-        lowValues.push_back(std::stod(valuesTS->at(i).low));
-
-    }
-    return lowValues;
+    return valuesTS->getLows();
     
 }
-std::vector<double> Analytics::getOpens(){
+ColumnView<double> Analytics::getOpens(){
     if(valuesTS->size() <= 0){
         throw std::invalid_argument("Analytics.cpp @ getOpens: valuesTS is empty");
     }
-    std::vector<double> openValues;
-    for(int i = 0; i < valuesTS->size(); i++){
-        openValues.push_back(std::stod(valuesTS->at(i).open));
-
-    }
-    return openValues;
+    return valuesTS->getOpens();
     
 }
-std::vector<double> Analytics::getCloses(){
+ColumnView<double> Analytics::getCloses(){
     if(valuesTS->size() <= 0){
         throw std::invalid_argument("Analytics.cpp @ getCloses: valuesTS is empty");
     }
-    std::vector<double> closeValues;
-    for(int i = 0; i < valuesTS->size(); i++){
-        closeValues.push_back(std::stod(valuesTS->at(i).close));
+    return valuesTS->getCloses();
+    
+}
+ColumnView<double> Analytics::getSeries(const std::string& seriesType){
+    return SeriesOf(*valuesTS, seriesType);
+}
 
+ColumnView<double> Analytics::SeriesOf(const BarStore& bars, const std::string& seriesType){
+    if(seriesType == "open"){
+        return bars.getOpens();
     }
-    return closeValues;
-    
+    if(seriesType == "high"){
+        return bars.getHighs();
+    }
+    if(seriesType == "low"){
+        return bars.getLows();
+    }
+    if(seriesType == "close"){
+        return bars.getCloses();
+    }
+    throw std::invalid_argument("Analytics.cpp @ getSeries: 'seriesType' must be one of {open, high, low, close}");
+}
+
+void Analytics::ValidateWindow(const std::string& function, int intervalAmount, int timePeriod){
+    if(timePeriod <= 0 || intervalAmount < 0 || static_cast<size_t>(intervalAmount) + timePeriod - 1 > valuesTS->size()){
+        throw std::invalid_argument("Analytics.cpp @ " + function + ": 'timePeriod' <= 0 or valuesTS holds less than intervalAmount + timePeriod - 1 bars");
+    }
+}
+
+void Analytics::MovingStatistic(const std::string& function, int intervalAmount, int timePeriod, const std::string& seriesType,
+                                double (RollingMoments::*statistic)() const, double *out){
+    ValidateWindow(function, intervalAmount, timePeriod);
+    ColumnView<double> values = getSeries(seriesType);
+    RollingMoments moments(timePeriod);
+    //oldest bar of the oldest window first, output i is ready when bar i went in
+    for(size_t i = static_cast<size_t>(intervalAmount) + timePeriod - 1; i-- > 0;){
+        moments.update(values[i]);
+        if(i < static_cast<size_t>(intervalAmount)){
+            out[i] = (moments.*statistic)();
+        }
+    }
+}
+
+void Analytics::RollingCorrelation(const double *a, const double *b, int intervalAmount, int timePeriod, double *out){
+    if(intervalAmount <= 0){
+        return;
+    }
+    RollingMoments moments(timePeriod);
+    for(size_t i = static_cast<size_t>(intervalAmount) + timePeriod - 1; i-- > 0;){
+        moments.update(a[i], b[i]);
+        if(i < static_cast<size_t>(intervalAmount)){
+            out[i] = moments.getCorrelation();
+        }
+    }
+}
+
+size_t Analytics::OutputSize(int intervalAmount){
+    return intervalAmount > 0 ? static_cast<size_t>(intervalAmount) : 0;
+}
+
+std::vector<std::string> Analytics::DateValueStrings(const std::vector<double>& values){
+    std::vector<std::string> result;
+    result.reserve(values.size() * 2);
+    for(size_t i = 0; i < values.size(); i++){
+        result.push_back(getTimeStampTSAt(static_cast<int>(i)));
+        result.push_back(FormatPrice(values[i]));
+    }
+    return result;
 }
 
 
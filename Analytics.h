@@ -1,11 +1,25 @@
 #ifndef ANALYTICS_H
 #define ANALYTICS_H
 #include "GeneralInfo.h"
+#include "PriceTransform.h"
+#include "RollingExtrema.h"
+#include "RollingMoments.h"
 #include <vector>
 #include <array>
 #include <string>
 #include <utility>
 
+/// @brief Indicators over the bars of 'valuesTS', most in three flavours:
+///          - symbol versions fetch a fresh window and return it formatted, <date,value.....date,value>
+///          - int versions compute on the bars already in valuesTS and return the numbers, newest first
+///          - int versions ending in output pointers write into caller owned columns instead, one value per output.
+///            out[i] belongs to valuesTS->getTimeStamps()[i], so no timestamp is copied and nothing is parsed back,
+///            and a caller reusing its columns across calls allocates nothing per bar: temporaries come from the
+///            thread's ScratchArena, only the RollingMoments windows take a few period sized buffers.
+///            Each column must hold 'intervalAmount' values
+///
+///        std::vector<double> willr(outputs);                   //kept by the caller from call to call
+///        analytics.WILLR(outputs, 14, willr.data());            //willr[i] belongs to valuesTS->getTimeStamps()[i]
 class Analytics : public GeneralInfo{
     public:
         /// @brief Calculates the Chaikin A/D line distribution to determine advance or decline of an asset
@@ -15,6 +29,13 @@ class Analytics : public GeneralInfo{
         /// @param intervalAmount how many periods.. will only stick to 10.
         /// @return a vector consisting of <dateTime,valAD,dateTime,valAD.... etc
         std::vector<std::pair<std::string, double>> ChaikinAD(std::string symbol, std::string intervalLength, int intervalAmount);
+        /// @brief Chaikin A/D line computed on the bars already in 'valuesTS', no request is made.
+        /// @param intervalAmount how many periods, counted from the newest bar. valuesTS must hold at least that many
+        /// @return a vector consisting of <dateTime,valAD,dateTime,valAD.... etc
+        std::vector<std::pair<std::string, double>> ChaikinAD(int intervalAmount);
+        /// @brief Chaikin A/D line of the newest 'intervalAmount' bars of 'valuesTS' written to out[0 .. intervalAmount), newest first.
+        ///        No allocation, out[i] belongs to getTimeStampTSAt(i)
+        void ChaikinAD(int intervalAmount, double *out);
         /// @brief Calculates the Chaikin A/D Oscillator. Finds the relationship between increasing and decreasing volume with
         ///        price fluctuations. Measures momentum of ADL line using EMAs of varying length.
         /// @param symbol Company symbol name
@@ -24,6 +45,15 @@ class Analytics : public GeneralInfo{
         /// @param longEMA  Upper bound exponential moving average 
         /// @return vector containing the dateTime and respective ADOSC value for all intervals given in the form <date,ADOSC...date,ADOSC...etc>
         std::vector<std::pair<std::string, double>> ADOSC(std::string symbol, std::string intervalLength, int intervalAmount, int shortEMA, int longEMA);
+        /// @brief Chaikin A/D Oscillator computed on the bars already in 'valuesTS', no request is made.
+        ///        valuesTS must hold at least intervalAmount + LookbackADOSC(longEMA) bars
+        /// @return vector containing the dateTime and respective ADOSC value for all intervals given in the form <date,ADOSC...date,ADOSC...etc>
+        std::vector<std::pair<std::string, double>> ADOSC(int intervalAmount, int shortEMA, int longEMA);
+        /// @brief ADOSC of the bars already in 'valuesTS' written to out[0 .. intervalAmount), newest first.
+        ///        The A/D line and its EMAs live in the calling thread's ScratchArena, no heap allocation once it has grown
+        void ADOSC(int intervalAmount, int shortEMA, int longEMA, double *out);
+        /// @brief extra bars ADOSC needs behind its oldest output
+        static int LookbackADOSC(int longEMA);
         /// @brief Calculate Average Direcitonal Index. Custom version of default ADX. intervalAmounts are mutable here.
         ///        ADX = EMA(DX, intervalAmount)
         /// @param symbol Company symbol for query
@@ -85,6 +115,12 @@ class Analytics : public GeneralInfo{
         /// IMPORTANT: Also calculate AROON oscillator value by doing aroonUP - aroonDOWN
         /// @return vector containing AROON values for each interval in the form <date,AroonUP,AroonDOWN,AroonOSC......date,AroonUP,AroonDOWN,AroonOSC>
         std::vector<std::string> AROON(std::string symbol, std::string intervalLength);
+        /// @brief AROON computed on the bars already in 'valuesTS', no request is made. The window of each output is
+        ///        numPeriodsToExamine + 1 bars, so valuesTS must hold intervalAmount + numPeriodsToExamine bars
+        /// @return 'intervalAmount' {AroonUP, AroonDOWN, AroonOSC}, newest first
+        std::vector<std::array<double, 3>> AROON(int intervalAmount, int numPeriodsToExamine);
+        /// @brief written into three caller columns of intervalAmount values instead, no allocation
+        void AROON(int intervalAmount, int numPeriodsToExamine, double *up, double *down, double *oscillator);
         /// @brief Calculate the average true range over a specified number of periods (intervalAmount)
         /// @param symbol company symbol
         /// @param intervalLength length of each interval
@@ -113,6 +149,11 @@ class Analytics : public GeneralInfo{
         /// @param intervalAmount amount of intervals to calculate for
         /// @return vector: <date,AVGPRICE.....date,AVGPRICE>
         std::vector<std::string> AVGPRICE(std::string symbol, std::string intervalLength, std::string intervalAmount);
+        /// @brief AVGPRICE computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> AVGPRICE(int intervalAmount);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void AVGPRICE(int intervalAmount, double *out);
         /// @brief Bollinger Bands measures volatility located above and below a moving average. Creates upper, middle and lower band. 
         ///        Middle Band: moving average of data type. MB = SimpleMovingAverage(closePrices, 20 intervals). Use helper function
         ///        Upper Band: calculated by adding (stdDeviationMultiplier * standard deviation) 
@@ -125,6 +166,13 @@ class Analytics : public GeneralInfo{
         /// @param typeOfData type of data being one of: {high, low, open, close}
         /// @return vector: <date,upper,middle,lower.......date,upper,middle,lower>
         std::vector<std::string> BBANDS(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string maType, std::string stdDeviationMultiplier, std::string typeOfData);
+        /// @brief BBANDS (middle band SMA or EMA, bands at stdDeviationMultiplier population standard deviations) computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' {upper, middle, lower}, newest first
+        std::vector<std::array<double, 3>> BBANDS(int intervalAmount, int timePeriod, double stdDeviationMultiplier, std::string maType, std::string typeOfData);
+        /// @brief written into three caller columns of intervalAmount values instead, no allocation
+        void BBANDS(int intervalAmount, int timePeriod, double stdDeviationMultiplier, std::string maType, std::string typeOfData,
+                    double *upper, double *middle, double *lower);
         /// @brief Balance of Power (BOP) measures buying/selling pressure of an asset. 1 to -1 where 1 indicates high
         ///        BOP = (close - open) / (high - low)
         /// @param symbol company symbol
@@ -132,6 +180,11 @@ class Analytics : public GeneralInfo{
         /// @param intervalAmount # of intervals
         /// @return vector: <date,BOP.....date,BOP>
         std::vector<std::string> BOP(std::string symbol, std::string intervalLength, std::string intervalAmount);
+        /// @brief BOP, 0 for a bar with high == low computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> BOP(int intervalAmount);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void BOP(int intervalAmount, double *out);
         /// @brief Commodity Channel Index (CCI). 
         ///        1. Calc typical price... TP = (high+low+close) / 3
         ///        2. SMA of TP..... (summation of TP over N periods) / N
@@ -149,6 +202,11 @@ class Analytics : public GeneralInfo{
         /// @param typeOfData one of : {high, low, close, open} DEFAULT to: close
         /// @return vector: <date,CEIL......date,CEIL>
         std::vector<std::string> CEIL(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string typeOfData);
+        /// @brief CEIL computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> CEIL(int intervalAmount, std::string typeOfData);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void CEIL(int intervalAmount, std::string typeOfData, double *out);
         /// @brief Chande Momentum Oscillator (CMO). between 100 and -100. +50 means overbought conditions, suggesting a reverasal. -50 means oversold, suggesting upward reversal
         ///        1. Determine number of intervals calculating for
         ///        2. Calculate price changes for each period. current period price change = (currentPerData - prevPerData)
@@ -191,6 +249,12 @@ class Analytics : public GeneralInfo{
         /// @param seriesType2 The price type used for the second part of the technical indicator, defaulting to 'close'.
         /// @return A vector consisting of pairs of datetime and CORREL values in the form <datetime, CORREL, datetime, CORREL, ... etc.>
         std::vector<std::string> CORREL(std::string symbol1, std::string symbol2, std::string intervalLength, std::string intervalAmount, std::string seriesType1, std::string seriesType2);
+        /// @brief CORREL of two columns of the same symbol computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> CORREL(int intervalAmount, int timePeriod, std::string seriesType1, std::string seriesType2);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void CORREL(int intervalAmount, int timePeriod, std::string seriesType1, std::string seriesType2, double *out);
         /// @brief Calculates ConnorsRSI (CRSI), an indicator combining three components: a short-term RSI,
         ///        the streak of consecutive up or down closes, and the percent rank of the asset's price change,
         ///        to indicate oversold or overbought levels. It's used to identify potential buy or sell opportunities.
@@ -231,6 +295,11 @@ class Analytics : public GeneralInfo{
         /// @param seriesType2 The price type used as the denominator in the division (e.g., close).
         /// @return A vector containing dateTime and DIV value pairs in the form <dateTime, DIV, ...>.
         std::vector<std::string> DIV(std::string symbol, std::string intervalLength, std::string seriesType1 = "open", std::string seriesType2 = "close");
+        /// @brief DIV computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> DIV(int intervalAmount, std::string seriesType1, std::string seriesType2);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void DIV(int intervalAmount, std::string seriesType1, std::string seriesType2, double *out);
         /// @brief Calculates the Detrended Price Oscillator (DPO) for a given symbol and interval.
         ///        The DPO is used to eliminate long-term trends in prices by using a displaced moving average,
         ///        helping to identify cycles and overbought/oversold conditions in shorter time frames.
@@ -251,6 +320,11 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the exponential transformation is applied, typically 'close'.
         /// @return A vector containing dateTime and exponential value pairs in the form <dateTime, EXP, ...>.
         std::vector<std::string> EXP(std::string symbol, std::string intervalLength, std::string seriesType = "close");
+        /// @brief EXP computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> EXP(int intervalAmount, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void EXP(int intervalAmount, std::string seriesType, double *out);
         /// @brief Applies the mathematical floor function to the input data, transforming each value to the largest
         ///        previous integer. This is particularly useful for rounding down price data or other financial metrics.
         ///             FLOOR(Value) = Largest integer less than or equal to Value
@@ -259,6 +333,11 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the FLOOR function is applied, typically 'close'.
         /// @return A vector containing dateTime and FLOOR value pairs in the form <dateTime, FLOOR, ...>.
         std::vector<std::string> FLOOR(std::string symbol, std::string intervalLength, std::string seriesType = "close");
+        /// @brief FLOOR computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> FLOOR(int intervalAmount, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void FLOOR(int intervalAmount, std::string seriesType, double *out);
         /// @brief Generates Heikin-Ashi Candlesticks for the given symbol and interval.
         ///        Heikin-Ashi Candlesticks are used to identify market trends and potential price reversals by averaging
         ///        price values, thereby filtering out market noise and smoothing the price action.
@@ -274,6 +353,11 @@ class Analytics : public GeneralInfo{
         /// @param intervalLength Length of a single period, such as 1min, 5min, 15min, etc.
         /// @return A vector containing dateTime and HLC3 value pairs in the form <dateTime, HLC3, ...>.
         std::vector<std::string> HLC3(std::string symbol, std::string intervalLength);
+        /// @brief HLC3 computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> HLC3(int intervalAmount);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void HLC3(int intervalAmount, double *out);
         /// @brief Calculates the Hilbert Transform Dominant Cycle Period (HT_DCPERIOD) for a given symbol and interval.
         ///        This indicator is part of the Hilbert Transform concept and is used to estimate the length of price cycles.
         ///        It is based on the premise that market cycles can be identified through the sine wave characteristics of price actions.
@@ -412,6 +496,12 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the LINEARREG is calculated, typically 'close'.
         /// @return A vector containing dateTime and LINEARREG value pairs in the form <dateTime, LINEARREG, ...>.
         std::vector<std::string> LINEARREG(std::string symbol, std::string intervalLength, int timePeriod = 9, std::string seriesType = "close");
+        /// @brief LINEARREG (fitted value at the newest bar of each window) computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> LINEARREG(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void LINEARREG(int intervalAmount, int timePeriod, std::string seriesType, double *out);
         /// @brief Calculates the angle of the Linear Regression trendline for a given symbol and interval.
         ///        The angle is measured in degrees and indicates the steepness of the regression line, 
         ///        providing insight into the trend's strength and direction.
@@ -427,6 +517,12 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the LINEARREGANGLE is calculated, typically 'close'.
         /// @return A vector containing dateTime and LINEARREGANGLE value pairs in the form <dateTime, LINEARREGANGLE, ...>.
         std::vector<std::string> LINEARREGANGLE(std::string symbol, std::string intervalLength, int timePeriod = 9, std::string seriesType = "close");
+        /// @brief LINEARREGANGLE (atan of the slope, in degrees) computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> LINEARREGANGLE(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void LINEARREGANGLE(int intervalAmount, int timePeriod, std::string seriesType, double *out);
         /// @brief Calculates the intercept of the Linear Regression trendline for each data point for a given symbol and interval.
         ///        The intercept is the point where the regression line crosses the Y-axis, indicating the baseline level of the dependent variable when all independent variables are zero.
         ///         Linear Regression Intercept Calculation:
@@ -445,6 +541,12 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the LINEARREGINTERCEPT is calculated, typically 'close'.
         /// @return A vector containing dateTime and LINEARREGINTERCEPT value pairs in the form <dateTime, LINEARREGINTERCEPT, ...>.
         std::vector<std::string> LINEARREGINTERCEPT(std::string symbol, std::string intervalLength, int timePeriod = 9, std::string seriesType = "close");
+        /// @brief LINEARREGINTERCEPT (fitted value at the oldest bar of each window) computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> LINEARREGINTERCEPT(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void LINEARREGINTERCEPT(int intervalAmount, int timePeriod, std::string seriesType, double *out);
         /// @brief Calculates the slope of the Linear Regression trendline for each data point for a given symbol and interval.
         ///        The slope indicates the direction and strength of the trend: a positive slope suggests an upward trend, while a negative slope indicates a downward trend.
         /// Linear Regression Slope Calculation:
@@ -463,6 +565,12 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the LINEARREGSLOPE is calculated, typically 'close'.
         /// @return A vector containing dateTime and LINEARREGSLOPE value pairs in the form <dateTime, LINEARREGSLOPE, ...>.
         std::vector<std::string> LINEARREGSLOPE(std::string symbol, std::string intervalLength, int timePeriod = 9, std::string seriesType = "close");
+        /// @brief LINEARREGSLOPE (price change per bar) computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> LINEARREGSLOPE(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void LINEARREGSLOPE(int intervalAmount, int timePeriod, std::string seriesType, double *out);
         /// @brief Transforms all data points of the given symbol and interval using the natural logarithm to the base of constant e.
         ///        The natural logarithm (ln) is the logarithm to the base e, where e is an irrational constant approximately equal to 2.71828.
         /// Natural Logarithm (LN) Transformation:
@@ -477,6 +585,11 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the LN transformation is applied, typically 'close'.
         /// @return A vector containing dateTime and LN value pairs in the form <dateTime, LN, ...>.
         std::vector<std::string> LN(std::string symbol, std::string intervalLength, std::string seriesType = "close");
+        /// @brief LN computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> LN(int intervalAmount, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void LN(int intervalAmount, std::string seriesType, double *out);
         /// @brief Transforms all data points of a given symbol and interval using the logarithm to base 10.
         /// LOG10 is used to transform data to a scale that can make exponential trends appear linear, aiding in trend identification.
         /// LOG10 (Logarithm to Base 10) Calculation:
@@ -488,6 +601,11 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the LOG10 is calculated, typically 'close'.
         /// @return A vector containing dateTime and LOG10 value pairs in the form <dateTime, LOG10, ...>.
         std::vector<std::string> LOG10(std::string symbol, std::string intervalLength, std::string seriesType = "close");
+        /// @brief LOG10 computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> LOG10(int intervalAmount, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void LOG10(int intervalAmount, std::string seriesType, double *out);
         /// @brief Calculates the Moving Average Convergence Divergence (MACD) for a given symbol and interval.
         ///        MACD is calculated by subtracting the long-term moving average from the short-term moving average, 
         ///        which reveals trend changes and momentum. It includes the MACD line, signal line, and histogram.
@@ -555,6 +673,12 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the MAXINDEX is calculated, typically 'close'.
         /// @return A vector containing dateTime and MAXINDEX pairs in the form <dateTime, MAXINDEX, ...>.
         std::vector<std::string> MAXINDEX(std::string symbol, std::string intervalLength, int timePeriod = 9, std::string seriesType = "close");
+        /// @brief MAXINDEX computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingExtrema.h
+        /// @return 'intervalAmount' indexes into valuesTS (0 = newest bar), newest first
+        std::vector<int> MAXINDEX(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void MAXINDEX(int intervalAmount, int timePeriod, std::string seriesType, int *out);
         /// @brief McGinley Dynamic indicator keeps all the benefits from the moving averages but adds an adjustment to market speed.
         /// McGinley Dynamic (MD) = MD_previous + (Price - MD_previous) / (k * (Price / MD_previous) ^ 4)
         /// where:
@@ -573,6 +697,11 @@ class Analytics : public GeneralInfo{
         /// @param intervalLength Length of a single period, such as 1min, 5min, 15min, etc.
         /// @return A vector containing <dateTime, medprice> pairs for each interval.
         std::vector<std::string> MEDPRICE(std::string symbol, std::string intervalLength, std::string intervalAmount);
+        /// @brief MEDPRICE computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> MEDPRICE(int intervalAmount);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void MEDPRICE(int intervalAmount, double *out);
         /// @brief Money Flow Index (MFI) calculates the flow of money into and out of a security over a specified period of time.
         ///        The MFI is an oscillator that uses both price and volume to measure buying and selling pressure.
         ///        It's a component of the typical price multiplied by volume, comparing the positive and negative money flows.
@@ -590,6 +719,12 @@ class Analytics : public GeneralInfo{
         /// @param dataType close, high, open, low ???
         /// @return A vector containing <dateTime, midpoint value> pairs for each interval.
         std::vector<std::string> MIDPOINT(std::string symbol, std::string intervalLength, int timePeriod = 9, std::string dataType = "close");
+        /// @brief MIDPOINT computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingExtrema.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> MIDPOINT(int intervalAmount, int timePeriod, std::string dataType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void MIDPOINT(int intervalAmount, int timePeriod, std::string dataType, double *out);
         /// @brief MidPoint Price over period (MIDPRICE) calculates the midpoint of the highest high and lowest low over a specified period.
         ///        MIDPRICE = (Highest High + Lowest Low) / 2
         /// @param symbol Symbol for the company or asset you are inquiring about.
@@ -598,6 +733,12 @@ class Analytics : public GeneralInfo{
         /// @param intervalAmount amount of intervals
         /// @return A vector containing <dateTime, MIDPRICE value> pairs for each interval.
         std::vector<std::string> MIDPRICE(std::string symbol, std::string intervalLength, int timePeriod = 9, std::string intervalAmount = "10");
+        /// @brief MIDPRICE computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingExtrema.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> MIDPRICE(int intervalAmount, int timePeriod);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void MIDPRICE(int intervalAmount, int timePeriod, double *out);
         /// @brief Calculates the lowest value over a specified period for a given symbol and interval.
         ///        MIN is calculated as the minimum value within the specified time period based on the series type.
         /// @param symbol Symbol for the company or asset you are inquiring about.
@@ -607,6 +748,12 @@ class Analytics : public GeneralInfo{
         /// @param timePeriod Number of periods to average over, typically 9.
         /// @return A vector containing dateTime and MIN value pairs in the form <dateTime, MIN, ...>.
         std::vector<std::string> MIN(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType = "close", int timePeriod = 9);
+        /// @brief MIN computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingExtrema.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> MIN(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void MIN(int intervalAmount, int timePeriod, std::string seriesType, double *out);
         /// @brief Calculates the index of the lowest value over a specified period for a given symbol and interval.
         ///        MININDEX returns the position (index) of the minimum value within the specified time period based on the series type.
         /// @param symbol Symbol for the company or asset you are inquiring about.
@@ -616,6 +763,12 @@ class Analytics : public GeneralInfo{
         /// @param timePeriod Number of periods to average over, typically 9.
         /// @return A vector containing dateTime and MININDEX value pairs in the form <dateTime, MININDEX, ...>.
         std::vector<std::string> MININDEX(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType = "close", int timePeriod = 9);
+        /// @brief MININDEX computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingExtrema.h
+        /// @return 'intervalAmount' indexes into valuesTS (0 = newest bar), newest first
+        std::vector<int> MININDEX(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void MININDEX(int intervalAmount, int timePeriod, std::string seriesType, int *out);
         /// @brief Calculates the lowest and highest values over a specified period (MINMAX).
         ///        MINMAX provides the minimum and maximum values within a given time frame, offering insights into the range of price movements.
         /// @param symbol Symbol for the company or asset you are inquiring about.
@@ -625,6 +778,12 @@ class Analytics : public GeneralInfo{
         /// @param timePeriod Number of periods to average over. Takes values in the range from 1 to 800, defaulting to 9.
         /// @return A vector containing pairs of dateTime, min, and max values in the form <dateTime, min, max, ...>.
         std::vector<std::string> MINMAX(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType = "close", int timePeriod = 9);
+        /// @brief MINMAX computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingExtrema.h
+        /// @return 'intervalAmount' <min,max> pairs, newest first
+        std::vector<std::pair<double, double>> MINMAX(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into two caller columns of intervalAmount values instead, no allocation
+        void MINMAX(int intervalAmount, int timePeriod, std::string seriesType, double *min, double *max);
         /// @brief Calculates the indexes of the lowest and highest values over a specified period (MINMAXINDEX).
         ///        MINMAXINDEX provides the indexes where the minimum and maximum values occur within a given time frame, offering insights into the timing of peak and trough movements.
         /// @param symbol Symbol for the company or asset you are inquiring about.
@@ -634,6 +793,12 @@ class Analytics : public GeneralInfo{
         /// @param timePeriod Number of periods to average over. Takes values in the range from 1 to 800, defaulting to 9.
         /// @return A vector containing pairs of dateTime, minIdx, and maxIdx values in the form <dateTime, minIdx, maxIdx, ...>.
         std::vector<std::string> MINMAXINDEX(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType = "close", int timePeriod = 9);
+        /// @brief MINMAXINDEX computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingExtrema.h
+        /// @return 'intervalAmount' <minIdx,maxIdx> pairs of indexes into valuesTS (0 = newest bar), newest first
+        std::vector<std::pair<int, int>> MINMAXINDEX(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into two caller columns of intervalAmount values instead, no allocation
+        void MINMAXINDEX(int intervalAmount, int timePeriod, std::string seriesType, int *minIndex, int *maxIndex);
         /// @brief Calculates the Momentum (MOM) of an asset by comparing its current price with the price from N periods ago.
         ///        MOM = CurrentPrice - Price(N periods ago)
         /// @param symbol Symbol for the company or asset you are inquiring about.
@@ -652,6 +817,11 @@ class Analytics : public GeneralInfo{
         /// @param seriesType2 Price type used as the second part of the technical indicator, typically 'close'.
         /// @return A vector containing pairs of dateTime and MULT values in the form <dateTime, MULT, ...>.
         std::vector<std::string> MULT(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string seriesType1 = "open", std::string seriesType2 = "close");
+        /// @brief MULT computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> MULT(int intervalAmount, std::string seriesType1, std::string seriesType2);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void MULT(int intervalAmount, std::string seriesType1, std::string seriesType2, double *out);
         /// @brief Calculates the Normalized Average True Range (NATR) of an asset, offering a normalized measure of volatility.
         ///        NATR is useful for comparing volatility across different price levels. 
         ///        NATR = (ATR / Close) * 100
@@ -681,6 +851,12 @@ class Analytics : public GeneralInfo{
         /// @param sd Number of standard deviations for the width of the Bollinger Bands, typically 2.
         /// @return A vector containing pairs of dateTime and PERCENT_B values in the form <dateTime, PERCENT_B, ...>.
         std::vector<std::string> PERCENT_B(std::string symbol, std::string intervalLength, std::string intervalAmount, std::string timePeriod = "20", std::string maType = "SMA", std::string sd = "2");
+        /// @brief PERCENT_B of the close, 0.5 where the bands have no width computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> PERCENT_B(int intervalAmount, int timePeriod, double sd, std::string maType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void PERCENT_B(int intervalAmount, int timePeriod, double sd, std::string maType, double *out);
         /// @brief Calculates Pivot Points (High/Low) (PIVOT_POINTS_HL), used to foresee potential price reversals.
         ///        Pivot Points are calculated as the average of the high, low, and closing prices from the previous trading session.
         ///     Pivot Point High (H) = (Highest High + Lowest Low + Close) / 3
@@ -778,6 +954,11 @@ class Analytics : public GeneralInfo{
         /// @param seriesType Price type on which the square root transformation is applied, typically 'close'.
         /// @return A vector containing <dateTime, sqrtValue> pairs for each interval.
         std::vector<std::string> SQRT(std::string symbol, std::string intervalLength, std::string seriesType = "close");
+        /// @brief SQRT computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> SQRT(int intervalAmount, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void SQRT(int intervalAmount, std::string seriesType, double *out);
         /// @brief Calculates the Standard Deviation (STDDEV) of a given symbol and interval to measure volatility and assess risks.
         ///        Standard Deviation is a statistical measurement that sheds light on the amount of variation or dispersion from the average.
         ///        A high standard deviation indicates a high level of volatility and potential risk, whereas a low standard deviation indicates stability.
@@ -788,6 +969,12 @@ class Analytics : public GeneralInfo{
         /// @param sd Number of standard deviations, defaults to 2, to scale the standard deviation if needed.
         /// @return A vector containing <dateTime, stddevValue> pairs for each interval, where stddevValue is the calculated standard deviation.
         std::vector<std::string> STDDEV(std::string symbol, std::string intervalLength, std::string seriesType = "close", int timePeriod = 9, int sd = 2);
+        /// @brief STDDEV (population standard deviation times 'sd') computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> STDDEV(int intervalAmount, int timePeriod, std::string seriesType, int sd);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void STDDEV(int intervalAmount, int timePeriod, std::string seriesType, int sd, double *out);
         /// @brief Calculates the Stochastic Oscillator, indicating momentum by comparing a closing price to its price range over a given period.
         ///        The oscillator comprises two lines: %K (the fast line) and %D (the slow line, which is a moving average of %K).
         /// @param symbol Symbol for the company or asset you are inquiring about
@@ -836,6 +1023,11 @@ class Analytics : public GeneralInfo{
         /// @param intervalAmount The number of data points to retrieve, representing the output size.
         /// @return A vector containing <dateTime, subValue> pairs for each interval, where 'subValue' is the result of the subtraction.
         std::vector<std::string> SUB(std::string symbol, std::string intervalLength, std::string seriesType1 = "open", std::string seriesType2 = "close", std::string intervalAmount = "30");
+        /// @brief SUB computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> SUB(int intervalAmount, std::string seriesType1, std::string seriesType2);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void SUB(int intervalAmount, std::string seriesType1, std::string seriesType2, double *out);
         /// @brief Calculates the Summation (SUM) of values for a given symbol and interval, summing up the values of a specified price type over a certain period.
         ///        The SUM indicator provides a total sum of the specified series_type over the given time_period, helping to identify trends or patterns in data accumulation or depletion over time.
         ///        SUM = Σ(Price) over 'time_period'
@@ -922,6 +1114,12 @@ class Analytics : public GeneralInfo{
         /// @param intervalAmount The number of data points to retrieve, representing the output size.
         /// @return A vector containing <dateTime, tsfValue> pairs for each interval, where 'tsfValue' represents the forecasted value at the corresponding dateTime based on the TSF calculation.
         std::vector<std::string> TSF(std::string symbol, std::string intervalLength, int timePeriod = 9, std::string seriesType = "close", std::string intervalAmount = "30");
+        /// @brief TSF (fit projected one bar past each window) computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> TSF(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void TSF(int intervalAmount, int timePeriod, std::string seriesType, double *out);
         /// @brief Calculates the Typical Price (TYPPRICE), which is the average of the high, low, and closing prices for each period.
         ///        The Typical Price provides a simplified view of a security's price movement and is often used as a component in other technical indicators.
         ///        TYPPRICE = (High + Low + Close) / 3
@@ -931,6 +1129,11 @@ class Analytics : public GeneralInfo{
         /// @param intervalAmount The number of data points to retrieve, representing the output size.
         /// @return A vector containing <dateTime, typpriceValue> pairs for each interval, where 'typpriceValue' represents the Typical Price at the corresponding dateTime.
         std::vector<std::string> TYPPRICE(std::string symbol, std::string intervalLength, std::string intervalAmount = "30");
+        /// @brief TYPPRICE computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> TYPPRICE(int intervalAmount);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void TYPPRICE(int intervalAmount, double *out);
         /// @brief Calculates the Ultimate Oscillator (ULTOSC), which incorporates three different time periods to improve the identification of overbought and oversold conditions.
         ///        The ULTOSC combines short, intermediate, and long-term market trends in one value, aiming to reduce false signals.
         ///        It is calculated by taking the weighted sum of three oscillators of different time periods, where each oscillator is the ratio of the true range over a given period.
@@ -955,6 +1158,12 @@ class Analytics : public GeneralInfo{
         /// @param intervalAmount The number of data points to retrieve, representing the output size.
         /// @return A vector containing <dateTime, varianceValue> pairs for each interval, where 'varianceValue' represents the variance of the data points at the corresponding dateTime.
         std::vector<std::string> VAR(std::string symbol, std::string intervalLength, int timePeriod = 9, std::string seriesType = "close", std::string intervalAmount = "30");
+        /// @brief VAR (population variance) computed on the bars already in 'valuesTS', no request is made.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingMoments.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> VAR(int intervalAmount, int timePeriod, std::string seriesType);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void VAR(int intervalAmount, int timePeriod, std::string seriesType, double *out);
         /// @brief Calculates the Volume Weighted Average Price (VWAP), a trading benchmark that gives the average price an instrument has traded at throughout the day, based on both volume and price.
         ///        VWAP is often used in trading and by algorithms to ensure trades are executed close to this average price to minimize market impact.
         ///        VWAP is calculated by adding up the dollar amount traded for every transaction (price multiplied by the number of shares traded) and then dividing by the total shares traded for the day.
@@ -973,6 +1182,11 @@ class Analytics : public GeneralInfo{
         /// @param intervalAmount The number of data points to retrieve, representing the output size.
         /// @return A vector containing <dateTime, wclPrice> pairs for each interval, where 'wclPrice' is the calculated weighted close price at the corresponding dateTime.
         std::vector<std::string> WCLPRICE(std::string symbol, std::string intervalLength, std::string intervalAmount = "30");
+        /// @brief WCLPRICE computed on the bars already in 'valuesTS' with the vector kernels of PriceTransform.h, no request is made
+        /// @return 'intervalAmount' values, newest first, value i belongs to getTimeStampTSAt(i)
+        std::vector<double> WCLPRICE(int intervalAmount);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void WCLPRICE(int intervalAmount, double *out);
         /// @brief Calculates the Williams %R, identifying overbought and oversold levels, and potentially signaling entry and exit points.
         ///        Williams %R oscillates between 0 and -100, where values above -20 are considered overbought and values below -80 are considered oversold.
         ///        WILLR = (Highest High - Close) / (Highest High - Lowest Low) * -100 .... for the last 'timePeriod' intervals
@@ -981,6 +1195,12 @@ class Analytics : public GeneralInfo{
         /// @param timePeriod The lookback period over which the highs and lows are considered, defaults to 9.
         /// @return A vector of <dateTime, WILLR value> pairs, indicating the Williams %R value at each time point.
         std::vector<std::string> WILLR(std::string symbol, std::string interval, int timePeriod = 9);
+        /// @brief WILLR computed on the bars already in 'valuesTS', no request is made. 0 where the window's high == low.
+        ///        timePeriod - 1 bars older than the oldest output must be in valuesTS too. Windows use RollingExtrema.h
+        /// @return 'intervalAmount' values, newest first
+        std::vector<double> WILLR(int intervalAmount, int timePeriod);
+        /// @brief written into out[0 .. intervalAmount) instead, no allocation
+        void WILLR(int intervalAmount, int timePeriod, double *out);
         
         
     //private:
@@ -1015,9 +1235,14 @@ class Analytics : public GeneralInfo{
         /// @param timePeriod Refers to the amount of intervals to calculate up to. Constraint on variable is dependent on how many periods present in 'valuesTS'
         /// @param value data attribute you want to measure the moving average of.
         /// @return return EMA calculated up to the specified period #
-        std::vector<double> ExponentialMovingAverage(std::vector<double> values, int timePeriod);
-        std::vector<double> WeightedMovingAverage(std::vector<double> values, int timePeriod);
-        std::vector<double> SimpleMovingAverage(std::vector<double> values, int timePeriod);
+        std::vector<double> ExponentialMovingAverage(const std::vector<double>& values, int timePeriod);
+        std::vector<double> WeightedMovingAverage(const std::vector<double>& values, int timePeriod);
+        std::vector<double> SimpleMovingAverage(const std::vector<double>& values, int timePeriod);
+        /// @brief the moving averages above over values[0 .. count), newest first, into out[0 .. count - timePeriod]
+        ///        (caller owned, count - timePeriod + 1 values). Nothing is allocated
+        static void ExponentialMovingAverage(const double *values, size_t count, int timePeriod, double *out);
+        static void WeightedMovingAverage(const double *values, size_t count, int timePeriod, double *out);
+        static void SimpleMovingAverage(const double *values, size_t count, int timePeriod, double *out);
 
 
 
@@ -1032,6 +1257,7 @@ class Analytics : public GeneralInfo{
         /// @param previousClose close price of the period previous to the current period
         /// @return True range value
         std::vector<double> TrueRange(int intervalAmount);
+        void TrueRange(int intervalAmount, double *out);
         /// @brief +DM = currentHigh - previousHigh
         /// @param currentHigh 
         /// @param previousHigh 
@@ -1058,10 +1284,29 @@ class Analytics : public GeneralInfo{
         /// @return DX value 
         double DirectionalMovementIndex(double positiveDI, double negativeDI);
 
-        std::vector<double> getHighs();
-        std::vector<double> getLows();
-        std::vector<double> getCloses();
-        std::vector<double> getOpens();
+        /// @brief Non-owning views into the numeric columns of 'valuesTS'. No copy and no conversion is made per call,
+        ///        the columns are parsed once by setValuesTS. A view is invalidated by the next setValuesTS call.
+        /// @return read-only view ordered from newest to oldest interval
+        ColumnView<double> getHighs();
+        ColumnView<double> getLows();
+        ColumnView<double> getCloses();
+        ColumnView<double> getOpens();
+        /// @brief column named by 'seriesType', one of {open, high, low, close}. Throws std::invalid_argument otherwise
+        ColumnView<double> getSeries(const std::string& seriesType);
+        /// @brief the same column of another store, e.g. the second symbol of CORREL
+        static ColumnView<double> SeriesOf(const BarStore& bars, const std::string& seriesType);
+        /// @brief 'values' (newest first) paired with their timestamps, in the form <date,value.....date,value>
+        std::vector<std::string> DateValueStrings(const std::vector<double>& values);
+        /// @brief throw std::invalid_argument unless valuesTS holds 'intervalAmount' outputs plus their 'timePeriod' windows
+        void ValidateWindow(const std::string& function, int intervalAmount, int timePeriod);
+        /// @brief 'statistic' of RollingMoments over a window of 'timePeriod' values of 'seriesType', into out[0 .. intervalAmount)
+        void MovingStatistic(const std::string& function, int intervalAmount, int timePeriod, const std::string& seriesType,
+                             double (RollingMoments::*statistic)() const, double *out);
+        /// @brief rolling correlation of two newest first series into out[0 .. intervalAmount), output i over a[i .. i + timePeriod - 1]
+        ///        and b[i .. i + timePeriod - 1]
+        static void RollingCorrelation(const double *a, const double *b, int intervalAmount, int timePeriod, double *out);
+        /// @brief size of an output column for 'intervalAmount', 0 when negative (the kernel then throws)
+        static size_t OutputSize(int intervalAmount);
         
 
 
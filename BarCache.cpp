@@ -0,0 +1,65 @@
+#ifndef BARCACHE_CPP
+#define BARCACHE_CPP
+#include "BarCache.h"
+#include "BarSnapshot.h"
+
+#include <utility>
+
+BarCache::BarCache(const std::string& directory) : directory(directory) {}
+
+std::string BarCache::getDirectory() const{
+    return directory;
+}
+
+std::string BarCache::FilePath(const std::string& symbol, const std::string& intervalLength) const{
+    //"EUR/USD" is a valid symbol but not a valid file name
+    std::string name = symbol + "_" + intervalLength + ".bars";
+    for (size_t i = 0; i < name.size(); i++) {
+        if (name[i] == '/' || name[i] == '\\') {
+            name[i] = '-';
+        }
+    }
+    return directory + "/" + name;
+}
+
+bool BarCache::load(const std::string& symbol, const std::string& intervalLength, BarStore& bars) const{
+    //mapped, the cached bars are not copied until they are merged with fresh ones
+    return BarSnapshot::Load(FilePath(symbol, intervalLength), bars);
+}
+
+void BarCache::store(const std::string& symbol, const std::string& intervalLength, const BarStore& bars) const{
+    BarSnapshot::Write(FilePath(symbol, intervalLength), bars);
+}
+
+void BarCache::Merge(BarStore& cached, const BarStore& fresh){
+    if (fresh.empty()) {
+        return;
+    }
+    if (cached.empty()) {
+        cached = fresh;
+        return;
+    }
+    //fresh covers everything from its oldest to its newest bar, cached contributes what lies outside of that
+    ColumnView<int64_t> freshTimes = fresh.getTimeStamps();
+    int64_t newestFresh = freshTimes[0];
+    int64_t oldestFresh = freshTimes[freshTimes.size() - 1];
+
+    ColumnView<int64_t> cachedTimes = cached.getTimeStamps();
+    size_t newer = 0;
+    while (newer < cachedTimes.size() && cachedTimes[newer] > newestFresh) {
+        newer++;
+    }
+    size_t older = newer;
+    while (older < cachedTimes.size() && cachedTimes[older] >= oldestFresh) {
+        older++;
+    }
+    BarStore merged;
+    merged.reserve(fresh.size() + cached.size() - (older - newer));
+    merged.append(cached, 0, newer);
+    merged.append(fresh, 0, fresh.size());
+    merged.append(cached, older, cached.size());
+    merged.setHasTimeOfDay(fresh.hasTimeOfDay());
+    cached = std::move(merged);
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef BARCACHE_H
+#define BARCACHE_H
+
+#include "BarStore.h"
+#include <string>
+
+/// @brief Persistent on-disk cache of time series bars, one file per (symbol, interval) in a cache directory.
+///        Files are BarSnapshot files, memory mapped when loaded.
+///        GeneralInfo uses it to fetch only the bars newer than the last cached one and merge them in
+///        (see GeneralInfo::setCacheDirectory).
+class BarCache{
+    public:
+        /// @param directory existing directory the cache files live in
+        explicit BarCache(const std::string& directory);
+
+        std::string getDirectory() const;
+
+        /// @brief read the cached bars of symbol/interval into 'bars' (replacing its content), newest first
+        /// @return false if nothing is cached for symbol/interval or the file is not a valid cache file
+        bool load(const std::string& symbol, const std::string& intervalLength, BarStore& bars) const;
+        /// @brief write 'bars' (newest first) as the cache of symbol/interval. The file is replaced atomically,
+        ///        readers never see a half written file. Throws std::runtime_error if it cannot be written
+        void store(const std::string& symbol, const std::string& intervalLength, const BarStore& bars) const;
+
+        /// @brief merge freshly fetched bars into cached ones, both newest first.
+        ///        Fresh bars win for any timestamp they cover (the newest cached bar may have still been forming),
+        ///        cached bars newer or older than every fresh bar are kept in front of or behind them.
+        static void Merge(BarStore& cached, const BarStore& fresh);
+
+    private:
+        std::string FilePath(const std::string& symbol, const std::string& intervalLength) const;
+
+        std::string directory;
+};
+
+#endif
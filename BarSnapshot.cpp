@@ -0,0 +1,159 @@
+#ifndef BARSNAPSHOT_CPP
+#define BARSNAPSHOT_CPP
+#include "BarSnapshot.h"
+#include "Metrics.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char SNAPSHOT_MAGIC[8] = {'M', 'D', 'B', 'A', 'R', 'S', '\0', '\0'};
+//numbers the temp files, two threads writing the same snapshot must not write into one file
+static std::atomic<unsigned long> tempSequence(0);
+
+static bool LittleEndianHost(){
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+static uint64_t SwapBytes(uint64_t value){
+    return __builtin_bswap64(value);
+}
+
+//8 byte value --> its stored (little endian) bits
+template <typename T>
+static uint64_t ToStored(T value){
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return LittleEndianHost() ? bits : SwapBytes(bits);
+}
+
+template <typename T>
+static T FromStored(uint64_t bits){
+    if(!LittleEndianHost()){
+        bits = SwapBytes(bits);
+    }
+    T value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static uint32_t SwapIfBig(uint32_t value){
+    return LittleEndianHost() ? value : __builtin_bswap32(value);
+}
+
+void BarSnapshot::Write(const std::string& path, const BarStore& bars, bool checksum){
+    size_t count = bars.size();
+    //one buffer holding the file past the header, in stored byte order
+    std::vector<uint64_t> columns(count * 6);
+    if(LittleEndianHost()){
+        std::memcpy(columns.data(), bars.getTimeStamps().data(), count * 8);
+        std::memcpy(columns.data() + count, bars.getOpens().data(), count * 8);
+        std::memcpy(columns.data() + count * 2, bars.getHighs().data(), count * 8);
+        std::memcpy(columns.data() + count * 3, bars.getLows().data(), count * 8);
+        std::memcpy(columns.data() + count * 4, bars.getCloses().data(), count * 8);
+        std::memcpy(columns.data() + count * 5, bars.getVolumes().data(), count * 8);
+    }
+    else{
+        for(size_t i = 0; i < count; i++){
+            columns[i] = ToStored(bars.getTimeStamps()[i]);
+            columns[count + i] = ToStored(bars.getOpens()[i]);
+            columns[count * 2 + i] = ToStored(bars.getHighs()[i]);
+            columns[count * 3 + i] = ToStored(bars.getLows()[i]);
+            columns[count * 4 + i] = ToStored(bars.getCloses()[i]);
+            columns[count * 5 + i] = ToStored(bars.getVolumes()[i]);
+        }
+    }
+
+    Header header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SwapIfBig(VERSION);
+    header.flags = SwapIfBig((bars.hasTimeOfDay() ? TIME_OF_DAY : 0) | (checksum ? CHECKSUM : 0));
+    header.count = ToStored(static_cast<uint64_t>(count));
+    header.checksum = ToStored(checksum ? Checksum(columns.data(), columns.size()) : static_cast<uint64_t>(0));
+
+    //write next to the target and rename over it, so a reader only ever sees a complete file
+    std::string tempPath = path + ".tmp" + std::to_string(static_cast<long>(getpid())) + "_" + std::to_string(tempSequence++);
+    FILE *fp = fopen(tempPath.c_str(), "wb");
+    if(fp == NULL){
+        throw std::runtime_error("BarSnapshot.cpp @ Write: failed to open " + tempPath + " for writing");
+    }
+    bool written = fwrite(&header, sizeof(header), 1, fp) == 1
+                   && fwrite(columns.data(), sizeof(uint64_t), columns.size(), fp) == columns.size();
+    written = (fclose(fp) == 0) && written;
+    if(!written || std::rename(tempPath.c_str(), path.c_str()) != 0){
+        std::remove(tempPath.c_str());
+        throw std::runtime_error("BarSnapshot.cpp @ Write: failed to write " + path);
+    }
+}
+
+bool BarSnapshot::Load(const std::string& path, BarStore& bars, bool verify){
+    static const Metrics::Stage STAGE_LOAD = Metrics::Register("snapshot_load");
+    Metrics::Span span(STAGE_LOAD);
+    bars.clear();
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+        return false;
+    }
+    struct stat info;
+    if(fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)){
+        close(fd);
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    void *mapped = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapped == MAP_FAILED){
+        return false;
+    }
+    //unmapped when the last store attached to it lets go
+    std::shared_ptr<const void> mapping(mapped, [fileSize](const void *address){ munmap(const_cast<void*>(address), fileSize); });
+
+    const char *base = static_cast<const char*>(mapped);
+    Header header;
+    std::memcpy(&header, base, sizeof(header));
+    uint32_t flags = SwapIfBig(header.flags);
+    uint64_t count = FromStored<uint64_t>(header.count);
+    if(std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || SwapIfBig(header.version) != VERSION
+        || count > (fileSize - sizeof(Header)) / 48 || fileSize != sizeof(Header) + count * 48){
+        return false;
+    }
+    //page aligned mapping and a 32 byte header: the columns are 8 byte aligned
+    const uint64_t *words = reinterpret_cast<const uint64_t*>(base + sizeof(Header));
+    if(verify && (!(flags & CHECKSUM) || Checksum(words, count * 6) != FromStored<uint64_t>(header.checksum))){
+        return false;
+    }
+
+    if(LittleEndianHost()){
+        const int64_t *timeStamps = reinterpret_cast<const int64_t*>(words);
+        const double *opens = reinterpret_cast<const double*>(words + count);
+        bars.attach(mapping, timeStamps, opens, opens + count, opens + count * 2, opens + count * 3,
+                    reinterpret_cast<const int64_t*>(words + count * 5), count);
+    }
+    else{
+        bars.reserve(count);
+        for(size_t i = 0; i < count; i++){
+            bars.append(FromStored<int64_t>(words[i]), FromStored<double>(words[count + i]), FromStored<double>(words[count * 2 + i]),
+                        FromStored<double>(words[count * 3 + i]), FromStored<double>(words[count * 4 + i]), FromStored<int64_t>(words[count * 5 + i]));
+        }
+    }
+    bars.setHasTimeOfDay((flags & TIME_OF_DAY) != 0);
+    return true;
+}
+
+uint64_t BarSnapshot::Checksum(const uint64_t *words, size_t count){
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i = 0; i < count; i++){
+        hash ^= FromStored<uint64_t>(words[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#endif
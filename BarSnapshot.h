@@ -0,0 +1,47 @@
+#ifndef BARSNAPSHOT_H
+#define BARSNAPSHOT_H
+
+#include "BarStore.h"
+#include <cstdint>
+#include <string>
+
+/// @brief Versioned binary snapshot of a BarStore: a 32 byte header, then the timestamp, open, high, low, close and
+///        volume columns back to back, 'count' 8 byte values each. Everything is little endian, whatever the host.
+///        Load memory maps the file and attaches the store to the mapping (BarStore::attach), so nothing is parsed
+///        or copied: loading costs an open and an mmap, pages are read in when the columns are first touched.
+///
+///        BarSnapshot::Write("AAPL_1min.bars", *info.valuesTS);
+///        BarSnapshot::Load("AAPL_1min.bars", bars);          //bars.isAttached() on little endian hosts
+class BarSnapshot{
+    public:
+        /// @brief header flags
+        enum Flags{
+            TIME_OF_DAY = 1,    //BarStore::hasTimeOfDay()
+            CHECKSUM = 2        //'checksum' holds the Checksum of the columns
+        };
+
+        /// @brief file layout, 32 bytes so the columns after it stay 8 byte aligned
+        struct Header{
+            char magic[8];      //"MDBARS\0\0"
+            uint32_t version;   //VERSION
+            uint32_t flags;     //Flags
+            uint64_t count;     //number of bars
+            uint64_t checksum;  //0 without the CHECKSUM flag
+        };
+
+        static const uint32_t VERSION = 2;
+
+        /// @brief write 'bars' (newest first) to 'path'. The file is replaced atomically, readers never see a half
+        ///        written file. 'checksum' adds a checksum of the columns (one more pass over them).
+        ///        Throws std::runtime_error if it cannot be written
+        static void Write(const std::string& path, const BarStore& bars, bool checksum = true);
+        /// @brief map the snapshot at 'path' into 'bars' (replacing its content), zero copy on little endian hosts.
+        ///        'verify' checks the checksum first, which reads the whole file; without it only the header is read
+        /// @return false if the file is missing, not a snapshot of this version, truncated or fails 'verify'
+        static bool Load(const std::string& path, BarStore& bars, bool verify = false);
+
+        /// @brief FNV-1a over the 8 byte words of the columns as stored, read as little endian numbers
+        static uint64_t Checksum(const uint64_t *words, size_t count);
+};
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef BARSTORE_CPP
+#define BARSTORE_CPP
+#include "BarStore.h"
+
+BarStore::BarStore() : timeOfDay(true), attachedTimeStamps(nullptr), attachedOpens(nullptr), attachedHighs(nullptr),
+                       attachedLows(nullptr), attachedCloses(nullptr), attachedVolumes(nullptr), attachedCount(0) {}
+
+size_t BarStore::size() const{
+    return owner ? attachedCount : timeStampColumn.size();
+}
+
+bool BarStore::empty() const{
+    return size() == 0;
+}
+
+void BarStore::reserve(size_t bars){
+    Detach();
+    timeStampColumn.reserve(bars);
+    openColumn.reserve(bars);
+    highColumn.reserve(bars);
+    lowColumn.reserve(bars);
+    closeColumn.reserve(bars);
+    volumeColumn.reserve(bars);
+}
+
+void BarStore::clear(){
+    owner.reset();
+    attachedCount = 0;
+    timeStampColumn.clear();
+    openColumn.clear();
+    highColumn.clear();
+    lowColumn.clear();
+    closeColumn.clear();
+    volumeColumn.clear();
+}
+
+void BarStore::append(int64_t timeStamp, double open, double high, double low, double close, int64_t volume){
+    Detach();
+    timeStampColumn.push_back(timeStamp);
+    openColumn.push_back(open);
+    highColumn.push_back(high);
+    lowColumn.push_back(low);
+    closeColumn.push_back(close);
+    volumeColumn.push_back(volume);
+}
+
+void BarStore::append(const BarStore& other, size_t begin, size_t end){
+    if(begin > end || end > other.size()){
+        throw std::out_of_range("BarStore.cpp @ append: range is outside of the other store");
+    }
+    Detach();
+    //through the views, 'other' may be attached
+    ColumnView<int64_t> timeStamps = other.getTimeStamps();
+    ColumnView<double> opens = other.getOpens(), highs = other.getHighs(), lows = other.getLows(), closes = other.getCloses();
+    ColumnView<int64_t> volumes = other.getVolumes();
+    timeStampColumn.insert(timeStampColumn.end(), timeStamps.begin() + begin, timeStamps.begin() + end);
+    openColumn.insert(openColumn.end(), opens.begin() + begin, opens.begin() + end);
+    highColumn.insert(highColumn.end(), highs.begin() + begin, highs.begin() + end);
+    lowColumn.insert(lowColumn.end(), lows.begin() + begin, lows.begin() + end);
+    closeColumn.insert(closeColumn.end(), closes.begin() + begin, closes.begin() + end);
+    volumeColumn.insert(volumeColumn.end(), volumes.begin() + begin, volumes.begin() + end);
+}
+
+bool BarStore::hasTimeOfDay() const{
+    return timeOfDay;
+}
+
+void BarStore::setHasTimeOfDay(bool value){
+    timeOfDay = value;
+}
+
+void BarStore::attach(const std::shared_ptr<const void>& owner, const int64_t *timeStamps, const double *opens, const double *highs,
+                      const double *lows, const double *closes, const int64_t *volumes, size_t count){
+    clear();
+    //own columns are released, an attached store holds no copy
+    std::vector<int64_t>().swap(timeStampColumn);
+    std::vector<double>().swap(openColumn);
+    std::vector<double>().swap(highColumn);
+    std::vector<double>().swap(lowColumn);
+    std::vector<double>().swap(closeColumn);
+    std::vector<int64_t>().swap(volumeColumn);
+    this->owner = owner;
+    attachedTimeStamps = timeStamps;
+    attachedOpens = opens;
+    attachedHighs = highs;
+    attachedLows = lows;
+    attachedCloses = closes;
+    attachedVolumes = volumes;
+    attachedCount = count;
+}
+
+bool BarStore::isAttached() const{
+    return static_cast<bool>(owner);
+}
+
+void BarStore::Detach(){
+    if(!owner){
+        return;
+    }
+    timeStampColumn.assign(attachedTimeStamps, attachedTimeStamps + attachedCount);
+    openColumn.assign(attachedOpens, attachedOpens + attachedCount);
+    highColumn.assign(attachedHighs, attachedHighs + attachedCount);
+    lowColumn.assign(attachedLows, attachedLows + attachedCount);
+    closeColumn.assign(attachedCloses, attachedCloses + attachedCount);
+    volumeColumn.assign(attachedVolumes, attachedVolumes + attachedCount);
+    owner.reset();
+    attachedCount = 0;
+}
+
+ColumnView<int64_t> BarStore::getTimeStamps() const{
+    if(owner){
+        return ColumnView<int64_t>(attachedTimeStamps, attachedCount);
+    }
+    return ColumnView<int64_t>(timeStampColumn.data(), timeStampColumn.size());
+}
+ColumnView<double> BarStore::getOpens() const{
+    if(owner){
+        return ColumnView<double>(attachedOpens, attachedCount);
+    }
+    return ColumnView<double>(openColumn.data(), openColumn.size());
+}
+ColumnView<double> BarStore::getHighs() const{
+    if(owner){
+        return ColumnView<double>(attachedHighs, attachedCount);
+    }
+    return ColumnView<double>(highColumn.data(), highColumn.size());
+}
+ColumnView<double> BarStore::getLows() const{
+    if(owner){
+        return ColumnView<double>(attachedLows, attachedCount);
+    }
+    return ColumnView<double>(lowColumn.data(), lowColumn.size());
+}
+ColumnView<double> BarStore::getCloses() const{
+    if(owner){
+        return ColumnView<double>(attachedCloses, attachedCount);
+    }
+    return ColumnView<double>(closeColumn.data(), closeColumn.size());
+}
+ColumnView<int64_t> BarStore::getVolumes() const{
+    if(owner){
+        return ColumnView<int64_t>(attachedVolumes, attachedCount);
+    }
+    return ColumnView<int64_t>(volumeColumn.data(), volumeColumn.size());
+}
+
+size_t BarStore::indexBefore(int64_t timeStamp) const{
+    ColumnView<int64_t> timeStamps = getTimeStamps();
+    if(timeStamps.empty()){
+        return 0;
+    }
+    //the bars at or after 'timeStamp' are a prefix. Halve the candidates with a conditional move instead of a branch,
+    //the answer stays in [base, base + count]. Both possible next probes are prefetched, so on a large store
+    //the cache misses of consecutive steps overlap instead of queuing up
+    const int64_t *base = timeStamps.data();
+    size_t count = timeStamps.size();
+    while(count > 1){
+        size_t half = count / 2;
+        __builtin_prefetch(base + (count - half) / 2);
+        __builtin_prefetch(base + half + (count - half) / 2);
+        base = base[half] >= timeStamp ? base + half : base;
+        count -= half;
+    }
+    return static_cast<size_t>(base - timeStamps.data()) + (*base >= timeStamp);
+}
+
+BarRange BarStore::slice(size_t begin, size_t end) const{
+    if(begin > end || end > size()){
+        throw std::out_of_range("BarStore.cpp @ slice: range is outside of the store");
+    }
+    size_t count = end - begin;
+    BarRange bars;
+    bars.first = begin;
+    bars.timeStamps = ColumnView<int64_t>(getTimeStamps().data() + begin, count);
+    bars.opens = ColumnView<double>(getOpens().data() + begin, count);
+    bars.highs = ColumnView<double>(getHighs().data() + begin, count);
+    bars.lows = ColumnView<double>(getLows().data() + begin, count);
+    bars.closes = ColumnView<double>(getCloses().data() + begin, count);
+    bars.volumes = ColumnView<int64_t>(getVolumes().data() + begin, count);
+    return bars;
+}
+
+BarRange BarStore::range(int64_t from, int64_t to) const{
+    //newest first: the bars before 'to' start at indexBefore(to), the ones before 'from' are past the range
+    size_t begin = indexBefore(to);
+    size_t end = from < to ? indexBefore(from) : begin;
+    return slice(begin, end);
+}
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef BARSTORE_H
+#define BARSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/// @brief Read-only, non-owning view over one contiguous column of a BarStore (pointer + length).
+///        The view stays valid until the owning BarStore is modified (append, clear, reserve, attach).
+template <typename T>
+class ColumnView{
+    public:
+        ColumnView() : ptr(nullptr), length(0) {}
+        ColumnView(const T *data, size_t size) : ptr(data), length(size) {}
+
+        const T *data() const { return ptr; }
+        size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+
+        const T *begin() const { return ptr; }
+        const T *end() const { return ptr + length; }
+
+        const T &operator[](size_t index) const { return ptr[index]; }
+        const T &at(size_t index) const {
+            if(index >= length){
+                throw std::out_of_range("BarStore.h @ ColumnView::at: index out of range");
+            }
+            return ptr[index];
+        }
+
+    private:
+        const T *ptr;
+        size_t length;
+};
+
+/// @brief Bars [first, first + size()) of a BarStore as one view per column, index aligned like the store
+///        (timeStamps[0] is the newest bar of the range). Valid as long as the views are, see ColumnView.
+struct BarRange{
+    size_t first;   //index in the store of the range's first (newest) bar
+    ColumnView<int64_t> timeStamps;
+    ColumnView<double> opens;
+    ColumnView<double> highs;
+    ColumnView<double> lows;
+    ColumnView<double> closes;
+    ColumnView<int64_t> volumes;
+
+    size_t size() const { return timeStamps.size(); }
+    bool empty() const { return timeStamps.empty(); }
+};
+
+/// @brief Struct-of-arrays storage for time series bars. Every column is contiguous and index aligned,
+///        so bar i is {getTimeStamps()[i], getOpens()[i], getHighs()[i], getLows()[i], getCloses()[i], getVolumes()[i]}.
+///        Ordering follows the API response: index 0 is the newest bar, index size()-1 the oldest.
+///        Values are converted to numbers once when the bar is appended, never again when read.
+///        Const members only read, so any number of threads may read one store (and its views) at once as long as
+///        no thread modifies it meanwhile.
+///        The columns can also be served straight from memory the store does not own, e.g. a memory mapped snapshot
+///        (see attach and BarSnapshot.h). Such a store is copied into its own columns the first time it is modified.
+class BarStore{
+    public:
+        BarStore();
+
+        /// @brief number of bars held in the store
+        size_t size() const;
+        bool empty() const;
+        /// @brief reserve room for 'bars' bars in every column
+        void reserve(size_t bars);
+        /// @brief drop all bars
+        void clear();
+
+        /// @brief append one bar at the back (oldest end) of the store
+        /// @param timeStamp epoch seconds of the bar's datetime
+        void append(int64_t timeStamp, double open, double high, double low, double close, int64_t volume);
+        /// @brief append bars [begin, end) of 'other' at the back of the store
+        void append(const BarStore& other, size_t begin, size_t end);
+
+        /// @brief true if the source datetimes carried a time of day ("YYYY-MM-DD HH:MM:SS"),
+        ///        false if they were date only ("YYYY-MM-DD"). Used when formatting timestamps back to text.
+        bool hasTimeOfDay() const;
+        void setHasTimeOfDay(bool value);
+
+        /// @brief serve 'count' bars straight from the given columns, zero copy, replacing the content of the store.
+        ///        'owner' keeps the memory alive (e.g. unmaps a snapshot when the last store using it is gone),
+        ///        copies of the store share it
+        void attach(const std::shared_ptr<const void>& owner, const int64_t *timeStamps, const double *opens, const double *highs,
+                    const double *lows, const double *closes, const int64_t *volumes, size_t count);
+        /// @brief true while the columns are served from attached memory
+        bool isAttached() const;
+
+        ColumnView<int64_t> getTimeStamps() const;
+        ColumnView<double> getOpens() const;
+        ColumnView<double> getHighs() const;
+        ColumnView<double> getLows() const;
+        ColumnView<double> getCloses() const;
+        ColumnView<int64_t> getVolumes() const;
+
+        //RANGE QUERIES. Bars are expected newest first (as the API, BarCache and CsvImporter keep them), equal
+        //timestamps allowed. Each query is one binary search over the time stamps, the result points into the columns
+
+        /// @brief index of the newest bar older than 'timeStamp', size() if there is none
+        size_t indexBefore(int64_t timeStamp) const;
+        /// @brief bars [begin, end) by index. Throws std::out_of_range if the range is outside of the store
+        BarRange slice(size_t begin, size_t end) const;
+        /// @brief bars with from <= timeStamp < to (epoch seconds), empty if there are none
+        BarRange range(int64_t from, int64_t to) const;
+
+    private:
+        /// @brief copy attached columns into the store's own ones, before they are modified
+        void Detach();
+
+        std::vector<int64_t> timeStampColumn;
+        std::vector<double> openColumn;
+        std::vector<double> highColumn;
+        std::vector<double> lowColumn;
+        std::vector<double> closeColumn;
+        std::vector<int64_t> volumeColumn;
+        bool timeOfDay;
+
+        //attached columns, only used while 'owner' is set
+        std::shared_ptr<const void> owner;
+        const int64_t *attachedTimeStamps;
+        const double *attachedOpens;
+        const double *attachedHighs;
+        const double *attachedLows;
+        const double *attachedCloses;
+        const int64_t *attachedVolumes;
+        size_t attachedCount;
+};
+
+#endif
@@ -0,0 +1,479 @@
+#ifndef CSVIMPORTER_CPP
+#define CSVIMPORTER_CPP
+#include "CsvImporter.h"
+#include "ThreadPool.h"
+#include "EpochTime.h"
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//below this a file is parsed in one piece, splitting would cost more than it saves
+static const size_t MIN_CHUNK_SIZE = 1 << 20;
+
+//a line is split up to the last bar column, which has to be one of the first MAX_FIELDS
+static const int MAX_FIELDS = 64;
+
+//exact powers of ten, a double holds every one of them
+static const double POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+//[begin, end) without surrounding blanks and quotes
+static void Trim(const char *&begin, const char *&end){
+    while (begin < end && (*begin == ' ' || *begin == '\r')) {
+        begin++;
+    }
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\r')) {
+        end--;
+    }
+    if (end - begin >= 2 && *begin == '"' && end[-1] == '"') {
+        begin++;
+        end--;
+    }
+}
+
+//end of the field starting at 'p': the next delimiter, or 'lineEnd'. A delimiter inside a quoted field belongs to the
+//field, a doubled quote inside one is an escaped quote
+static const char *FieldEnd(const char *p, const char *lineEnd, char delimiter){
+    const char *q = p;
+    while (q < lineEnd && *q == ' ') {
+        q++;
+    }
+    if (q < lineEnd && *q == '"') {
+        for (q++; q < lineEnd; q++) {
+            if (*q == '"') {
+                if (q + 1 < lineEnd && q[1] == '"') {
+                    q++;
+                    continue;
+                }
+                q++;
+                break;
+            }
+        }
+        p = q;
+    }
+    const char *next = static_cast<const char*>(std::memchr(p, delimiter, lineEnd - p));
+    return next ? next : lineEnd;
+}
+
+//[begin, end) equal to 'word' ignoring case
+static bool EqualsIgnoreCase(const char *begin, const char *end, const char *word){
+    size_t length = std::strlen(word);
+    if (static_cast<size_t>(end - begin) != length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (std::tolower(static_cast<unsigned char>(begin[i])) != word[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CsvImporter::ParseDouble(const char *begin, const char *end, double& value){
+    const char *p = begin;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    //"inf", "-inf" and "nan" as Parse::FormatDouble and printf write them, so exported files read back
+    if (p < end && (*p == 'i' || *p == 'I' || *p == 'n' || *p == 'N')) {
+        if (EqualsIgnoreCase(p, end, "inf") || EqualsIgnoreCase(p, end, "infinity")) {
+            value = negative ? -HUGE_VAL : HUGE_VAL;
+            return true;
+        }
+        if (EqualsIgnoreCase(p, end, "nan")) {
+            value = NAN;
+            return true;
+        }
+        return false;
+    }
+    uint64_t mantissa = 0;
+    int digits = 0;         //significant digits in 'mantissa'
+    int exponent = 0;       //power of ten 'mantissa' is scaled by
+    bool sawDigit = false;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+        sawDigit = true;
+        if (mantissa == 0 && *p == '0') {
+            continue;
+        }
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits++;
+        }
+        else {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++) {
+            sawDigit = true;
+            if (mantissa == 0 && *p == '0') {
+                exponent--;
+                continue;
+            }
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits++;
+                exponent--;
+            }
+        }
+    }
+    if (!sawDigit) {
+        return false;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = (*p == '-');
+            p++;
+        }
+        if (p == end) {
+            return false;
+        }
+        int written = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; p++) {
+            if (written < 10000) {
+                written = written * 10 + (*p - '0');
+            }
+        }
+        exponent += negativeExponent ? -written : written;
+    }
+    if (p != end) {
+        return false;
+    }
+    //both operands exact, so the one rounding step is the correct rounding of the decimal (Clinger's fast path)
+    if (mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+        value = negative ? -result : result;
+        return true;
+    }
+    char text[128];
+    if (end - begin >= static_cast<long>(sizeof(text))) {
+        return false;
+    }
+    std::memcpy(text, begin, end - begin);
+    text[end - begin] = '\0';
+    value = std::strtod(text, nullptr);
+    return true;
+}
+
+bool CsvImporter::ParsePrice(const char *begin, const char *end, double& value){
+    //Parse::WriteToCSV writes NaN as an empty field
+    if (begin == end) {
+        value = NAN;
+        return true;
+    }
+    return ParseDouble(begin, end, value);
+}
+
+bool CsvImporter::ParseInteger(const char *begin, const char *end, int64_t& value){
+    const char *p = begin;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p == end) {
+        return false;
+    }
+    //stops before the digit that would overflow, the rest then takes the decimal path below
+    int64_t result = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++) {
+        int digit = *p - '0';
+        if (result > (INT64_MAX - digit) / 10) {
+            break;
+        }
+        result = result * 10 + digit;
+    }
+    if (p != end) {
+        //"1234.0" or "1.2e6", some vendors write volumes as decimals
+        double decimal;
+        if (!ParseDouble(begin, end, decimal)) {
+            return false;
+        }
+        //outside of int64_t (or NaN) llround has no defined result
+        if (!(decimal >= -9223372036854775808.0 && decimal < 9223372036854775808.0)) {
+            return false;
+        }
+        value = static_cast<int64_t>(std::llround(decimal));
+        return true;
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+bool CsvImporter::ParseTimeStamp(const char *begin, const char *end, int64_t& epoch, bool& timeOfDay){
+    size_t length = end - begin;
+    if (length == 10 || length == 19) {
+        if (EpochTime::Parse(begin, length, epoch)) {
+            timeOfDay = (length == 19);
+            return true;
+        }
+    }
+    //epoch seconds, or milliseconds
+    int64_t value;
+    if (length == 0 || !ParseInteger(begin, end, value)) {
+        return false;
+    }
+    epoch = length >= 13 ? value / 1000 : value;
+    timeOfDay = true;
+    return true;
+}
+
+size_t CsvImporter::LineOf(const char *file, const char *position){
+    return 1 + std::count(file, position, '\n');
+}
+
+const char *CsvImporter::ReadLayout(const char *begin, const char *end, Layout& layout){
+    const char *lineEnd = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+    if (lineEnd == nullptr) {
+        lineEnd = end;
+    }
+    layout.delimiter = ',';
+    const char candidates[] = {'\t', ';', '|'};
+    for (size_t i = 0; i < sizeof(candidates); i++) {
+        if (std::find(begin, lineEnd, ',') == lineEnd && std::find(begin, lineEnd, candidates[i]) != lineEnd) {
+            layout.delimiter = candidates[i];
+            break;
+        }
+    }
+
+    //split the first line, it is a header unless its first field is a datetime
+    std::vector<std::string> names;
+    const char *field = begin;
+    while (true) {
+        const char *fieldEnd = FieldEnd(field, lineEnd, layout.delimiter);
+        const char *first = field, *last = fieldEnd;
+        Trim(first, last);
+        std::string name(first, last);
+        for (size_t i = 0; i < name.size(); i++) {
+            name[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(name[i])));
+        }
+        names.push_back(name);
+        if (fieldEnd == lineEnd) {
+            break;
+        }
+        field = fieldEnd + 1;
+    }
+    int64_t epoch;
+    bool timeOfDay;
+    const char *firstEnd = FieldEnd(begin, lineEnd, layout.delimiter);
+    const char *first = begin;
+    Trim(first, firstEnd);
+    if (ParseTimeStamp(first, firstEnd, epoch, timeOfDay)) {
+        layout.dateTime = 0;
+        layout.open = 1;
+        layout.high = 2;
+        layout.low = 3;
+        layout.close = 4;
+        layout.volume = names.size() > 5 ? 5 : -1;
+        layout.fields = names.size() > 5 ? 6 : 5;
+        layout.required = 5;
+        return begin;
+    }
+
+    layout.dateTime = layout.open = layout.high = layout.low = layout.close = layout.volume = -1;
+    for (size_t i = 0; i < names.size(); i++) {
+        const std::string& name = names[i];
+        int index = static_cast<int>(i);
+        if (layout.dateTime < 0 && (name == "datetime" || name == "date" || name == "time" || name == "timestamp")) layout.dateTime = index;
+        else if (name == "open" || name == "o") layout.open = index;
+        else if (name == "high" || name == "h") layout.high = index;
+        else if (name == "low" || name == "l") layout.low = index;
+        else if (name == "close" || name == "c" || name == "last") layout.close = index;
+        else if (name == "volume" || name == "vol" || name == "v") layout.volume = index;
+    }
+    if (layout.dateTime < 0 || layout.open < 0 || layout.high < 0 || layout.low < 0 || layout.close < 0) {
+        throw std::runtime_error("CsvImporter.cpp @ ReadLayout: header needs datetime, open, high, low and close columns");
+    }
+    layout.required = 1 + std::max(std::max(std::max(layout.dateTime, layout.open), std::max(layout.high, layout.low)), layout.close);
+    layout.fields = std::max(layout.required, layout.volume + 1);
+    if (layout.fields > MAX_FIELDS) {
+        throw std::runtime_error("CsvImporter.cpp @ ReadLayout: bar columns past the first " + std::to_string(MAX_FIELDS) + " are not supported");
+    }
+    return lineEnd == end ? end : lineEnd + 1;
+}
+
+void CsvImporter::ParseChunk(const char *file, const char *begin, const char *end, const Layout& layout, BarStore& bars, bool& timeOfDay){
+    //the fields of the current line up to the last column we keep
+    const char *fieldBegin[MAX_FIELDS];
+    const char *fieldEnd[MAX_FIELDS];
+    int wanted = layout.fields;
+    const char *line = begin;
+    while (line < end) {
+        const char *lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        const char *p = line;
+        int count = 0;
+        while (count < wanted) {
+            const char *next = FieldEnd(p, lineEnd, layout.delimiter);
+            fieldBegin[count] = p;
+            fieldEnd[count] = next;
+            Trim(fieldBegin[count], fieldEnd[count]);
+            count++;
+            if (next == lineEnd) {
+                break;
+            }
+            p = next + 1;
+        }
+        //blank lines are skipped
+        if (count == 1 && fieldBegin[0] == fieldEnd[0]) {
+            line = lineEnd + 1;
+            continue;
+        }
+
+        int64_t timeStamp, volume = 0;
+        double open, high, low, close;
+        bool lineTimeOfDay = false;
+        bool ok = count >= layout.required
+                  && ParseTimeStamp(fieldBegin[layout.dateTime], fieldEnd[layout.dateTime], timeStamp, lineTimeOfDay)
+                  && ParsePrice(fieldBegin[layout.open], fieldEnd[layout.open], open)
+                  && ParsePrice(fieldBegin[layout.high], fieldEnd[layout.high], high)
+                  && ParsePrice(fieldBegin[layout.low], fieldEnd[layout.low], low)
+                  && ParsePrice(fieldBegin[layout.close], fieldEnd[layout.close], close);
+        if (ok && layout.volume >= 0 && layout.volume < count && fieldBegin[layout.volume] != fieldEnd[layout.volume]) {
+            ok = ParseInteger(fieldBegin[layout.volume], fieldEnd[layout.volume], volume);
+        }
+        if (!ok) {
+            throw std::runtime_error("CsvImporter.cpp @ Load: malformed bar on line " + std::to_string(LineOf(file, line)));
+        }
+        timeOfDay = timeOfDay || lineTimeOfDay;
+        bars.append(timeStamp, open, high, low, close, volume);
+        line = lineEnd + 1;
+    }
+}
+
+size_t CsvImporter::Load(const std::string& fileName, BarStore& bars, ThreadPool *pool){
+    static const Metrics::Stage STAGE_IMPORT = Metrics::Register("csv_import");
+    Metrics::Span span(STAGE_IMPORT);
+    bars.clear();
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("CsvImporter.cpp @ Load: failed to open " + fileName);
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::runtime_error("CsvImporter.cpp @ Load: failed to read " + fileName);
+    }
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    if (fileSize == 0) {
+        close(fd);
+        return 0;
+    }
+    void *mapped = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("CsvImporter.cpp @ Load: failed to map " + fileName);
+    }
+    std::shared_ptr<void> mapping(mapped, [fileSize](void *address){ munmap(address, fileSize); });
+    //read front to back once
+    madvise(mapped, fileSize, MADV_SEQUENTIAL);
+
+    const char *file = static_cast<const char*>(mapped);
+    const char *end = file + fileSize;
+    Layout layout;
+    const char *data = ReadLayout(file, end, layout);
+
+    //cut at line ends, one chunk per worker (more if the workers would get very large chunks)
+    std::vector<const char*> cuts(1, data);
+    size_t chunks = 1;
+    if (pool != nullptr && static_cast<size_t>(end - data) >= 2 * MIN_CHUNK_SIZE) {
+        chunks = std::min(pool->getThreadCount() * 4, static_cast<size_t>(end - data) / MIN_CHUNK_SIZE);
+    }
+    size_t chunkSize = (end - data) / chunks;
+    for (size_t i = 1; i < chunks; i++) {
+        const char *cut = std::max(cuts.back(), data + i * chunkSize);
+        const char *lineEnd = static_cast<const char*>(std::memchr(cut, '\n', end - cut));
+        cuts.push_back(lineEnd ? lineEnd + 1 : end);
+    }
+    cuts.push_back(end);
+
+    std::vector<BarStore> parts(cuts.size() - 1);
+    //char, not bool: the workers write their own element concurrently
+    std::vector<char> partTimeOfDay(parts.size(), 0);
+    if (parts.size() == 1) {
+        bool timeOfDay = false;
+        parts[0].reserve(fileSize / 48);
+        ParseChunk(file, cuts[0], cuts[1], layout, parts[0], timeOfDay);
+        partTimeOfDay[0] = timeOfDay;
+    }
+    else {
+        //a batch of its own, so Load may also run inside a task of the same pool
+        ThreadPool::Batch batch(*pool);
+        for (size_t i = 0; i < parts.size(); i++) {
+            batch.submit([&, i]{
+                bool timeOfDay = false;
+                parts[i].reserve((cuts[i + 1] - cuts[i]) / 48);
+                ParseChunk(file, cuts[i], cuts[i + 1], layout, parts[i], timeOfDay);
+                partTimeOfDay[i] = timeOfDay;
+            });
+        }
+        //rethrows the first malformed line
+        batch.wait();
+    }
+
+    size_t total = 0;
+    bool timeOfDay = false;
+    for (size_t i = 0; i < parts.size(); i++) {
+        total += parts[i].size();
+        timeOfDay = timeOfDay || partTimeOfDay[i];
+    }
+    BarStore joined;
+    joined.reserve(total);
+    for (size_t i = 0; i < parts.size(); i++) {
+        joined.append(parts[i], 0, parts[i].size());
+        parts[i] = BarStore();
+    }
+    joined.setHasTimeOfDay(timeOfDay);
+
+    //newest first like the API. Dumps are usually oldest first, then reversing is enough
+    ColumnView<int64_t> times = joined.getTimeStamps();
+    bool descending = true, ascending = true;
+    for (size_t i = 1; i < total && (descending || ascending); i++) {
+        descending = descending && times[i] <= times[i - 1];
+        ascending = ascending && times[i] >= times[i - 1];
+    }
+    if (descending) {
+        bars = std::move(joined);
+    }
+    else {
+        std::vector<size_t> order(total);
+        std::iota(order.begin(), order.end(), 0);
+        if (ascending) {
+            std::reverse(order.begin(), order.end());
+        }
+        else {
+            std::stable_sort(order.begin(), order.end(), [&times](size_t a, size_t b){ return times[a] > times[b]; });
+        }
+        bars.reserve(total);
+        ColumnView<double> opens = joined.getOpens(), highs = joined.getHighs(), lows = joined.getLows(), closes = joined.getCloses();
+        ColumnView<int64_t> volumes = joined.getVolumes();
+        for (size_t i = 0; i < total; i++) {
+            size_t j = order[i];
+            bars.append(times[j], opens[j], highs[j], lows[j], closes[j], volumes[j]);
+        }
+        bars.setHasTimeOfDay(timeOfDay);
+    }
+    return total;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef CSVIMPORTER_H
+#define CSVIMPORTER_H
+
+#include "BarStore.h"
+#include <cstddef>
+#include <string>
+
+class ThreadPool;
+
+/// @brief Bulk loader for OHLCV history in CSV/TSV files (vendor dumps, or files written by Parse::WriteToCSV).
+///        The file is memory mapped and parsed in place by hand written number and timestamp parsers, the bars go
+///        straight into a BarStore. With a ThreadPool the file is cut into chunks at line ends and the chunks are
+///        parsed concurrently, then joined in file order.
+///
+///        Layout: an optional header row names the columns (datetime/date/time/timestamp, open, high, low, close,
+///        volume, any case and order, other columns are skipped). Without one the columns are
+///        datetime,open,high,low,close[,volume]. The delimiter (',' '\t' ';' or '|') is detected from the first line.
+///        Datetimes are "YYYY-MM-DD HH:MM:SS", "YYYY-MM-DDTHH:MM:SS", "YYYY-MM-DD" or epoch seconds (milliseconds with 13
+///        digits), read as UTC. Fields may be quoted (a delimiter inside quotes belongs to the field, a quoted field cannot span lines), lines may
+///        end in \r\n, an empty volume counts as 0 and an empty price as NaN, so files written by Parse::WriteToCSV
+///        (NaN as an empty field, "inf"/"-inf") read back to the same bars.
+///        Bars may come oldest or newest first, the store always ends up newest first.
+///
+///        BarStore bars;
+///        ThreadPool pool;
+///        CsvImporter::Load("AAPL_1min.csv", bars, &pool);
+class CsvImporter{
+    public:
+        /// @brief replace the content of 'bars' with the bars in 'fileName'
+        /// @param pool workers to parse chunks on, nullptr parses on the calling thread. Small files are never split
+        /// @return number of bars loaded.
+        ///         Throws std::runtime_error if the file cannot be read or a line is malformed (the message names the line)
+        static size_t Load(const std::string& fileName, BarStore& bars, ThreadPool *pool = nullptr);
+
+        /// @brief decimal text [begin, end) --> 'value', correctly rounded. When the digits make an integer of at most 2^53
+        ///        and the power of ten is within 10^-22 .. 10^22 (every quote with up to 15 significant digits), it is one
+        ///        multiplication or division of two exact doubles, anything else goes through strtod.
+        ///        "inf", "infinity" and "nan" (any case, inf signed) are read as the non finite values
+        /// @return false if the text is not a number
+        static bool ParseDouble(const char *begin, const char *end, double& value);
+        /// @brief integer text [begin, end) --> 'value'. A fractional part is rounded away. Integers past INT64_MAX
+        ///        are read as a decimal (only -2^63 of them fits)
+        /// @return false if the text is not a number or does not fit an int64_t
+        static bool ParseInteger(const char *begin, const char *end, int64_t& value);
+
+    private:
+        /// @brief which field of a line holds which column, -1 if missing
+        struct Layout{
+            char delimiter;
+            int dateTime, open, high, low, close, volume;
+            int fields;         //fields split off a line, up to the last column kept
+            int required;       //fields a line needs at least, volume may be missing
+        };
+
+        /// @brief parse the lines in [begin, end) (begin at a line start) into 'bars', in file order
+        /// @param file start of the mapped file, to name the line of an error
+        static void ParseChunk(const char *file, const char *begin, const char *end, const Layout& layout, BarStore& bars, bool& timeOfDay);
+        /// @brief read the layout from the first line. Returns the first data line (past the header, if there is one)
+        static const char *ReadLayout(const char *begin, const char *end, Layout& layout);
+        /// @brief ParseDouble, and an empty field reads as NaN
+        static bool ParsePrice(const char *begin, const char *end, double& value);
+        static bool ParseTimeStamp(const char *begin, const char *end, int64_t& epoch, bool& timeOfDay);
+        /// @brief 1-based line number of 'position' for error messages
+        static size_t LineOf(const char *file, const char *position);
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef EPOCHTIME_CPP
+#define EPOCHTIME_CPP
+#include "EpochTime.h"
+
+#include <cstring>
+#include <ctime>
+
+//"00" "01" ... "99", two digits are copied at once
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+//days of a month in a common year, indexed by month - 1. Padded so a bad month still reads inside the table
+static const unsigned char DAYS_IN_MONTH[16] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0, 0};
+
+//the time part of a date only text
+static const char MIDNIGHT[] = " 00:00:00";
+
+//"0000-00-00 00:00:00" as three little endian words (the last 5 bytes past the text are 0), and the separator bytes in them
+static const uint64_t LAYOUT_WORDS[3] = {0x2D30302D30303030ULL, 0x30303A3030203030ULL, 0x000000000030303AULL};
+static const uint64_t SEPARATOR_MASK[3] = {0xFF0000FF00000000ULL, 0x0000FF0000FF0000ULL, 0xFFFFFFFFFF0000FFULL};
+
+int64_t EpochTime::DaysFromCivil(int64_t year, unsigned month, unsigned day){
+    //March based years put the leap day last, so a year's day count does not depend on the month
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+void EpochTime::CivilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day){
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+    day = static_cast<unsigned>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    month = static_cast<unsigned>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+bool EpochTime::Parse(const char *text, size_t length, int64_t& epoch){
+    if(length != 10 && length != 19){
+        return false;
+    }
+    //the full form in a local buffer, a date only text gets midnight
+    char full[24];
+    std::memcpy(full, text, length);
+    std::memcpy(full + 10, length == 19 ? text + 10 : MIDNIGHT, 9);
+    full[10] = full[10] == 'T' ? ' ' : full[10];
+
+    //XOR with the layout turns a digit into its value 0-9 and a correct separator into 0, 8 chars at a time.
+    //A byte is bad if it is not 0 at a separator or above 9 at a digit (+0x76 carries it into the top bit)
+    uint64_t words[3] = {0, 0, 0};
+    std::memcpy(words, full, 19);
+    unsigned bad = 0;
+    for(int i = 0; i < 3; i++){
+        uint64_t value = words[i] ^ LAYOUT_WORDS[i];
+        uint64_t digitBytes = value & ~SEPARATOR_MASK[i];
+        bad |= ((value & SEPARATOR_MASK[i]) != 0) | ((((digitBytes + 0x7676767676767676ULL) | digitBytes) & 0x8080808080808080ULL & ~SEPARATOR_MASK[i]) != 0);
+    }
+    const unsigned char *digits = reinterpret_cast<const unsigned char*>(full);
+
+    //unsigned 32 bit from here on, the compiler turns the divisions by constants into multiplications
+    unsigned year = ((digits[0] ^ '0') * 10 + (digits[1] ^ '0')) * 100 + (digits[2] ^ '0') * 10 + (digits[3] ^ '0');
+    unsigned month = (digits[5] ^ '0') * 10 + (digits[6] ^ '0');
+    unsigned day = (digits[8] ^ '0') * 10 + (digits[9] ^ '0');
+    unsigned hour = (digits[11] ^ '0') * 10 + (digits[12] ^ '0');
+    unsigned minute = (digits[14] ^ '0') * 10 + (digits[15] ^ '0');
+    unsigned second = (digits[17] ^ '0') * 10 + (digits[18] ^ '0');
+    unsigned leap = (year % 4 == 0) & ((year % 100 != 0) | (year % 400 == 0));
+    unsigned monthDays = DAYS_IN_MONTH[(month - 1) & 15] + ((month == 2) & leap);
+    bad |= (month - 1 > 11) | (day - 1 >= monthDays) | (hour > 23) | (minute > 59) | (second > 59);
+    if(bad){
+        return false;
+    }
+    //DaysFromCivil for a year 0000-9999, where every intermediate is non negative
+    unsigned shiftedYear = year + 400 - (month <= 2);
+    unsigned era = shiftedYear / 400;
+    unsigned yearOfEra = shiftedYear - era * 400;
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    int64_t days = static_cast<int64_t>(era) * 146097 + dayOfEra - 719468 - 146097;
+    epoch = days * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+bool EpochTime::Parse(const std::string& text, int64_t& epoch){
+    return Parse(text.data(), text.size(), epoch);
+}
+
+char *EpochTime::Format(int64_t epoch, bool timeOfDay, char *out){
+    int64_t days = epoch / 86400;
+    int64_t seconds = epoch % 86400;
+    if(seconds < 0){
+        seconds += 86400;
+        days--;
+    }
+    int64_t year;
+    unsigned month, day;
+    CivilFromDays(days, year, month, day);
+
+    if(year >= 0 && year <= 9999){
+        std::memcpy(out, DIGIT_PAIRS + 2 * (year / 100), 2);
+        std::memcpy(out + 2, DIGIT_PAIRS + 2 * (year % 100), 2);
+        out += 4;
+    }
+    else{
+        //outside of what the fixed format can hold, written out in full
+        char digits[24];
+        int count = 0;
+        uint64_t magnitude = year < 0 ? 0 - static_cast<uint64_t>(year) : static_cast<uint64_t>(year);
+        do{
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        }while(magnitude > 0);
+        if(year < 0){
+            *out++ = '-';
+        }
+        while(count > 0){
+            *out++ = digits[--count];
+        }
+    }
+    out[0] = '-';
+    std::memcpy(out + 1, DIGIT_PAIRS + 2 * month, 2);
+    out[3] = '-';
+    std::memcpy(out + 4, DIGIT_PAIRS + 2 * day, 2);
+    out += 6;
+    if(timeOfDay){
+        out[0] = ' ';
+        std::memcpy(out + 1, DIGIT_PAIRS + 2 * (seconds / 3600), 2);
+        out[3] = ':';
+        std::memcpy(out + 4, DIGIT_PAIRS + 2 * (seconds / 60 % 60), 2);
+        out[6] = ':';
+        std::memcpy(out + 7, DIGIT_PAIRS + 2 * (seconds % 60), 2);
+        out += 9;
+    }
+    return out;
+}
+
+std::string EpochTime::Format(int64_t epoch, bool timeOfDay){
+    char buffer[MAX_LENGTH];
+    return std::string(buffer, Format(epoch, timeOfDay, buffer));
+}
+
+//offset of one UTC day in the LocalOffset cache
+struct DayOffset{
+    bool filled;
+    bool uniform;   //the offset holds for the whole day, false on a day the offset changes
+    int64_t day;
+    int64_t offset;
+};
+
+static int64_t OffsetAt(int64_t epoch){
+    std::time_t time = static_cast<std::time_t>(epoch);
+    std::tm parts;
+    localtime_r(&time, &parts);
+    return parts.tm_gmtoff;
+}
+
+int64_t EpochTime::LocalOffset(int64_t epoch){
+    //per thread, so lookups need no lock. Direct mapped, a day only evicts the day 64 days away
+    static thread_local DayOffset cache[64];
+    int64_t day = epoch / 86400 - (epoch % 86400 < 0);
+    DayOffset& entry = cache[day & 63];
+    if(!entry.filled || entry.day != day){
+        entry.filled = true;
+        entry.day = day;
+        entry.offset = OffsetAt(day * 86400);
+        entry.uniform = OffsetAt(day * 86400 + 86399) == entry.offset;
+    }
+    return entry.uniform ? entry.offset : OffsetAt(epoch);
+}
+
+#endif
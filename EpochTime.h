@@ -0,0 +1,41 @@
+#ifndef EPOCHTIME_H
+#define EPOCHTIME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @brief Fixed format timestamp text <--> int64 epoch seconds, without the C library's time functions.
+///        Bars keep their datetime as epoch seconds (see BarStore.h), so comparing and joining times are integer
+///        compares and the text form is only made at the output edge. Parse and Format do not lock or allocate,
+///        they are plain arithmetic with at most one branch on the outcome. Wall clock times are read and written as UTC.
+///
+///        "YYYY-MM-DD HH:MM:SS" (also with a 'T' in place of the space) or "YYYY-MM-DD"
+class EpochTime{
+    public:
+        /// @brief text --> epoch seconds. The date has to exist (2024-02-30 does not), hours 00-23, minutes and seconds 00-59
+        /// @return false if the text is not a valid datetime in one of the two forms
+        static bool Parse(const char *text, size_t length, int64_t& epoch);
+        static bool Parse(const std::string& text, int64_t& epoch);
+
+        /// @brief epoch seconds --> "YYYY-MM-DD HH:MM:SS" (or "YYYY-MM-DD" when timeOfDay is false) at 'out'.
+        ///        Writes at most MAX_LENGTH chars, no terminating 0
+        /// @return end of what was written
+        static char *Format(int64_t epoch, bool timeOfDay, char *out);
+        static std::string Format(int64_t epoch, bool timeOfDay);
+
+        /// @brief seconds east of UTC of the local time zone at 'epoch', daylight saving included.
+        ///        Cached per calendar day and thread, so localtime_r only runs on the first lookup of a day
+        ///        (and for every lookup on the two days a year the offset changes). A TZ change after the first lookup
+        ///        of a day is not seen
+        static int64_t LocalOffset(int64_t epoch);
+
+        /// @brief days since 1970-01-01 of a proleptic Gregorian date, and back
+        static int64_t DaysFromCivil(int64_t year, unsigned month, unsigned day);
+        static void CivilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day);
+
+        /// @brief longest text Format writes, a year beyond 9999 included
+        static const size_t MAX_LENGTH = 40;
+};
+
+#endif
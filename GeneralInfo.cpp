@@ -2,12 +2,21 @@
 #define GENERALINFO_CPP
 #include "GeneralInfo.h"
 #include "Parse.h"
-#include <curl/curl.h>
+#include "TimeSeriesParser.h"
+#include "HttpClient.h"
+#include "BarCache.h"
+#include "BarSnapshot.h"
+#include "CsvImporter.h"
+#include "EpochTime.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
-#include <fstream>
 #include <string>
 #include <stdexcept>
-#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <json-c/json.h>
 //date 0
 //open 1
@@ -20,358 +29,126 @@
 //MAKE THE VECTORS POINTERS 
 GeneralInfo::GeneralInfo() {
     // Allocate memory for the vectors on the heap
-    valuesTS = new std::vector<StockValues>(); 
+    valuesTS = new BarStore(); 
     valuesER = new std::vector<ExchangeRateValues>();
     valuesCC = new std::vector<CurrencyConversionValues>();
+    cacheTS = nullptr; // no on-disk cache until setCacheDirectory
 }
 GeneralInfo::~GeneralInfo() {
     // Free the allocated memory
     delete valuesTS; 
     delete valuesER;
     delete valuesCC;
+    delete cacheTS;
 }
 //Time series functions
 void GeneralInfo::setValuesTS(std::string symbol, std::string intervalLength){
-    CURL *hnd = curl_easy_init();
+    static const Metrics::Stage STAGE_FETCH = Metrics::Register("fetch_time_series");
+    Metrics::Span span(STAGE_FETCH);
+    std::string URL = TimeSeriesURL(symbol, intervalLength, "1");
+    FetchValuesTS(URL, valuesTS);
+}
 
-    std::string URL = "https://api.twelvedata.com/time_series?symbol=" + symbol + "&interval=" + intervalLength + "&outputsize=1&apikey=41a5696d75774b8eb6929a1dc1af50d6";
-    std::string readBuffer; // String to store the response data
-    if (hnd) {
-        //std::string readBuffer; // String to store the response data
-        curl_easy_setopt(hnd, CURLOPT_CUSTOMREQUEST, "GET");
-        curl_easy_setopt(hnd, CURLOPT_URL, URL.c_str());
-        curl_easy_setopt(hnd, CURLOPT_WRITEFUNCTION, Parse::WriteCallBack); // Use the member function of Parse class
-        curl_easy_setopt(hnd, CURLOPT_WRITEDATA, &readBuffer); // Pass the instance of Parse class
-        CURLcode ret = curl_easy_perform(hnd); // Perform the CURL request
-        if (ret == CURLE_OK) {
-            Parse::WriteToJSON(readBuffer); // Call WriteToJSON to process and save the data
-        }
-        curl_easy_cleanup(hnd); // Clean up CURL
-    }
 
-    //open file
-    std::ifstream file("response.json");
-    try{
-        if(!file.is_open()){
-            throw std::runtime_error("json file failed to open for vector parsing");
-        }
-    }
-    catch(const std::runtime_error& e){
-        std::cerr << e.what() <<std::endl;
+void GeneralInfo::setValuesTS(std::string symbol, std::string intervalLength, std::string intervalAmount){
+    //the whole call: cache, transfer and parse
+    static const Metrics::Stage STAGE_FETCH = Metrics::Register("fetch_time_series");
+    Metrics::Span span(STAGE_FETCH);
+    if (cacheTS) {
+        // only the bars newer than the cached ones go over the network
+        FetchValuesTSCached(symbol, intervalLength, intervalAmount);
+        return;
     }
- 
-        // Assuming 'readBuffer' contains the JSON data as a string
-        struct json_object *parsed_json = json_tokener_parse(readBuffer.c_str());
-        struct json_object *values;
-        
-        // Get the 'values' array from the parsed JSON
-        json_object_object_get_ex(parsed_json, "values", &values);
-
-        size_t n_values = json_object_array_length(values);
-        for (size_t i = 0; i < n_values; i++) {
-            // Get the json object at the current index in the array
-            struct json_object *value = json_object_array_get_idx(values, i);
-
-            // Extract individual data from the object
-            struct json_object *datetime, *open, *high, *low, *close, *volume;
-            json_object_object_get_ex(value, "datetime", &datetime);
-            json_object_object_get_ex(value, "open", &open);
-            json_object_object_get_ex(value, "high", &high);
-            json_object_object_get_ex(value, "low", &low);
-            json_object_object_get_ex(value, "close", &close);
-            json_object_object_get_ex(value, "volume", &volume);
+    std::string URL = TimeSeriesURL(symbol, intervalLength, intervalAmount);
+    FetchValuesTS(URL, valuesTS);
+}
 
-            
-            StockValues stockValue;
-            stockValue.dateTime = json_object_get_string(datetime);
-            stockValue.open = json_object_get_string(open);
-            stockValue.high = json_object_get_string(high);
-            stockValue.low = json_object_get_string(low);
-            stockValue.close = json_object_get_string(close);
-            stockValue.volume = json_object_get_string(volume);
+void GeneralInfo::setCacheDirectory(const std::string& directory){
+    delete cacheTS;
+    cacheTS = directory.empty() ? nullptr : new BarCache(directory);
+}
 
-            valuesTS->push_back(stockValue);
-         
-        }
+void GeneralInfo::saveValuesTS(const std::string& path){
+    BarSnapshot::Write(path, *valuesTS);
+}
 
-        // Cleanup JSON object
-        json_object_put(parsed_json);
+void GeneralInfo::loadValuesTS(const std::string& path, bool verify){
+    if (!BarSnapshot::Load(path, *valuesTS, verify)) {
+        throw std::runtime_error("GeneralInfo.cpp @ loadValuesTS: " + path + " is missing or not a valid snapshot");
+    }
+}
 
+void GeneralInfo::importValuesTS(const std::string& fileName, ThreadPool *pool){
+    CsvImporter::Load(fileName, *valuesTS, pool);
 }
 
+std::vector<GeneralInfo::BatchResultTS> GeneralInfo::FetchValuesTSBatch(const std::vector<BatchRequestTS>& requests, long timeoutMs){
+    static const Metrics::Stage STAGE_BATCH = Metrics::Register("fetch_time_series_batch");
+    Metrics::Span span(STAGE_BATCH);
+    // Sized up front: the parsers and transfers keep pointers into these vectors
+    std::vector<BatchResultTS> results(requests.size());
+    std::vector<TimeSeriesParser> parsers;
+    parsers.reserve(requests.size());
+    std::vector<HttpClient::Transfer> transfers(requests.size());
+    for (size_t i = 0; i < requests.size(); i++) {
+        results[i].symbol = requests[i].symbol;
+        results[i].ok = false;
+        parsers.push_back(TimeSeriesParser(&results[i].bars));
+        transfers[i].URL = TimeSeriesURL(requests[i].symbol, requests[i].intervalLength, requests[i].intervalAmount);
+        transfers[i].writeFunction = Parse::StreamCallBack;
+        transfers[i].writeData = &parsers[i];
+    }
 
-void GeneralInfo::setValuesTS(std::string symbol, std::string intervalLength, std::string intervalAmount){
-   CURL *hnd = curl_easy_init();
+    HttpClient::Instance().performAll(transfers, timeoutMs);
 
-    std::string URL = "https://api.twelvedata.com/time_series?symbol=" + symbol + "&interval=" + intervalLength + "&outputsize=" + intervalAmount + "&apikey=41a5696d75774b8eb6929a1dc1af50d6";
-    std::string readBuffer; // String to store the response data
-    if (hnd) {
-        //std::string readBuffer; // String to store the response data
-        curl_easy_setopt(hnd, CURLOPT_CUSTOMREQUEST, "GET");
-        curl_easy_setopt(hnd, CURLOPT_URL, URL.c_str());
-        curl_easy_setopt(hnd, CURLOPT_WRITEFUNCTION, Parse::WriteCallBack); // Use the member function of Parse class
-        curl_easy_setopt(hnd, CURLOPT_WRITEDATA, &readBuffer); // Pass the instance of Parse class
-        CURLcode ret = curl_easy_perform(hnd); // Perform the CURL request
-        if (ret == CURLE_OK) {
-            Parse::WriteToJSON(readBuffer); // Call WriteToJSON to process and save the data
+    for (size_t i = 0; i < requests.size(); i++) {
+        if (transfers[i].result != CURLE_OK) {
+            results[i].error = std::string("GeneralInfo.cpp @ FetchValuesTSBatch: request failed: ") + curl_easy_strerror(transfers[i].result);
+            continue;
         }
-        curl_easy_cleanup(hnd); // Clean up CURL
-    }
-
-    std::ifstream file("response.json");
-    try{
-        if(!file.is_open()){
-            //std::cerr << "json file failed to open for vector parsing";
-            throw std::runtime_error("json file failed to open for vector parsing");
+        // an error page (5xx, a proxy's HTML) is not a malformed time_series, say what the server answered
+        if (transfers[i].responseCode >= 400) {
+            results[i].error = "GeneralInfo.cpp @ FetchValuesTSBatch: server answered HTTP status " + std::to_string(transfers[i].responseCode);
+            continue;
+        }
+        try {
+            parsers[i].finish();
+            results[i].ok = true;
+        }
+        catch (const std::runtime_error& e) {
+            results[i].error = e.what();
         }
     }
-    catch(const std::runtime_error& e){
-        std::cerr << e.what() <<std::endl;
-    }
- 
-    // Assuming 'readBuffer' contains the JSON data as a string
-    struct json_object *parsed_json = json_tokener_parse(readBuffer.c_str());
-    struct json_object *values;
-    
-    // Get the 'values' array from the parsed JSON
-    json_object_object_get_ex(parsed_json, "values", &values);
-
-    size_t n_values = json_object_array_length(values);
-    for (size_t i = 0; i < n_values; i++) {
-        // Get the json object at the current index in the array
-        struct json_object *value = json_object_array_get_idx(values, i);
-
-        // Extract individual data from the object
-        struct json_object *datetime, *open, *high, *low, *close, *volume;
-        json_object_object_get_ex(value, "datetime", &datetime);
-        json_object_object_get_ex(value, "open", &open);
-        json_object_object_get_ex(value, "high", &high);
-        json_object_object_get_ex(value, "low", &low);
-        json_object_object_get_ex(value, "close", &close);
-        json_object_object_get_ex(value, "volume", &volume);
-
-        StockValues stockValue;
-        stockValue.dateTime = json_object_get_string(datetime);
-        stockValue.open = json_object_get_string(open);
-        stockValue.high = json_object_get_string(high);
-        stockValue.low = json_object_get_string(low);
-        stockValue.close = json_object_get_string(close);
-        stockValue.volume = json_object_get_string(volume);
-
-        valuesTS->push_back(stockValue);
-    }
-    // Cleanup JSON object
-    json_object_put(parsed_json);
+    return results;
 }
 
 //Exchagne rate functions
 void GeneralInfo::setValuesER(std::string symbol1, std::string symbol2, std::string dateTimeString){
-   CURL *hnd = curl_easy_init();
-
-    std::string URL = "https://api.twelvedata.com/exchange_rate?symbol=" + symbol1 + "/" + symbol2 + "&date=" + dateTimeString + "&apikey=41a5696d75774b8eb6929a1dc1af50d6";
-    std::string readBuffer; // String to store the response data
-    if (hnd) {
-        //std::string readBuffer; // String to store the response data
-        curl_easy_setopt(hnd, CURLOPT_CUSTOMREQUEST, "GET");
-        curl_easy_setopt(hnd, CURLOPT_URL, URL.c_str());
-        curl_easy_setopt(hnd, CURLOPT_WRITEFUNCTION, Parse::WriteCallBack); // Use the member function of Parse class
-        curl_easy_setopt(hnd, CURLOPT_WRITEDATA, &readBuffer); // Pass the instance of Parse class
-        CURLcode ret = curl_easy_perform(hnd); // Perform the CURL request
-        if (ret == CURLE_OK) {
-            Parse::WriteToJSON(readBuffer); // Call WriteToJSON to process and save the data
-        }
-        curl_easy_cleanup(hnd); // Clean up CURL
-    }
-
-    FILE *fp = fopen("response.json", "r");
-
-
-  // Assuming 'readBuffer' contains the JSON data as a string
-    struct json_object *parsed_json = json_object_from_file("response.json"); //ADD EXCEPTION FOR IF NOT PARSED
-    if (!fp) {
-        throw std::runtime_error("Failed to open response.json for parsing");
+    if (!ValidateDateTime(dateTimeString)) {
+        throw std::invalid_argument("GeneralInfo.cpp @ setValuesER: 'dateTimeString' must be YYYY-MM-DD or YYYY-MM-DD HH:MM:SS");
     }
-
-    struct json_object *symbol, *rate, *timestamp;
-
-    json_object_object_get_ex(parsed_json,"symbol", &symbol);
-    json_object_object_get_ex(parsed_json, "rate", &rate);
-    json_object_object_get_ex(parsed_json, "timestamp", &timestamp);
-    
-    std::string timestampStr = std::to_string(json_object_get_int64(timestamp));
-    std::string formattedTime = ConvertFromUnixTime(timestampStr);
-   
-    ExchangeRateValues erVal;
-
-    erVal.symbol = json_object_get_string(symbol);
-    erVal.rate = json_object_get_string(rate);
-    erVal.dateTime = formattedTime;
-
-    valuesER->push_back(erVal);
-    
-  
-
-    // Cleanup JSON object
-    json_object_put(parsed_json);
-    fclose(fp);
-
+    std::string URL = HttpClient::Instance().getBaseURL() + "/exchange_rate?symbol=" + symbol1 + "/" + symbol2 + "&date=" + EscapeDateTime(dateTimeString) + "&apikey=" + HttpClient::Instance().getApiKey();
+    std::string readBuffer = FetchURL(URL); // response body, kept in memory
+    ParseValuesER(readBuffer);
 }
 void GeneralInfo::setValuesER(std::string symbol1, std::string symbol2){
-    CURL *hnd = curl_easy_init();
-
-    std::string URL = "https://api.twelvedata.com/exchange_rate?symbol=" + symbol1 + "/" + symbol2 + "&apikey=41a5696d75774b8eb6929a1dc1af50d6";
-    std::string readBuffer; // String to store the response data
-    if (hnd) {
-        //std::string readBuffer; // String to store the response data
-        curl_easy_setopt(hnd, CURLOPT_CUSTOMREQUEST, "GET");
-        curl_easy_setopt(hnd, CURLOPT_URL, URL.c_str());
-        curl_easy_setopt(hnd, CURLOPT_WRITEFUNCTION, Parse::WriteCallBack); // Use the member function of Parse class
-        curl_easy_setopt(hnd, CURLOPT_WRITEDATA, &readBuffer); // Pass the instance of Parse class
-        CURLcode ret = curl_easy_perform(hnd); // Perform the CURL request
-        if (ret == CURLE_OK) {
-            Parse::WriteToJSON(readBuffer); // Call WriteToJSON to process and save the data
-        }
-        curl_easy_cleanup(hnd); // Clean up CURL
-    }
-
-    FILE *fp = fopen("response.json", "r");
-
-
-  // Assuming 'readBuffer' contains the JSON data as a string
-    struct json_object *parsed_json = json_object_from_file("response.json"); //ADD EXCEPTION FOR IF NOT PARSED
-    if (!fp) {
-            throw std::runtime_error("Failed to open response.json for parsing");
-    }
-
-    struct json_object *symbol, *rate, *timestamp;
-
-    json_object_object_get_ex(parsed_json,"symbol", &symbol);
-    json_object_object_get_ex(parsed_json, "rate", &rate);
-    json_object_object_get_ex(parsed_json, "timestamp", &timestamp);
-
-    std::string timestampStr = std::to_string(json_object_get_int64(timestamp));
-    std::string formattedTime = ConvertFromUnixTime(timestampStr);
-
-    ExchangeRateValues erVal;
-
-    erVal.symbol = json_object_get_string(symbol);
-    erVal.rate = json_object_get_string(rate);
-    erVal.dateTime = formattedTime;
-
-    valuesER->push_back(erVal);
-
-    // Cleanup JSON object
-    json_object_put(parsed_json);
-    fclose(fp);
-
-
-
-
+    std::string URL = HttpClient::Instance().getBaseURL() + "/exchange_rate?symbol=" + symbol1 + "/" + symbol2 + "&apikey=" + HttpClient::Instance().getApiKey();
+    std::string readBuffer = FetchURL(URL); // response body, kept in memory
+    ParseValuesER(readBuffer);
 }
 //Currency exchange functions
 void GeneralInfo::setValuesCC(std::string symbol1, std::string symbol2, std::string amount){
-    CURL *hnd = curl_easy_init();
-   
-
-    std::string URL = "https://api.twelvedata.com/currency_conversion?symbol=" + symbol1 + "/" + symbol2 + "&amount=" + amount + "&apikey=41a5696d75774b8eb6929a1dc1af50d6";
-    std::string readBuffer; // String to store the response data
-    if (hnd) {
-        curl_easy_setopt(hnd, CURLOPT_CUSTOMREQUEST, "GET");
-        curl_easy_setopt(hnd, CURLOPT_URL, URL.c_str());
-        curl_easy_setopt(hnd, CURLOPT_WRITEFUNCTION, Parse::WriteCallBack); // Use the member function of Parse class
-        curl_easy_setopt(hnd, CURLOPT_WRITEDATA, &readBuffer); // Pass the instance of Parse class
-        CURLcode ret = curl_easy_perform(hnd); // Perform the CURL request
-        if (ret == CURLE_OK) {
-            Parse::WriteToJSON(readBuffer); // Call WriteToJSON to process and save the data
-        }
-        curl_easy_cleanup(hnd); // Clean up CURL
-    }
-
-    FILE *fp = fopen("response.json", "r");
-
-
-  // Assuming 'readBuffer' contains the JSON data as a string
-    struct json_object *parsed_json = json_object_from_file("response.json"); //ADD EXCEPTION FOR IF NOT PARSED
-    if (!fp) {
-            throw std::runtime_error("Failed to open response.json for parsing");
-    }
-
-    struct json_object *symbol, *rate, *timestamp, *amount1;
-
-    json_object_object_get_ex(parsed_json,"symbol", &symbol);
-    json_object_object_get_ex(parsed_json, "rate", &rate);
-    json_object_object_get_ex(parsed_json, "amount", &amount1);
-    json_object_object_get_ex(parsed_json, "timestamp", &timestamp);
-    //convert to correct time format 
-    std::string timestampStr = std::to_string(json_object_get_int64(timestamp));
-    std::string formattedTime = ConvertFromUnixTime(timestampStr);
-   
-
-    CurrencyConversionValues ccValue;
-
-    ccValue.symbol = json_object_get_string(symbol);
-    ccValue.rate = json_object_get_string(rate);
-    ccValue.amount = json_object_get_string(amount1);
-    ccValue.dateTime = formattedTime;
-
-    valuesCC->push_back(ccValue);
-
-    // Cleanup JSON object
-    json_object_put(parsed_json);
-    fclose(fp);
-
-
+    std::string URL = HttpClient::Instance().getBaseURL() + "/currency_conversion?symbol=" + symbol1 + "/" + symbol2 + "&amount=" + amount + "&apikey=" + HttpClient::Instance().getApiKey();
+    std::string readBuffer = FetchURL(URL); // response body, kept in memory
+    ParseValuesCC(readBuffer);
 }
 void GeneralInfo::setValuesCC(std::string symbol1, std::string symbol2, std::string amount, std::string dateTimeString){
-
-    CURL *hnd = curl_easy_init();
-   
-
-    std::string URL = "https://api.twelvedata.com/currency_conversion?symbol=" + symbol1 + "/" + symbol2 + "&amount=" + amount + "&date=" + dateTimeString + "&apikey=41a5696d75774b8eb6929a1dc1af50d6";
-    std::string readBuffer; // String to store the response data
-    if (hnd) {
-        curl_easy_setopt(hnd, CURLOPT_CUSTOMREQUEST, "GET");
-        curl_easy_setopt(hnd, CURLOPT_URL, URL.c_str());
-        curl_easy_setopt(hnd, CURLOPT_WRITEFUNCTION, Parse::WriteCallBack); // Use the member function of Parse class
-        curl_easy_setopt(hnd, CURLOPT_WRITEDATA, &readBuffer); // Pass the instance of Parse class
-        CURLcode ret = curl_easy_perform(hnd); // Perform the CURL request
-        if (ret == CURLE_OK) {
-            Parse::WriteToJSON(readBuffer); // Call WriteToJSON to process and save the data
-        }
-        curl_easy_cleanup(hnd); // Clean up CURL
-    }
-
-    FILE *fp = fopen("response.json", "r");
-
-
-    // Assuming 'readBuffer' contains the JSON data as a string
-    struct json_object *parsed_json = json_object_from_file("response.json"); //ADD EXCEPTION FOR IF NOT PARSED
-    if (!fp) {
-            throw std::runtime_error("Failed to open response.json for parsing");
+    if (!ValidateDateTime(dateTimeString)) {
+        throw std::invalid_argument("GeneralInfo.cpp @ setValuesCC: 'dateTimeString' must be YYYY-MM-DD or YYYY-MM-DD HH:MM:SS");
     }
-
-    struct json_object *symbol, *rate, *timestamp, *amount1;
-
-    json_object_object_get_ex(parsed_json,"symbol", &symbol);
-    json_object_object_get_ex(parsed_json, "rate", &rate);
-    json_object_object_get_ex(parsed_json, "amount", &amount1);
-    json_object_object_get_ex(parsed_json, "timestamp", &timestamp);
-    //convert to correct time format 
-    std::string timestampStr = std::to_string(json_object_get_int64(timestamp));
-    std::string formattedTime = ConvertFromUnixTime(timestampStr);
-    
-   CurrencyConversionValues ccValue;
-
-    ccValue.symbol = json_object_get_string(symbol);
-    ccValue.rate = json_object_get_string(rate);
-    ccValue.amount = json_object_get_string(amount1);
-    ccValue.dateTime = formattedTime;
-
-    valuesCC->push_back(ccValue);
-
-    // Cleanup JSON object
-    json_object_put(parsed_json);
-    fclose(fp);
+    std::string URL = HttpClient::Instance().getBaseURL() + "/currency_conversion?symbol=" + symbol1 + "/" + symbol2 + "&amount=" + amount + "&date=" + EscapeDateTime(dateTimeString) + "&apikey=" + HttpClient::Instance().getApiKey();
+    std::string readBuffer = FetchURL(URL); // response body, kept in memory
+    ParseValuesCC(readBuffer);
 }
 
 
@@ -381,8 +158,7 @@ std::string GeneralInfo::getOpenTSAt(int interval){
     if(interval < 0 || interval >= valuesTS->size()){
         return "GeneralInfo.cpp @ getOpenTSAt: interval passed is invalid. Try again";
     }
-    std::string openValue = valuesTS->at(interval).open;
-    return openValue;
+    return FormatPrice(valuesTS->getOpens()[interval]);
 }
 std::string GeneralInfo::getHighTSAt(int interval){
     //given interval, fetch high value at said interval
@@ -390,8 +166,7 @@ std::string GeneralInfo::getHighTSAt(int interval){
     if(interval < 0 || interval >= valuesTS->size()){
         return "GeneralInfo.cpp @ getHighTSAt: interval passed is invalid. Try again";
     }
-    std::string highValue = valuesTS->at(interval).high;
-    return highValue;
+    return FormatPrice(valuesTS->getHighs()[interval]);
 }
 std::string GeneralInfo::getLowTSAt(int interval){
     //given interval, fetch low value at said interval
@@ -399,8 +174,7 @@ std::string GeneralInfo::getLowTSAt(int interval){
     if(interval < 0 || interval >= valuesTS->size()){
         return "GeneralInfo.cpp @ getLowTSAt: interval passed is invalid. Try again";
     }
-    std::string lowValue = valuesTS->at(interval).low;
-    return lowValue;
+    return FormatPrice(valuesTS->getLows()[interval]);
 }
 std::string GeneralInfo::getCloseTSAt(int interval){
     //given interval, fetch close value at said interval
@@ -408,8 +182,7 @@ std::string GeneralInfo::getCloseTSAt(int interval){
     if(interval < 0 || interval >= valuesTS->size()){
         return "GeneralInfo.cpp @ getCloseTSAt: interval passed is invalid. Try again";
     }
-    std::string closeValue = valuesTS->at(interval).close;
-    return closeValue;
+    return FormatPrice(valuesTS->getCloses()[interval]);
 }
 std::string GeneralInfo::getVolumeTSAt(int interval){
     //given interval, fetch vollume value at said interval
@@ -418,8 +191,7 @@ std::string GeneralInfo::getVolumeTSAt(int interval){
     if(interval < 0 || interval >= valuesTS->size()){
         return "GeneralInfo.cpp @ getVolumeTSAt: interval passed is invalid. Try again";
     }
-    std::string volumeValue = valuesTS->at(interval).volume; 
-    return volumeValue;
+    return std::to_string(valuesTS->getVolumes()[interval]);
 }
 std::string GeneralInfo::getTimeStampTSAt(int interval){
     //given interval, fetch time value at said interval
@@ -428,64 +200,85 @@ std::string GeneralInfo::getTimeStampTSAt(int interval){
     if(interval < 0 || interval >= valuesTS->size()){
         return "GeneralInfo.cpp @ getTimeStampTSAt: interval passed is invalid. Try again";
     }
-    std::string dateValue = valuesTS->at(interval).dateTime; 
-    return dateValue;
+    return ConvertFromEpoch(valuesTS->getTimeStamps()[interval], valuesTS->hasTimeOfDay());
+}
+
+
+//Time series range getters
+BarRange GeneralInfo::getRangeTS(int64_t from, int64_t to){
+    return valuesTS->range(from, to);
+}
+BarRange GeneralInfo::getRangeTS(const std::string& from, const std::string& to){
+    int64_t fromEpoch, toEpoch;
+    if(!EpochTime::Parse(from, fromEpoch) || !EpochTime::Parse(to, toEpoch)){
+        throw std::invalid_argument("GeneralInfo.cpp @ getRangeTS: datetimes must be YYYY-MM-DD or YYYY-MM-DD HH:MM:SS");
+    }
+    return valuesTS->range(fromEpoch, toEpoch);
+}
+BarRange GeneralInfo::getLastSessionTS(){
+    if(valuesTS->empty()){
+        return valuesTS->slice(0, 0);
+    }
+    //time stamps are wall clock, so a session's bars share the calendar day of their epoch
+    int64_t newest = valuesTS->getTimeStamps()[0];
+    int64_t dayStart = newest - ((newest % 86400) + 86400) % 86400;
+    return valuesTS->range(dayStart, dayStart + 86400);
 }
 
 
 
 //Time series all intervals getters
 std::vector<std::string> GeneralInfo::getAllTimeStampTS(){
-    //vector to return holding all values of type specified
+    //vector to return holding all values of type specified, formatted from the numeric column
     std::vector<std::string> temp;
-    for (const auto& stockValue : *valuesTS) {
-        // Push the value string into the temp vector
-        temp.push_back(stockValue.dateTime);
+    temp.reserve(valuesTS->size());
+    for (auto timeStamp : valuesTS->getTimeStamps()) {
+        temp.push_back(ConvertFromEpoch(timeStamp, valuesTS->hasTimeOfDay()));
     }
     return temp;
 }
 std::vector<std::string> GeneralInfo::getAllHighTS(){
-    //vector to return holding all values of type specified
+    //vector to return holding all values of type specified, formatted from the numeric column
     std::vector<std::string> temp;
-    for (const auto& stockValue : *valuesTS) {
-        // Push the value string into the temp vector
-        temp.push_back(stockValue.high);
+    temp.reserve(valuesTS->size());
+    for (auto value : valuesTS->getHighs()) {
+        temp.push_back(FormatPrice(value));
     }
     return temp;
 }
 std::vector<std::string> GeneralInfo::getAllLowTS(){
-    //vector to return holding all values of type specified
+    //vector to return holding all values of type specified, formatted from the numeric column
     std::vector<std::string> temp;
-    for (const auto& stockValue : *valuesTS) {
-        // Push the value string into the temp vector
-        temp.push_back(stockValue.low);
+    temp.reserve(valuesTS->size());
+    for (auto value : valuesTS->getLows()) {
+        temp.push_back(FormatPrice(value));
     }
     return temp;
 }
 std::vector<std::string> GeneralInfo::getAllOpenTS(){
-    //vector to return holding all values of type specified
+    //vector to return holding all values of type specified, formatted from the numeric column
     std::vector<std::string> temp;
-    for (const auto& stockValue : *valuesTS) {
-        // Push the value string into the temp vector
-        temp.push_back(stockValue.open);
+    temp.reserve(valuesTS->size());
+    for (auto value : valuesTS->getOpens()) {
+        temp.push_back(FormatPrice(value));
     }
     return temp;
 }
 std::vector<std::string> GeneralInfo::getAllCloseTS(){
-    //vector to return holding all values of type specified
+    //vector to return holding all values of type specified, formatted from the numeric column
     std::vector<std::string> temp;
-    for (const auto& stockValue : *valuesTS) {
-        // Push the value string into the temp vector
-        temp.push_back(stockValue.close);
+    temp.reserve(valuesTS->size());
+    for (auto value : valuesTS->getCloses()) {
+        temp.push_back(FormatPrice(value));
     }
     return temp;
 }
 std::vector<std::string> GeneralInfo::getAllVolumeTS(){
-    //vector to return holding all values of type specified
+    //vector to return holding all values of type specified, formatted from the numeric column
     std::vector<std::string> temp;
-    for (const auto& stockValue : *valuesTS) {
-        // Push the value string into the temp vector
-        temp.push_back(stockValue.volume);
+    temp.reserve(valuesTS->size());
+    for (auto volume : valuesTS->getVolumes()) {
+        temp.push_back(std::to_string(volume));
     }
     return temp;
 }
@@ -509,15 +302,170 @@ std::string GeneralInfo::getTimeStampCC(){
 //Real time price getter
 double GeneralInfo::getRealTimePriceRTP(std::string symbol){return 0;}
 //HELPER FUNCTIONS
-std::string GeneralInfo::ConvertFromUnixTime(std::string unixTime){
-    std::time_t result = std::stol(unixTime);
-    std::tm *ptm = std::localtime(&result);
-
+std::string GeneralInfo::ConvertFromUnixTime(int64_t unixTime){
+    //the zone offset is cached per day, no localtime per record
+    return EpochTime::Format(unixTime + EpochTime::LocalOffset(unixTime), true);
+}
+std::string GeneralInfo::ConvertFromEpoch(int64_t epoch, bool timeOfDay){
+    return EpochTime::Format(epoch, timeOfDay);
+}
+std::string GeneralInfo::FormatPrice(double price){
+    //the exporters' formatter, one digit generation pass and no read back
+    if(std::isnan(price)){
+        return "nan";
+    }
     char buffer[32];
-    std::strftime(buffer, 32, "%Y-%m-%d %H:%M:%S", ptm);
+    return std::string(buffer, Parse::FormatDouble(price, buffer));
+}
+void GeneralInfo::FetchURL(const std::string& URL, size_t (*writeFunction)(void *, size_t, size_t, void *), void *writeData){
+    // pooled handle, keep-alive connection and cached DNS/TLS session shared by every GeneralInfo (see HttpClient.h)
+    long status = HttpClient::Instance().get(URL, writeFunction, writeData);
+    // an error page (5xx, a proxy's HTML) is not a malformed response, say what the server answered.
+    // Only the part before the query goes into the message, the query carries the apikey
+    if (status >= 400) {
+        throw std::runtime_error("GeneralInfo.cpp @ FetchURL: " + URL.substr(0, URL.find('?')) + " answered HTTP status " + std::to_string(status));
+    }
+}
+std::string GeneralInfo::FetchURL(const std::string& URL){
+    std::string readBuffer; // String to store the response data
+    FetchURL(URL, Parse::WriteCallBack, &readBuffer);
+    // Only touches the disk when debug dumping was switched on with Parse::SetDebugDump, every response gets its own file
+    if (Parse::DebugDumpEnabled()) {
+        Parse::WriteToJSON(readBuffer);
+    }
+    return readBuffer;
+}
+json_object *GeneralInfo::ParseResponse(const std::string& readBuffer){
+    // Parse the response straight from memory, one pass
+    static const Metrics::Stage STAGE_PARSE = Metrics::Register("parse_json");
+    uint64_t start = Metrics::IsEnabled() ? Metrics::Ticks() : 0;
+    struct json_object *parsed_json = json_tokener_parse(readBuffer.c_str());
+    if (start != 0) {
+        Metrics::Record(STAGE_PARSE, Metrics::ToNanoseconds(Metrics::Ticks() - start));
+    }
+    if (parsed_json == nullptr) {
+        throw std::runtime_error("GeneralInfo.cpp @ ParseResponse: response is not valid JSON");
+    }
+    // The API reports errors as {"code":..., "message":..., "status":"error"}
+    struct json_object *status = nullptr, *message = nullptr;
+    if (json_object_object_get_ex(parsed_json, "status", &status) && std::strcmp(json_object_get_string(status), "error") == 0) {
+        std::string error = "GeneralInfo.cpp @ ParseResponse: API returned an error";
+        if (json_object_object_get_ex(parsed_json, "message", &message)) {
+            error += std::string(": ") + json_object_get_string(message);
+        }
+        json_object_put(parsed_json);
+        throw std::runtime_error(error);
+    }
+    return parsed_json;
+}
+void GeneralInfo::ParseValuesER(const std::string& readBuffer){
+    struct json_object *parsed_json = ParseResponse(readBuffer);
+    struct json_object *symbol = nullptr, *rate = nullptr, *timestamp = nullptr;
+
+    json_object_object_get_ex(parsed_json,"symbol", &symbol);
+    json_object_object_get_ex(parsed_json, "rate", &rate);
+    json_object_object_get_ex(parsed_json, "timestamp", &timestamp);
+    if (!symbol || !rate || !timestamp) {
+        json_object_put(parsed_json);
+        throw std::runtime_error("GeneralInfo.cpp @ ParseValuesER: response is missing symbol, rate or timestamp");
+    }
+
+    std::string formattedTime = ConvertFromUnixTime(json_object_get_int64(timestamp));
+
+    ExchangeRateValues erVal;
+
+    erVal.symbol = json_object_get_string(symbol);
+    erVal.rate = json_object_get_string(rate);
+    erVal.dateTime = formattedTime;
 
-    return std::string(buffer);
+    valuesER->push_back(erVal);
 
+    // Cleanup JSON object
+    json_object_put(parsed_json);
+}
+void GeneralInfo::ParseValuesCC(const std::string& readBuffer){
+    struct json_object *parsed_json = ParseResponse(readBuffer);
+    struct json_object *symbol = nullptr, *rate = nullptr, *timestamp = nullptr, *amount = nullptr;
+
+    json_object_object_get_ex(parsed_json,"symbol", &symbol);
+    json_object_object_get_ex(parsed_json, "rate", &rate);
+    json_object_object_get_ex(parsed_json, "amount", &amount);
+    json_object_object_get_ex(parsed_json, "timestamp", &timestamp);
+    if (!symbol || !rate || !amount || !timestamp) {
+        json_object_put(parsed_json);
+        throw std::runtime_error("GeneralInfo.cpp @ ParseValuesCC: response is missing symbol, rate, amount or timestamp");
+    }
+    //convert to correct time format 
+    std::string formattedTime = ConvertFromUnixTime(json_object_get_int64(timestamp));
+
+    CurrencyConversionValues ccValue;
+
+    ccValue.symbol = json_object_get_string(symbol);
+    ccValue.rate = json_object_get_string(rate);
+    ccValue.amount = json_object_get_string(amount);
+    ccValue.dateTime = formattedTime;
+
+    valuesCC->push_back(ccValue);
+
+    // Cleanup JSON object
+    json_object_put(parsed_json);
+}
+std::string GeneralInfo::TimeSeriesURL(const std::string& symbol, const std::string& intervalLength, const std::string& intervalAmount, const std::string& startDate){
+    std::string URL = HttpClient::Instance().getBaseURL() + "/time_series?symbol=" + symbol + "&interval=" + intervalLength + "&outputsize=" + intervalAmount;
+    if (!startDate.empty()) {
+        URL += "&start_date=" + EscapeDateTime(startDate);
+    }
+    return URL + "&apikey=" + HttpClient::Instance().getApiKey();
+}
+void GeneralInfo::FetchValuesTS(const std::string& URL, BarStore *bars){
+    // Bars go straight from the network chunks into 'bars', no DOM in between
+    TimeSeriesParser parser(bars);
+    if (Parse::DebugDumpEnabled()) {
+        // the dump needs the whole body anyway, parse it from memory afterwards
+        std::string readBuffer = FetchURL(URL);
+        parser.feed(readBuffer.data(), readBuffer.size());
+    }
+    else {
+        FetchURL(URL, Parse::StreamCallBack, &parser);
+    }
+    parser.finish();
+}
+void GeneralInfo::FetchValuesTSCached(const std::string& symbol, const std::string& intervalLength, const std::string& intervalAmount){
+    size_t wanted = std::stoul(intervalAmount);
+    BarStore cached;
+    cacheTS->load(symbol, intervalLength, cached);
+    if (!cached.empty()) {
+        // top up: ask only for the bars from the newest cached one on. That bar comes again because it may have still been forming
+        int64_t newestCached = cached.getTimeStamps()[0];
+        BarStore fresh;
+        FetchValuesTS(TimeSeriesURL(symbol, intervalLength, intervalAmount, ConvertFromEpoch(newestCached, cached.hasTimeOfDay())), &fresh);
+        // a full page that does not reach back to the cached bars leaves a hole, the cache is useless then
+        if (fresh.size() >= wanted && fresh.getTimeStamps()[fresh.size() - 1] > newestCached) {
+            cached.clear();
+        }
+        BarCache::Merge(cached, fresh);
+    }
+    if (cached.size() < wanted) {
+        // not enough history cached yet, fetch the whole window once
+        BarStore full;
+        FetchValuesTS(TimeSeriesURL(symbol, intervalLength, intervalAmount), &full);
+        BarCache::Merge(cached, full);
+    }
+    cacheTS->store(symbol, intervalLength, cached);
+
+    valuesTS->setHasTimeOfDay(cached.hasTimeOfDay());
+    valuesTS->append(cached, 0, std::min(wanted, cached.size()));
+}
+bool GeneralInfo::ValidateDateTime(const std::string& dateTimeString){
+    int64_t epoch;
+    return EpochTime::Parse(dateTimeString, epoch);
+}
+std::string GeneralInfo::EscapeDateTime(const std::string& dateTimeString){
+    // "YYYY-MM-DD HH:MM:SS", the space has to be escaped in a URL
+    std::string escaped;
+    for (size_t i = 0; i < dateTimeString.size(); i++) {
+        escaped += dateTimeString[i] == ' ' ? std::string("%20") : std::string(1, dateTimeString[i]);
+    }
+    return escaped;
 }
-bool GeneralInfo::ValidateDateTime(const std::string& dateTimeString){return false;}
 #endif 
\ No newline at end of file
@@ -1,27 +1,33 @@
 #ifndef GENERALINFO_H
 #define GENERALINFO_H
 
+#include "BarStore.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
+struct json_object;
+class BarCache;
+class ThreadPool;
+
 //STILL NEED:
 
 //getters for specific intervals
 //getters for the highest/lowest values of {high, low, open, close}
 //public var for keeping track of # of intervals in the TS vector?
 
+/*  THREAD SAFETY
+    Each GeneralInfo (and Analytics) instance keeps all of its state in its own members: responses are read into
+    per-request buffers and parsed from memory, nothing goes through a shared file. So one instance per thread is safe,
+    e.g. one per worker of a ThreadPool (see IndicatorScan.h). The process wide pieces are safe to share:
+    HttpClient locks its handle pool and curl caches, Parse::SetDebugDump is atomic and every dump gets its own file,
+    BarCache writes through a temp file of its own and renames it over the target,
+    Metrics records into histograms of the calling thread.
+    A single instance is NOT safe to use from several threads at once.
+*/
 class GeneralInfo{
     public:
 
-        struct StockValues{
-            std::string dateTime;
-            std::string open;
-            std::string high;
-            std::string low;
-            std::string close;
-            std::string volume;
-        };
-
         struct ExchangeRateValues{
             std::string symbol;
             std::string rate;
@@ -36,7 +42,8 @@ class GeneralInfo{
         };
 
 
-        std::vector<StockValues> *valuesTS;
+        //time series bars, stored column wise as numbers (see BarStore.h). Filled once by setValuesTS
+        BarStore *valuesTS;
         std::vector<ExchangeRateValues> *valuesER;
         std::vector<CurrencyConversionValues> *valuesCC;
 
@@ -72,7 +79,8 @@ class GeneralInfo{
         std::string getVolumeTS();
 
 
-
+        //prices of the getters below and of getAll*TS are formatted from the stored doubles (FormatPrice): the shortest text
+        //that reads back to the same value, so trailing zeros the API sent are not kept ("168.58000" comes back as "168.58")
         std::string getOpenTSAt(int interval);
         std::string getHighTSAt(int interval);
         std::string getLowTSAt(int interval);
@@ -81,6 +89,17 @@ class GeneralInfo{
         std::string getTimeStampTSAt(int interval);
 
 
+        //TIME SERIES --> bars between two times, as views into 'valuesTS' (see BarRange in BarStore.h).
+        //One binary search over the time stamps, nothing is copied. The views are valid until 'valuesTS' is set again
+
+        //bars with from <= datetime < to, in epoch seconds (wall clock read as UTC, like the bars' time stamps)
+        BarRange getRangeTS(int64_t from, int64_t to);
+        //same, with "YYYY-MM-DD" or "YYYY-MM-DD HH:MM:SS" datetimes. Throws std::invalid_argument if one is not valid
+        BarRange getRangeTS(const std::string& from, const std::string& to);
+        //bars on the calendar day of the newest bar, i.e. the last trading session. Empty if there are no bars
+        BarRange getLastSessionTS();
+
+
 
 
 
@@ -141,26 +160,76 @@ class GeneralInfo{
         //TIME SERIES SETTERS
 
         /*  Given company symbol and interval length. Interval observed will be: current time --> (current time - interval).
-            Run the http request, use WriteCallBack() and WriteToJson() to read and write to .json file
-            Use Parse function to read the .json file and put TSValues all in the array 'genTSValues'
+            Run the http request, and stream the response chunks through TimeSeriesParser
+            which puts the bars into 'valuesTS' as they arrive
         */
         void setValuesTS(std::string symbol, std::string intervalLength); 
         /*  Given company symbol, interval length, and number of intervals. all the values of each interval will be placed in array consecutively
-            Run the http request, use WriteCallBack() and WriteToJson() to read and write to .json file
-            Use Parse function to read the .json file and put TSValues all in the array 'genTSValues'
+            Run the http request, and stream the response chunks through TimeSeriesParser
+            which puts the bars into 'valuesTS' as they arrive
         */
         void setValuesTS(std::string symbol, std::string intervalLength, std::string intervalAmount);
 
 
+        //TIME SERIES CACHE
+
+        /*  Keep fetched bars in 'directory' (one memory mapped file per symbol and interval, see BarCache.h).
+            setValuesTS(symbol, intervalLength, intervalAmount) then only requests the bars newer than the last cached one
+            and merges them in. An empty string turns the cache off again (the default)
+        */
+        void setCacheDirectory(const std::string& directory);
+
+
+        //TIME SERIES SNAPSHOTS
+
+        //write 'valuesTS' to a binary snapshot file (see BarSnapshot.h). Throws std::runtime_error if it cannot be written
+        void saveValuesTS(const std::string& path);
+        /*  Replace 'valuesTS' with the bars of a snapshot written by saveValuesTS, without fetching or parsing anything.
+            The file is memory mapped and the bars are read from the mapping, zero copy.
+            'verify' checks the snapshot's checksum first (reads the whole file).
+            Throws std::runtime_error if the file is missing or not a valid snapshot
+        */
+        void loadValuesTS(const std::string& path, bool verify = false);
+        /*  Replace 'valuesTS' with the bars of a CSV/TSV file, e.g. a vendor history dump (see CsvImporter.h for the layouts read).
+            With a ThreadPool large files are parsed in chunks on its workers.
+            Throws std::runtime_error if the file cannot be read or has a malformed line
+        */
+        void importValuesTS(const std::string& fileName, ThreadPool *pool = nullptr);
+
+
+        //BATCH TIME SERIES
+
+        //one (symbol, interval, outputsize) request of a batch
+        struct BatchRequestTS{
+            std::string symbol;
+            std::string intervalLength;
+            std::string intervalAmount;
+        };
+        //bars fetched for one request of a batch
+        struct BatchResultTS{
+            std::string symbol;
+            BarStore bars;
+            bool ok;            //false if the request failed, timed out or the API returned an error
+            std::string error;  //reason when !ok
+        };
+        /*  Fetch many time series at once. All requests run concurrently through one curl_multi event loop
+            (HttpClient::performAll) and every response is streamed into its own BarStore while it arrives.
+            Returns when all requests are done or 'timeoutMs' has passed, one result per request in the same order.
+            A failed request (transport error, HTTP status >= 400, API error or malformed body) does not throw, check
+            'ok' and 'error' of its result.
+        */
+        static std::vector<BatchResultTS> FetchValuesTSBatch(const std::vector<BatchRequestTS>& requests, long timeoutMs = 30000);
+
+
         //EXCHANGE RATE SETTERS (DONT NEED?)
 
         /*  Given company symbol1 and another company symbol2, and a specific dateTimeString. 
-            Run http request, use WriteCallback() and WriteToJson() to read and write to .json file
+            Run http request, use WriteCallback() to read the response into memory and parse it from there
             Put all values in array vector 'valuesER'..... <symbol1/symbol2, exchange rate, unix timestamp>
         */
         void setValuesER(std::string symbol1, std::string symbol2, std::string dateTimeString);
         /*  Given company symbol1 and another company symbol2. (http request will return local exchange time) 
-            Run http request, use WriteCallback() and WriteToJson() to read and write to .json file
+            Run http request, use WriteCallback() to read the response into memory and parse it from there
             Put all values in array vector 'valuesER'..... <symbol1/symbol2, exchange rate, unix timestamp>
         */
         void setValuesER(std::string symbol1, std::string symbol2);
@@ -170,20 +239,50 @@ class GeneralInfo{
         //CURRENCY CONVERSION SETTERS (OVERWRITES EXCHANGE RATE?)
 
         /*  Given company symbol1 and another company symbol2, and amount. (http request will return local exchange time) 
-            Run http request, use WriteCallback() and WriteToJson() to read and write to .json file
+            Run http request, use WriteCallback() to read the response into memory and parse it from there
             Put all values in array vector 'valuesCC'..... <symbol1/symbol2, exchange rate, amount,  unix timestamp>
         */
         void setValuesCC(std::string symbol1, std::string symbol2, std::string amount);
         /*  Given company symbol1 and another company symbol2, amount, and dateTimeString. (http request will return rate & amount at specified time) 
-            Run http request, use WriteCallback() and WriteToJson() to read and write to .json file
+            Run http request, use WriteCallback() to read the response into memory and parse it from there
             Put all values in array vector 'valuesCC'..... <symbol1/symbol2, exchange rate, amount, unix timestamp>
         */
         void setValuesCC(std::string symbol1, std::string symbol2, std::string amount, std::string dateTimeString);
 
         //HELPER FUNCTIONS
+    protected:
+        //shortest text form of a price that reads back to the same double, Parse::FormatDouble. NaN as "nan"
+        std::string FormatPrice(double price);
     private:
-        std::string ConvertFromUnixTime(std::string unixTime);
+        //unix time --> "YYYY-MM-DD HH:MM:SS" in the local time zone
+        std::string ConvertFromUnixTime(int64_t unixTime);
+        //epoch seconds --> "YYYY-MM-DD HH:MM:SS" (or "YYYY-MM-DD" when timeOfDay is false), see EpochTime.h
+        std::string ConvertFromEpoch(int64_t epoch, bool timeOfDay);
+        //run a GET request, handing every received chunk to writeFunction(contents, size, nmemb, writeData).
+        //Throws if the transfer fails or the server answers with an HTTP status >= 400 (named in the message)
+        void FetchURL(const std::string& URL, size_t (*writeFunction)(void *, size_t, size_t, void *), void *writeData);
+        //run a GET request and return the response body, throws like the overload above. Nothing is written to disk unless Parse::SetDebugDump(true)
+        //(then into a file of its own, see Parse::WriteToJSON)
+        std::string FetchURL(const std::string& URL);
+        //parse a response held in memory. Throws if it is not JSON or the API reported an error. Caller frees with json_object_put
+        struct json_object *ParseResponse(const std::string& readBuffer);
+        //time_series URL for symbol/interval/outputsize, only bars from startDate on if it is not empty
+        static std::string TimeSeriesURL(const std::string& symbol, const std::string& intervalLength, const std::string& intervalAmount, const std::string& startDate = "");
+        //run a time_series request and stream its bars into 'bars' while they arrive (see TimeSeriesParser.h)
+        void FetchValuesTS(const std::string& URL, BarStore *bars);
+        //setValuesTS through the on-disk cache: load cached bars, fetch the newer ones, merge, save, append the newest 'intervalAmount' to valuesTS
+        void FetchValuesTSCached(const std::string& symbol, const std::string& intervalLength, const std::string& intervalAmount);
+
+        //on-disk bar cache, nullptr when disabled
+        BarCache *cacheTS;
+        //parse an exchange_rate response into valuesER
+        void ParseValuesER(const std::string& readBuffer);
+        //parse a currency_conversion response into valuesCC
+        void ParseValuesCC(const std::string& readBuffer);
+        //true if dateTimeString is a real date in the form YYYY-MM-DD or YYYY-MM-DD HH:MM:SS
         bool ValidateDateTime(const std::string& dateTimeString);
+        //dateTimeString as a URL parameter
+        static std::string EscapeDateTime(const std::string& dateTimeString);
 
 };
 
@@ -0,0 +1,234 @@
+#ifndef HTTPCLIENT_CPP
+#define HTTPCLIENT_CPP
+#include "HttpClient.h"
+#include "Metrics.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+HttpClient& HttpClient::Instance(){
+    //constructed once, thread safe since C++11
+    static HttpClient instance;
+    return instance;
+}
+
+HttpClient::HttpClient() : maxIdleHandles(16), maxHostConnections(8), baseURL("https://api.twelvedata.com") {
+    //the environment picks the server and key without a rebuild, e.g. a local mock server for offline runs
+    const char *environmentURL = std::getenv("TWELVEDATA_BASE_URL");
+    if (environmentURL && *environmentURL) {
+        setBaseURL(environmentURL);
+    }
+    const char *environmentKey = std::getenv("TWELVEDATA_API_KEY");
+    if (environmentKey && *environmentKey) {
+        apiKey = environmentKey;
+    }
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    share = curl_share_init();
+    if (share) {
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, LockShare);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, UnlockShare);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        //one DNS cache and TLS session cache for every handle. The connection cache is not shared: libcurl does not
+        //support a shared connection cache used by several threads at once. Each pooled handle keeps its own open
+        //connections instead
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+}
+
+HttpClient::~HttpClient(){
+    for (size_t i = 0; i < idleHandles.size(); i++) {
+        curl_easy_cleanup(idleHandles[i]);
+    }
+    idleHandles.clear();
+    if (share) {
+        curl_share_cleanup(share);
+    }
+    curl_global_cleanup();
+}
+
+void HttpClient::setBaseURL(const std::string& baseURL){
+    std::lock_guard<std::mutex> guard(poolLock);
+    //"http://host/" and "http://host" both work, paths are appended with a leading '/'
+    this->baseURL = baseURL;
+    while (!this->baseURL.empty() && this->baseURL[this->baseURL.size() - 1] == '/') {
+        this->baseURL.erase(this->baseURL.size() - 1);
+    }
+}
+
+std::string HttpClient::getBaseURL(){
+    std::lock_guard<std::mutex> guard(poolLock);
+    return baseURL;
+}
+
+void HttpClient::setApiKey(const std::string& apiKey){
+    std::lock_guard<std::mutex> guard(poolLock);
+    this->apiKey = apiKey;
+}
+
+std::string HttpClient::getApiKey(){
+    std::lock_guard<std::mutex> guard(poolLock);
+    //no key in the source, a request without one fails here rather than with an API error payload
+    if (apiKey.empty()) {
+        throw std::runtime_error("HttpClient.cpp @ getApiKey: no API key configured, set TWELVEDATA_API_KEY or call HttpClient::setApiKey");
+    }
+    return apiKey;
+}
+
+void HttpClient::setMaxIdleHandles(size_t maxIdle){
+    std::lock_guard<std::mutex> guard(poolLock);
+    maxIdleHandles = maxIdle;
+}
+
+void HttpClient::setMaxHostConnections(long maxConnections){
+    std::lock_guard<std::mutex> guard(poolLock);
+    maxHostConnections = maxConnections;
+}
+
+//curl times every transfer anyway, so the http stages cost no clock reads of their own.
+//Connect is 0 on a reused connection, first byte includes the connect, transfer is the whole request
+static void RecordTimings(CURL *handle){
+    if (!Metrics::IsEnabled()) {
+        return;
+    }
+    static const Metrics::Stage STAGE_CONNECT = Metrics::Register("http_connect");
+    static const Metrics::Stage STAGE_FIRST_BYTE = Metrics::Register("http_first_byte");
+    static const Metrics::Stage STAGE_TRANSFER = Metrics::Register("http_transfer");
+    curl_off_t connect = 0, firstByte = 0, total = 0;
+    curl_easy_getinfo(handle, CURLINFO_CONNECT_TIME_T, &connect);
+    curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME_T, &firstByte);
+    curl_easy_getinfo(handle, CURLINFO_TOTAL_TIME_T, &total);
+    //microseconds
+    Metrics::Record(STAGE_CONNECT, static_cast<uint64_t>(connect) * 1000);
+    Metrics::Record(STAGE_FIRST_BYTE, static_cast<uint64_t>(firstByte) * 1000);
+    Metrics::Record(STAGE_TRANSFER, static_cast<uint64_t>(total) * 1000);
+}
+
+long HttpClient::get(const std::string& URL, WriteFunction writeFunction, void *writeData){
+    CURL *hnd = acquire(URL, writeFunction, writeData);
+    CURLcode ret = curl_easy_perform(hnd); // Perform the CURL request
+    long responseCode = 0;
+    curl_easy_getinfo(hnd, CURLINFO_RESPONSE_CODE, &responseCode);
+    RecordTimings(hnd);
+    release(hnd);
+    if (ret != CURLE_OK) {
+        throw std::runtime_error(std::string("HttpClient.cpp @ get: request failed: ") + curl_easy_strerror(ret));
+    }
+    return responseCode;
+}
+
+void HttpClient::performAll(std::vector<Transfer>& transfers, long timeoutMs){
+    CURLM *multi = curl_multi_init();
+    if (!multi) {
+        throw std::runtime_error("HttpClient.cpp @ performAll: curl_multi_init failed");
+    }
+    //let concurrent transfers to one host share an HTTP/2 connection
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    {
+        std::lock_guard<std::mutex> guard(poolLock);
+        curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, maxHostConnections);
+    }
+
+    std::vector<CURL*> handles;
+    handles.reserve(transfers.size());
+    //removes and releases whatever was added so far, also when acquire throws halfway through the setup
+    auto teardown = [&]() {
+        for (size_t i = 0; i < handles.size(); i++) {
+            curl_multi_remove_handle(multi, handles[i]);
+            release(handles[i]);
+        }
+        curl_multi_cleanup(multi);
+    };
+    try {
+        for (size_t i = 0; i < transfers.size(); i++) {
+            handles.push_back(acquire(transfers[i].URL, transfers[i].writeFunction, transfers[i].writeData));
+            curl_easy_setopt(handles[i], CURLOPT_PRIVATE, &transfers[i]);
+            //every transfer is added now, so a per transfer limit is also the limit of the batch
+            curl_easy_setopt(handles[i], CURLOPT_TIMEOUT_MS, timeoutMs);
+            //failed until curl reports it done, so a transfer cut short by a multi error never reads as a success
+            transfers[i].result = CURLE_RECV_ERROR;
+            transfers[i].responseCode = 0;
+            curl_multi_add_handle(multi, handles[i]);
+        }
+
+        int running = 0;
+        do {
+            CURLMcode mc = curl_multi_perform(multi, &running);
+            if (mc == CURLM_OK && running) {
+                mc = curl_multi_poll(multi, NULL, 0, 1000, NULL);
+            }
+            if (mc != CURLM_OK) {
+                break;
+            }
+            //collect the transfers that finished in this round
+            CURLMsg *msg;
+            int left;
+            while ((msg = curl_multi_info_read(multi, &left))) {
+                if (msg->msg == CURLMSG_DONE) {
+                    Transfer *transfer = NULL;
+                    curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&transfer);
+                    transfer->result = msg->data.result;
+                    curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &transfer->responseCode);
+                    RecordTimings(msg->easy_handle);
+                }
+            }
+        } while (running);
+    }
+    catch (...) {
+        teardown();
+        throw;
+    }
+    teardown();
+}
+
+CURL *HttpClient::acquire(const std::string& URL, WriteFunction writeFunction, void *writeData){
+    CURL *hnd = NULL;
+    {
+        std::lock_guard<std::mutex> guard(poolLock);
+        if (!idleHandles.empty()) {
+            hnd = idleHandles.back();
+            idleHandles.pop_back();
+        }
+    }
+    if (!hnd) {
+        hnd = curl_easy_init();
+        if (!hnd) {
+            throw std::runtime_error("HttpClient.cpp @ acquire: curl_easy_init failed");
+        }
+    }
+    curl_easy_setopt(hnd, CURLOPT_SHARE, share);
+    curl_easy_setopt(hnd, CURLOPT_HTTPGET, 1L);
+    curl_easy_setopt(hnd, CURLOPT_URL, URL.c_str());
+    curl_easy_setopt(hnd, CURLOPT_WRITEFUNCTION, writeFunction); // called for every chunk received
+    curl_easy_setopt(hnd, CURLOPT_WRITEDATA, writeData); // passed back to writeFunction
+    //HTTP/2 over TLS when the server offers it, otherwise HTTP/1.1 keep-alive
+    curl_easy_setopt(hnd, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+    //wait for an existing connection to multiplex on rather than opening a new one
+    curl_easy_setopt(hnd, CURLOPT_PIPEWAIT, 1L);
+    curl_easy_setopt(hnd, CURLOPT_TCP_KEEPALIVE, 1L);
+    //gzip/deflate, decoded by curl before writeFunction sees it
+    curl_easy_setopt(hnd, CURLOPT_ACCEPT_ENCODING, "");
+    curl_easy_setopt(hnd, CURLOPT_NOSIGNAL, 1L);
+    return hnd;
+}
+
+void HttpClient::release(CURL *handle){
+    //forget the options of the last request, curl_easy_reset keeps the handle's open connections
+    curl_easy_reset(handle);
+    std::lock_guard<std::mutex> guard(poolLock);
+    if (idleHandles.size() < maxIdleHandles) {
+        idleHandles.push_back(handle);
+        return;
+    }
+    curl_easy_cleanup(handle);
+}
+
+void HttpClient::LockShare(CURL *, curl_lock_data data, curl_lock_access, void *userptr){
+    static_cast<HttpClient*>(userptr)->shareLocks[data].lock();
+}
+
+void HttpClient::UnlockShare(CURL *, curl_lock_data data, void *userptr){
+    static_cast<HttpClient*>(userptr)->shareLocks[data].unlock();
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef HTTPCLIENT_H
+#define HTTPCLIENT_H
+
+#include <curl/curl.h>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// @brief Process wide connection manager for the API requests.
+///        Instead of a curl_easy_init/curl_easy_cleanup pair per request, easy handles are kept in a pool and reused,
+///        and all of them share one DNS cache and TLS session cache (curl share interface). A pooled handle keeps its
+///        keep-alive connection open between requests, so a request to the same host skips the TCP and TLS handshakes.
+///        HTTP/2 is negotiated over TLS when the server supports it, and transfers run together through performAll()
+///        are multiplexed over a single HTTP/2 connection.
+///        All member functions are thread safe.
+class HttpClient{
+    public:
+        /// @brief signature of a curl write callback, e.g. Parse::WriteCallBack or Parse::StreamCallBack
+        typedef size_t (*WriteFunction)(void *contents, size_t size, size_t nmemb, void *userp);
+
+        /// @brief one GET request for performAll()
+        struct Transfer{
+            std::string URL;
+            WriteFunction writeFunction;
+            void *writeData;
+            //filled by performAll()
+            CURLcode result;
+            long responseCode;
+        };
+
+        /// @brief the shared instance used by every GeneralInfo object
+        static HttpClient& Instance();
+
+        /// @brief scheme and host every API path is appended to. Default "https://api.twelvedata.com",
+        ///        or the TWELVEDATA_BASE_URL environment variable when it is set.
+        ///        Point it at a local stand-in server (e.g. replay/mock_twelvedata.py on "http://127.0.0.1:8080") for offline testing.
+        void setBaseURL(const std::string& baseURL);
+        std::string getBaseURL();
+        /// @brief key sent as 'apikey' with every request. Default the TWELVEDATA_API_KEY environment variable.
+        ///        There is no built in key: getApiKey() throws std::runtime_error while none is configured
+        void setApiKey(const std::string& apiKey);
+        std::string getApiKey();
+
+        /// @brief most handles kept idle in the pool. Extra handles are cleaned up when released. Default 16
+        void setMaxIdleHandles(size_t maxIdle);
+
+        /// @brief run one blocking GET request on a pooled handle. Every received chunk goes to writeFunction(..., writeData).
+        ///        Throws std::runtime_error if the transfer fails
+        /// @return HTTP response code
+        long get(const std::string& URL, WriteFunction writeFunction, void *writeData);
+
+        /// @brief most connections performAll() opens to one host, extra transfers wait for a free connection
+        ///        or multiplex on an HTTP/2 one. Default 8
+        void setMaxHostConnections(long maxConnections);
+
+        /// @brief run all transfers concurrently on one curl_multi handle, multiplexed over shared HTTP/2 connections
+        ///        where possible. Returns when every transfer is done or timed out, each transfer's result and responseCode are set
+        /// @param timeoutMs time limit for the whole batch in milliseconds, counted from the call. 0 for no limit.
+        ///        Transfers still running at the limit end with result CURLE_OPERATION_TIMEDOUT. When the multi handle
+        ///        itself fails, the transfers not finished by then end with result CURLE_RECV_ERROR.
+        ///        Throws std::runtime_error if a handle cannot be created, after giving back the handles set up by then
+        void performAll(std::vector<Transfer>& transfers, long timeoutMs = 0);
+
+        ~HttpClient();
+
+    private:
+        HttpClient();
+        HttpClient(const HttpClient&);
+        HttpClient& operator=(const HttpClient&);
+
+        /// @brief take a handle from the pool (or make a new one) and set it up for a GET of URL
+        CURL *acquire(const std::string& URL, WriteFunction writeFunction, void *writeData);
+        /// @brief give a handle back to the pool, its keep-alive connection stays open for the next request on it
+        void release(CURL *handle);
+
+        static void LockShare(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr);
+        static void UnlockShare(CURL *handle, curl_lock_data data, void *userptr);
+
+        CURLSH *share;
+        std::mutex shareLocks[CURL_LOCK_DATA_LAST];
+
+        std::mutex poolLock; //guards idleHandles, maxIdleHandles, maxHostConnections, baseURL and apiKey
+        std::vector<CURL*> idleHandles;
+        size_t maxIdleHandles;
+        long maxHostConnections;
+        std::string baseURL;
+        std::string apiKey;
+};
+
+#endif
@@ -0,0 +1,203 @@
+#ifndef INDICATORGRAPH_CPP
+#define INDICATORGRAPH_CPP
+#include "IndicatorGraph.h"
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+static const double NOT_AVAILABLE = std::numeric_limits<double>::quiet_NaN();
+
+IndicatorGraph::IndicatorGraph(Analytics& data) : data(data), window(0), evaluations(0) {}
+
+IndicatorGraph::NodeId IndicatorGraph::column(const std::string& typeOfData){
+    if(typeOfData != "open" && typeOfData != "high" && typeOfData != "low" && typeOfData != "close" && typeOfData != "volume"){
+        throw std::invalid_argument("IndicatorGraph.cpp @ column: 'typeOfData' must be one of {open, high, low, close, volume}");
+    }
+    Node node = {KIND_COLUMN, 0, 0, 0, typeOfData};
+    return Intern(node);
+}
+
+IndicatorGraph::NodeId IndicatorGraph::trueRange(){
+    Node node = {KIND_TRUE_RANGE, 0, 0, 0, ""};
+    return Intern(node);
+}
+
+IndicatorGraph::NodeId IndicatorGraph::typicalPrice(){
+    Node node = {KIND_TYPICAL_PRICE, 0, 0, 0, ""};
+    return Intern(node);
+}
+
+IndicatorGraph::NodeId IndicatorGraph::accumDistr(){
+    Node node = {KIND_ACCUM_DISTR, 0, 0, 0, ""};
+    return Intern(node);
+}
+
+IndicatorGraph::NodeId IndicatorGraph::ema(NodeId input, int period){
+    if(input >= nodes.size() || period <= 0){
+        throw std::invalid_argument("IndicatorGraph.cpp @ ema: unknown 'input' node or 'period' <= 0");
+    }
+    Node node = {KIND_EMA, input, 0, period, ""};
+    return Intern(node);
+}
+
+IndicatorGraph::NodeId IndicatorGraph::sma(NodeId input, int period){
+    if(input >= nodes.size() || period <= 0){
+        throw std::invalid_argument("IndicatorGraph.cpp @ sma: unknown 'input' node or 'period' <= 0");
+    }
+    Node node = {KIND_SMA, input, 0, period, ""};
+    return Intern(node);
+}
+
+IndicatorGraph::NodeId IndicatorGraph::sub(NodeId a, NodeId b){
+    if(a >= nodes.size() || b >= nodes.size()){
+        throw std::invalid_argument("IndicatorGraph.cpp @ sub: unknown input node");
+    }
+    Node node = {KIND_SUB, a, b, 0, ""};
+    return Intern(node);
+}
+
+IndicatorGraph::NodeId IndicatorGraph::adosc(int shortEMA, int longEMA){
+    NodeId ad = accumDistr();
+    return sub(ema(ad, shortEMA), ema(ad, longEMA));
+}
+
+IndicatorGraph::NodeId IndicatorGraph::emaSpread(NodeId input, int fast, int slow){
+    return sub(ema(input, fast), ema(input, slow));
+}
+
+const std::vector<double>& IndicatorGraph::evaluate(NodeId node){
+    if(node >= nodes.size()){
+        throw std::invalid_argument("IndicatorGraph.cpp @ evaluate: unknown node");
+    }
+    if(!computed[node]){
+        Compute(node);
+    }
+    return series[node];
+}
+
+void IndicatorGraph::invalidate(){
+    for(size_t i = 0; i < computed.size(); i++){
+        computed[i] = false;
+        series[i].clear();
+    }
+}
+
+void IndicatorGraph::setWindow(size_t bars){
+    if(bars != window){
+        window = bars;
+        invalidate();
+    }
+}
+
+size_t IndicatorGraph::getNodeCount() const{
+    return nodes.size();
+}
+
+size_t IndicatorGraph::getEvaluationCount() const{
+    return evaluations;
+}
+
+IndicatorGraph::NodeId IndicatorGraph::Intern(const Node& node){
+    //inputs are interned first, so (kind, inputs, period, column) identifies a node
+    std::string key = std::to_string(node.kind) + "(" + std::to_string(node.a) + "," + std::to_string(node.b) + ","
+                      + std::to_string(node.period) + "," + node.typeOfData + ")";
+    std::map<std::string, NodeId>::iterator found = nodeIndex.find(key);
+    if(found != nodeIndex.end()){
+        return found->second;
+    }
+    nodes.push_back(node);
+    series.push_back(std::vector<double>());
+    computed.push_back(false);
+    nodeIndex[key] = nodes.size() - 1;
+    return nodes.size() - 1;
+}
+
+void IndicatorGraph::Compute(NodeId id){
+    const Node& node = nodes[id];
+    //inputs first, so the node's Metrics stage times this node alone
+    if(node.kind == KIND_EMA || node.kind == KIND_SMA || node.kind == KIND_SUB){
+        evaluate(node.a);
+    }
+    if(node.kind == KIND_SUB){
+        evaluate(node.b);
+    }
+    //one stage per node kind, in Kind order
+    static const Metrics::Stage STAGES[] = {
+        Metrics::Register("graph_column"), Metrics::Register("graph_true_range"), Metrics::Register("graph_typical_price"),
+        Metrics::Register("graph_accum_distr"), Metrics::Register("graph_ema"), Metrics::Register("graph_sma"),
+        Metrics::Register("graph_sub")};
+    Metrics::Span span(STAGES[node.kind]);
+    size_t bars = window == 0 ? data.valuesTS->size() : std::min(window, data.valuesTS->size());
+    //computed into the node's own series, whose storage is kept from window to window: once the graph has seen a window
+    //this large, evaluating it allocates nothing
+    std::vector<double>& out = series[id];
+    out.assign(bars, NOT_AVAILABLE);
+
+    switch(node.kind){
+        case KIND_COLUMN:{
+            if(node.typeOfData == "volume"){
+                ColumnView<int64_t> volumes = data.valuesTS->getVolumes();
+                for(size_t i = 0; i < bars; i++){
+                    out[i] = static_cast<double>(volumes[i]);
+                }
+                break;
+            }
+            ColumnView<double> values = node.typeOfData == "open" ? data.getOpens()
+                                      : node.typeOfData == "high" ? data.getHighs()
+                                      : node.typeOfData == "low" ? data.getLows() : data.getCloses();
+            std::copy(values.begin(), values.begin() + bars, out.begin());
+            break;
+        }
+        case KIND_TRUE_RANGE:{
+            if(bars > 1){
+                data.TrueRange(static_cast<int>(bars) - 1, out.data());
+            }
+            break;
+        }
+        case KIND_TYPICAL_PRICE:
+            PriceTransform::TypPrice(data.valuesTS->getHighs().data(), data.valuesTS->getLows().data(),
+                                     data.valuesTS->getCloses().data(), out.data(), bars);
+            break;
+        case KIND_ACCUM_DISTR:
+            //anchored at the oldest bar of the window, so the line and every EMA of it match the standalone calls
+            data.ChaikinAD(static_cast<int>(bars), out.data());
+            break;
+        case KIND_EMA:
+        case KIND_SMA:
+            MovingAverage(evaluate(node.a), node.period, node.kind == KIND_EMA, out);
+            break;
+        case KIND_SUB:{
+            const std::vector<double>& a = evaluate(node.a);
+            const std::vector<double>& b = evaluate(node.b);
+            for(size_t i = 0; i < bars; i++){
+                out[i] = a[i] - b[i];
+            }
+            break;
+        }
+    }
+    computed[id] = true;
+    evaluations++;
+}
+
+void IndicatorGraph::MovingAverage(const std::vector<double>& input, int period, bool exponential, std::vector<double>& out){
+    //inputs are valid from the newest bar back to their own lookback, NaN behind it
+    size_t valid = 0;
+    while(valid < input.size() && !std::isnan(input[valid])){
+        valid++;
+    }
+    if(valid < static_cast<size_t>(period)){
+        return;
+    }
+    //the kernels write the valid part of 'out' straight, the rest stays NaN
+    if(exponential){
+        Analytics::ExponentialMovingAverage(input.data(), valid, period, out.data());
+    }
+    else{
+        Analytics::SimpleMovingAverage(input.data(), valid, period, out.data());
+    }
+}
+
+#endif
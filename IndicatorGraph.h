@@ -0,0 +1,88 @@
+#ifndef INDICATORGRAPH_H
+#define INDICATORGRAPH_H
+
+#include "Analytics.h"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+/// @brief Dependency graph (DAG) of indicator building blocks evaluated over one bar window, the newest setWindow() bars
+///        of 'valuesTS'. Every node is a series aligned with those bars (index 0 newest, NaN where the node's lookback
+///        is not covered yet), computed as the Analytics call given just the window would compute it. Nodes are deduplicated on construction: asking twice for ema(close, 12), or for trueRange()
+///        from ATR and from KELTNER, returns the same node, and evaluate() computes each node at most once per window.
+///
+///        IndicatorGraph graph(analytics);
+///        NodeId macd = graph.sub(graph.ema(graph.column("close"), 12), graph.ema(graph.column("close"), 26));
+///        NodeId apo  = graph.sub(graph.ema(graph.column("close"), 12), graph.ema(graph.column("close"), 26)); //same node as macd
+///        graph.evaluate(macd);
+class IndicatorGraph{
+    public:
+        typedef size_t NodeId;
+
+        /// @param data bars the graph is evaluated over (its 'valuesTS'). Not owned
+        explicit IndicatorGraph(Analytics& data);
+
+        //SOURCE NODES
+        /// @brief one price column, typeOfData one of {open, high, low, close, volume}
+        NodeId column(const std::string& typeOfData);
+        /// @brief true range, see Analytics::TrueRange. NaN for the oldest bar (no previous close)
+        NodeId trueRange();
+        /// @brief typical price (high + low + close) / 3
+        NodeId typicalPrice();
+        /// @brief Chaikin A/D line accumulated from the oldest bar of the window, Analytics::ChaikinAD(window)
+        NodeId accumDistr();
+
+        //DERIVED NODES
+        /// @brief exponential moving average of 'input', seeded with the SMA of its oldest 'period' values
+        NodeId ema(NodeId input, int period);
+        /// @brief simple moving average of 'input'
+        NodeId sma(NodeId input, int period);
+        /// @brief a - b
+        NodeId sub(NodeId a, NodeId b);
+
+        //COMPOSITES (built from the nodes above, so they share them)
+        /// @brief ADOSC = EMA(AD, shortEMA) - EMA(AD, longEMA)
+        NodeId adosc(int shortEMA, int longEMA);
+        /// @brief MACD line / APO = EMA(input, fast) - EMA(input, slow)
+        NodeId emaSpread(NodeId input, int fast, int slow);
+
+        /// @brief series of 'node', computing it and whatever it depends on if that was not done for this window yet
+        const std::vector<double>& evaluate(NodeId node);
+        /// @brief forget every computed series, e.g. after 'valuesTS' changed. The nodes themselves stay
+        void invalidate();
+        /// @brief evaluate over the newest 'bars' bars of 'valuesTS' (0, the default: all of them, also when it holds
+        ///        fewer). A different window invalidates
+        void setWindow(size_t bars);
+
+        /// @brief number of distinct nodes in the graph
+        size_t getNodeCount() const;
+        /// @brief number of node computations since construction (each node once per window when shared correctly)
+        size_t getEvaluationCount() const;
+
+    private:
+        enum Kind { KIND_COLUMN, KIND_TRUE_RANGE, KIND_TYPICAL_PRICE, KIND_ACCUM_DISTR, KIND_EMA, KIND_SMA, KIND_SUB };
+        struct Node{
+            Kind kind;
+            NodeId a;
+            NodeId b;
+            int period;
+            std::string typeOfData;
+        };
+
+        /// @brief the existing node with this description, or a new one
+        NodeId Intern(const Node& node);
+        void Compute(NodeId id);
+        /// @brief moving average of the valid (not NaN) newest part of 'input' into 'out', already sized and NaN filled
+        void MovingAverage(const std::vector<double>& input, int period, bool exponential, std::vector<double>& out);
+
+        Analytics& data;
+        std::vector<Node> nodes;
+        std::map<std::string, NodeId> nodeIndex; //node description --> id, the deduplication table
+        std::vector<std::vector<double>> series;
+        std::vector<bool> computed;
+        size_t window;
+        size_t evaluations;
+};
+
+#endif
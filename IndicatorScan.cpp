@@ -0,0 +1,97 @@
+#ifndef INDICATORSCAN_CPP
+#define INDICATORSCAN_CPP
+#include "IndicatorScan.h"
+
+#include <exception>
+#include <memory>
+
+IndicatorScan::IndicatorScan(const std::string& intervalLength, ThreadPool& pool) : intervalLength(intervalLength), pool(pool) {}
+
+size_t IndicatorScan::add(const IndicatorSession::Spec& spec){
+    //validated the same way a session would
+    IndicatorSession check("", intervalLength);
+    check.add(spec);
+    specs.push_back(spec);
+    return specs.size() - 1;
+}
+
+int IndicatorScan::getWindowSize() const{
+    IndicatorSession window("", intervalLength);
+    for(size_t i = 0; i < specs.size(); i++){
+        window.add(specs[i]);
+    }
+    return window.getWindowSize();
+}
+
+std::vector<IndicatorScan::SymbolResult> IndicatorScan::run(const std::vector<std::string>& symbols){
+    //sized up front, each task fills only its own slot
+    std::vector<SymbolResult> results(symbols.size());
+    ThreadPool::Batch batch(pool);
+    for(size_t i = 0; i < symbols.size(); i++){
+        results[i].symbol = symbols[i];
+        results[i].ok = false;
+        SymbolResult *result = &results[i];
+        batch.submit([this, result]{
+            try{
+                IndicatorSession session(result->symbol, intervalLength);
+                for(size_t j = 0; j < specs.size(); j++){
+                    session.add(specs[j]);
+                }
+                session.run();
+                Collect(session, *result);
+            }
+            catch(const std::exception& e){
+                result->error = e.what();
+            }
+        });
+    }
+    batch.wait();
+    return results;
+}
+
+std::vector<IndicatorScan::SymbolResult> IndicatorScan::run(const std::vector<GeneralInfo::BatchResultTS>& fetched){
+    std::vector<SymbolResult> results(fetched.size());
+    ThreadPool::Batch batch(pool);
+    for(size_t i = 0; i < fetched.size(); i++){
+        results[i].symbol = fetched[i].symbol;
+        results[i].ok = false;
+        if(!fetched[i].ok){
+            results[i].error = fetched[i].error;
+            continue;
+        }
+        SymbolResult *result = &results[i];
+        const BarStore *bars = &fetched[i].bars;
+        batch.submit([this, result, bars]{
+            try{
+                IndicatorSession session(result->symbol, intervalLength);
+                for(size_t j = 0; j < specs.size(); j++){
+                    session.add(specs[j]);
+                }
+                //the session reads the shared columns in place, no copy. 'fetched' outlives the batch, so the owner
+                //handle keeps nothing alive
+                std::shared_ptr<const void> unowned(bars, [](const void*){});
+                BarStore& window = *session.getData().valuesTS;
+                window.attach(unowned, bars->getTimeStamps().data(), bars->getOpens().data(), bars->getHighs().data(),
+                              bars->getLows().data(), bars->getCloses().data(), bars->getVolumes().data(), bars->size());
+                window.setHasTimeOfDay(bars->hasTimeOfDay());
+                session.computeAll();
+                Collect(session, *result);
+            }
+            catch(const std::exception& e){
+                result->error = e.what();
+            }
+        });
+    }
+    batch.wait();
+    return results;
+}
+
+void IndicatorScan::Collect(IndicatorSession& session, SymbolResult& result) const{
+    result.results.reserve(specs.size());
+    for(size_t j = 0; j < specs.size(); j++){
+        result.results.push_back(session.getResult(j));
+    }
+    result.ok = true;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef INDICATORSCAN_H
+#define INDICATORSCAN_H
+
+#include "IndicatorSession.h"
+#include "ThreadPool.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @brief The same indicators over many symbols, one IndicatorSession per symbol spread over a ThreadPool.
+///        Every task owns its session (its own Analytics and 'valuesTS') and writes only its own slot of the result,
+///        so the workers share no mutable state. Requests from all workers go through the thread-safe HttpClient, and
+///        indicator temporaries come from each worker's own ScratchArena rather than the shared heap.
+///
+///        ThreadPool pool;
+///        IndicatorScan scan("1day", pool);
+///        scan.add({IndicatorSession::ADOSC, 10, 3, 10});
+///        scan.add({IndicatorSession::SMA, 10, 20, 0, "close"});
+///        std::vector<IndicatorScan::SymbolResult> results = scan.run(symbols);
+class IndicatorScan{
+    public:
+        /// @brief outcome for one symbol. results[i] belongs to the i-th add() call
+        struct SymbolResult{
+            std::string symbol;
+            bool ok;            //false if fetching or computing failed
+            std::string error;  //reason when !ok
+            std::vector<std::vector<std::pair<std::string, double>>> results;
+        };
+
+        /// @param pool workers to run on. Not owned, must outlive run()
+        IndicatorScan(const std::string& intervalLength, ThreadPool& pool);
+
+        /// @brief queue an indicator for every symbol, see IndicatorSession::add. Throws std::invalid_argument on bad parameters
+        size_t add(const IndicatorSession::Spec& spec);
+        /// @brief bars fetched per symbol, see IndicatorSession::getWindowSize
+        int getWindowSize() const;
+
+        /// @brief fetch and compute every symbol, one task each. A failing symbol does not stop the others, check 'ok'.
+        ///        Waits for its own tasks only (ThreadPool::Batch), so a scan may run inside a task of the same pool
+        std::vector<SymbolResult> run(const std::vector<std::string>& symbols);
+        /// @brief compute on bars fetched beforehand (e.g. GeneralInfo::FetchValuesTSBatch with getWindowSize() bars).
+        ///        Every session reads its fetched store in place (BarStore::attach), concurrently, never copying or modifying it
+        std::vector<SymbolResult> run(const std::vector<GeneralInfo::BatchResultTS>& fetched);
+
+    private:
+        /// @brief copy the computed indicators of 'session' into 'result'
+        void Collect(IndicatorSession& session, SymbolResult& result) const;
+
+        std::string intervalLength;
+        ThreadPool& pool;
+        std::vector<IndicatorSession::Spec> specs;
+};
+
+#endif
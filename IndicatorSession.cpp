@@ -0,0 +1,138 @@
+#ifndef INDICATORSESSION_CPP
+#define INDICATORSESSION_CPP
+#include "IndicatorSession.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+IndicatorSession::IndicatorSession(const std::string& symbol, const std::string& intervalLength)
+    : symbol(symbol), intervalLength(intervalLength), graph(data) {}
+
+size_t IndicatorSession::add(const Spec& spec){
+    if(spec.intervalAmount <= 0){
+        throw std::invalid_argument("IndicatorSession.cpp @ add: 'intervalAmount' must be positive");
+    }
+    if((spec.indicator == ADOSC || spec.indicator == EMA || spec.indicator == SMA) && spec.period1 <= 0){
+        throw std::invalid_argument("IndicatorSession.cpp @ add: 'period1' must be positive");
+    }
+    if(spec.indicator == ADOSC && spec.period2 < spec.period1){
+        throw std::invalid_argument("IndicatorSession.cpp @ add: ADOSC long EMA ('period2') < short EMA ('period1')");
+    }
+    specs.push_back(spec);
+    return specs.size() - 1;
+}
+
+int IndicatorSession::Lookback(const Spec& spec){
+    switch(spec.indicator){
+        case CHAIKIN_AD:
+            return 0;
+        case ADOSC:
+            return Analytics::LookbackADOSC(spec.period2);
+        case TRUE_RANGE:
+            //previous close of the oldest output
+            return 1;
+        case EMA:
+        case SMA:
+            //seed of the oldest output averages 'period1' values
+            return spec.period1 - 1;
+    }
+    return 0;
+}
+
+int IndicatorSession::getWindowSize() const{
+    int window = 0;
+    for(size_t i = 0; i < specs.size(); i++){
+        window = std::max(window, specs[i].intervalAmount + Lookback(specs[i]));
+    }
+    return window;
+}
+
+void IndicatorSession::run(){
+    if(specs.empty()){
+        throw std::invalid_argument("IndicatorSession.cpp @ run: no indicators were added");
+    }
+    //the single request of the session
+    data.valuesTS->clear();
+    data.setValuesTS(symbol, intervalLength, std::to_string(getWindowSize()));
+    computeAll();
+}
+
+void IndicatorSession::computeAll(){
+    if(getWindowSize() > static_cast<int>(data.valuesTS->size())){
+        throw std::invalid_argument("IndicatorSession.cpp @ computeAll: the window is shorter than the indicators need");
+    }
+    //new bars, nothing computed before is valid
+    graph.invalidate();
+    results.assign(specs.size(), std::vector<std::pair<std::string, double>>());
+    errors.assign(specs.size(), std::string());
+    //every indicator over its own window, the newest intervalAmount + Lookback bars its Analytics call would fetch.
+    //Indicators with the same window are evaluated together and share their intermediates
+    std::vector<int> windows;
+    for(size_t i = 0; i < specs.size(); i++){
+        windows.push_back(specs[i].intervalAmount + Lookback(specs[i]));
+    }
+    std::vector<int> distinct(windows);
+    std::sort(distinct.begin(), distinct.end());
+    distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+    for(size_t w = 0; w < distinct.size(); w++){
+        graph.setWindow(distinct[w]);
+        for(size_t i = 0; i < specs.size(); i++){
+            if(windows[i] != distinct[w]){
+                continue;
+            }
+            //a failing indicator (e.g. a bar with high == low in its A/D window) fails alone
+            try{
+                const std::vector<double>& values = graph.evaluate(Node(specs[i]));
+                std::vector<std::pair<std::string, double>>& result = results[i];
+                result.reserve(specs[i].intervalAmount);
+                for(int j = 0; j < specs[i].intervalAmount; j++){
+                    result.push_back({data.getTimeStampTSAt(j), values[j]});
+                }
+            }
+            catch(const std::exception& e){
+                results[i].clear();
+                errors[i] = e.what();
+            }
+        }
+    }
+}
+
+const std::vector<std::pair<std::string, double>>& IndicatorSession::getResult(size_t index) const{
+    if(index >= results.size()){
+        throw std::out_of_range("IndicatorSession.cpp @ getResult: no result for 'index', was run() called?");
+    }
+    if(!errors[index].empty()){
+        throw std::runtime_error("IndicatorSession.cpp @ getResult: indicator " + std::to_string(index) + " failed: " + errors[index]);
+    }
+    return results[index];
+}
+
+const std::string& IndicatorSession::getError(size_t index) const{
+    if(index >= errors.size()){
+        throw std::out_of_range("IndicatorSession.cpp @ getError: no result for 'index', was run() called?");
+    }
+    return errors[index];
+}
+
+Analytics& IndicatorSession::getData(){
+    return data;
+}
+
+IndicatorGraph::NodeId IndicatorSession::Node(const Spec& spec){
+    switch(spec.indicator){
+        case CHAIKIN_AD:
+            return graph.accumDistr();
+        case ADOSC:
+            return graph.adosc(spec.period1, spec.period2);
+        case TRUE_RANGE:
+            return graph.trueRange();
+        case EMA:
+            return graph.ema(graph.column(spec.typeOfData.empty() ? "close" : spec.typeOfData), spec.period1);
+        case SMA:
+            return graph.sma(graph.column(spec.typeOfData.empty() ? "close" : spec.typeOfData), spec.period1);
+    }
+    throw std::invalid_argument("IndicatorSession.cpp @ Node: unknown indicator");
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef INDICATORSESSION_H
+#define INDICATORSESSION_H
+
+#include "Analytics.h"
+#include "IndicatorGraph.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+/// @brief Fetch once, compute many. A session collects the indicators wanted for one symbol/interval, works out
+///        how many bars the longest of them needs (its output count plus its lookback padding), fetches that
+///        window with a single request and computes every indicator on it.
+///        Each indicator is evaluated over its own window, the newest intervalAmount + Lookback bars, which are the bars
+///        its per-indicator Analytics call fetches. Its result is therefore bit for bit that call's (ChaikinAD, ADOSC,
+///        TrueRange, Exponential/SimpleMovingAverage of the column), whatever else the session holds. Indicators with
+///        the same window go through one IndicatorGraph evaluation and share intermediates (the A/D line, EMA(close, 12),
+///        true range...). An indicator that cannot be computed, e.g. over a bar with high == low in its A/D window,
+///        fails alone, see getResult/getError.
+///
+///        IndicatorSession session("AAPL", "5min");
+///        size_t ad = session.add({IndicatorSession::CHAIKIN_AD, 10});
+///        size_t osc = session.add({IndicatorSession::ADOSC, 10, 3, 10});
+///        session.run();
+///        session.getResult(osc);
+class IndicatorSession{
+    public:
+        enum Indicator{
+            CHAIKIN_AD,  //no parameters
+            ADOSC,       //period1 = short EMA, period2 = long EMA
+            TRUE_RANGE,  //no parameters
+            EMA,         //period1 = time period, typeOfData = {open, high, low, close}
+            SMA          //period1 = time period, typeOfData = {open, high, low, close}
+        };
+
+        /// @brief one indicator to compute
+        struct Spec{
+            Indicator indicator;
+            int intervalAmount;     //number of output values, newest first
+            int period1;
+            int period2;
+            std::string typeOfData;
+        };
+
+        IndicatorSession(const std::string& symbol, const std::string& intervalLength);
+
+        /// @brief queue an indicator. Throws std::invalid_argument on bad parameters
+        /// @return index of its result for getResult()
+        size_t add(const Spec& spec);
+
+        /// @brief bars an indicator needs besides its 'intervalAmount' outputs
+        static int Lookback(const Spec& spec);
+        /// @brief bars the session fetches: the largest intervalAmount + Lookback over all queued indicators
+        int getWindowSize() const;
+
+        /// @brief fetch the window (one request) and compute every queued indicator on it
+        void run();
+        /// @brief compute every queued indicator on bars already in getData().valuesTS, without fetching
+        void computeAll();
+
+        /// @brief output of the indicator added as 'index', in the form <date,value.....date,value>, newest first.
+        ///        Throws std::runtime_error with the reason if that indicator failed
+        const std::vector<std::pair<std::string, double>>& getResult(size_t index) const;
+        /// @brief why the indicator added as 'index' failed, empty if it did not
+        const std::string& getError(size_t index) const;
+
+        /// @brief the fetched window and the Analytics object the indicators run on
+        Analytics& getData();
+
+    private:
+        /// @brief graph node computing 'spec'
+        IndicatorGraph::NodeId Node(const Spec& spec);
+
+        std::string symbol;
+        std::string intervalLength;
+        std::vector<Spec> specs;
+        std::vector<std::vector<std::pair<std::string, double>>> results;
+        std::vector<std::string> errors;    //per indicator, empty when it was computed
+        Analytics data;
+        IndicatorGraph graph;
+};
+
+#endif
@@ -0,0 +1,355 @@
+#ifndef METRICS_CPP
+#define METRICS_CPP
+#include "Metrics.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <unistd.h>
+
+std::atomic<bool> Metrics::enabled(false);
+std::atomic<double> Metrics::nanosecondsPerTick(1.0);
+
+//exact buckets for 0-32 ns, then 16 per power of two above. A bucket holds (low, high], the way a Prometheus 'le'
+//bucket does, so every power of two is the highest value of a bucket
+static const size_t EXACT_BUCKETS = 33;
+static const int SUB_BUCKET_BITS = 4;
+static const size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+static const size_t BUCKETS = EXACT_BUCKETS + (64 - 5) * SUB_BUCKETS;
+
+static size_t BucketOf(uint64_t nanoseconds){
+    if(nanoseconds < EXACT_BUCKETS){
+        return static_cast<size_t>(nanoseconds);
+    }
+    uint64_t below = nanoseconds - 1;
+    int exponent = 63 - __builtin_clzll(below);
+    size_t subBucket = static_cast<size_t>(below >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return EXACT_BUCKETS + (exponent - 5) * SUB_BUCKETS + subBucket;
+}
+
+//highest value that falls into 'bucket'
+static uint64_t BucketHigh(size_t bucket){
+    if(bucket < EXACT_BUCKETS){
+        return bucket;
+    }
+    int exponent = static_cast<int>((bucket - EXACT_BUCKETS) / SUB_BUCKETS) + 5;
+    uint64_t subBucket = (bucket - EXACT_BUCKETS) % SUB_BUCKETS;
+    uint64_t width = 1ULL << (exponent - SUB_BUCKET_BITS);
+    return ((SUB_BUCKETS + subBucket) << (exponent - SUB_BUCKET_BITS)) + width;
+}
+
+//one stage's samples from one thread. Only that thread writes, so a plain load and store add a sample
+//(atomic only so the exporter may read at the same time)
+struct Histogram{
+    std::atomic<uint64_t> counts[BUCKETS];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+
+    Histogram(){
+        clear();
+    }
+    void clear(){
+        for(size_t i = 0; i < BUCKETS; i++){
+            counts[i].store(0, std::memory_order_relaxed);
+        }
+        count.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+    }
+    void add(uint64_t nanoseconds){
+        std::atomic<uint64_t>& bucket = counts[BucketOf(nanoseconds)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum.store(sum.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+        if(nanoseconds > max.load(std::memory_order_relaxed)){
+            max.store(nanoseconds, std::memory_order_relaxed);
+        }
+    }
+};
+
+//histograms of one thread, made on the first sample of each stage. A block is handed to the next new thread
+//when its thread exits, so threads coming and going do not pile up blocks (the samples stay counted)
+struct ThreadBlock{
+    std::atomic<Histogram*> stages[Metrics::MAX_STAGES];
+    std::atomic<bool> inUse;
+};
+
+struct Registry{
+    std::mutex lock;    //guards names and blocks; never taken while recording, only on a thread's first sample
+    std::vector<std::string> names;
+    std::vector<ThreadBlock*> blocks;
+};
+
+static Registry& GetRegistry(){
+    //never destroyed: threads still recording during static destruction may reach it
+    static Registry *registry = new Registry();
+    return *registry;
+}
+
+//gives the block back when the thread exits
+struct BlockLease{
+    ThreadBlock *block;
+    BlockLease() : block(nullptr) {}
+    ~BlockLease(){
+        if(block != nullptr){
+            block->inUse.store(false, std::memory_order_release);
+        }
+    }
+};
+
+static thread_local BlockLease lease;
+
+static ThreadBlock *AcquireBlock(){
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    for(size_t i = 0; i < registry.blocks.size(); i++){
+        bool free = false;
+        if(registry.blocks[i]->inUse.compare_exchange_strong(free, true, std::memory_order_acquire)){
+            lease.block = registry.blocks[i];
+            return lease.block;
+        }
+    }
+    ThreadBlock *block = new ThreadBlock();
+    for(size_t i = 0; i < Metrics::MAX_STAGES; i++){
+        block->stages[i].store(nullptr, std::memory_order_relaxed);
+    }
+    block->inUse.store(true, std::memory_order_relaxed);
+    registry.blocks.push_back(block);
+    lease.block = block;
+    return block;
+}
+
+Metrics::Stage Metrics::Register(const std::string& name){
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    for(size_t i = 0; i < registry.names.size(); i++){
+        if(registry.names[i] == name){
+            return i;
+        }
+    }
+    if(registry.names.size() >= MAX_STAGES){
+        throw std::runtime_error("Metrics.cpp @ Register: more than MAX_STAGES stages registered");
+    }
+    registry.names.push_back(name);
+    return registry.names.size() - 1;
+}
+
+void Metrics::SetEnabled(bool value){
+#ifdef METRICS_USE_TSC
+    //ticks against the steady clock over 2 ms: the clock reads at both ends are off by well under 1 us, so the rate is
+    //good to about 1e-4. The rate is set before recording starts, spans never see an uncalibrated one
+    static std::once_flag calibrated;
+    if(value){
+        std::call_once(calibrated, []{
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            uint64_t startTicks = Ticks();
+            std::chrono::steady_clock::time_point end;
+            do{
+                end = std::chrono::steady_clock::now();
+            }while(end - start < std::chrono::milliseconds(2));
+            uint64_t ticks = Ticks() - startTicks;
+            double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+            nanosecondsPerTick.store(ticks > 0 ? nanoseconds / ticks : 1.0, std::memory_order_relaxed);
+        });
+    }
+#endif
+    enabled.store(value, std::memory_order_release);
+}
+
+void Metrics::Record(Stage stage, uint64_t nanoseconds){
+    if(!IsEnabled() || stage >= MAX_STAGES){
+        return;
+    }
+    ThreadBlock *block = lease.block != nullptr ? lease.block : AcquireBlock();
+    Histogram *histogram = block->stages[stage].load(std::memory_order_relaxed);
+    if(histogram == nullptr){
+        histogram = new Histogram();
+        block->stages[stage].store(histogram, std::memory_order_release);
+    }
+    histogram->add(nanoseconds);
+}
+
+std::vector<Metrics::Summary> Metrics::Snapshot(){
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    std::vector<Summary> summaries;
+    std::vector<uint64_t> counts(BUCKETS);
+    for(size_t stage = 0; stage < registry.names.size(); stage++){
+        std::fill(counts.begin(), counts.end(), 0);
+        uint64_t count = 0, sum = 0, max = 0;
+        for(size_t i = 0; i < registry.blocks.size(); i++){
+            Histogram *histogram = registry.blocks[i]->stages[stage].load(std::memory_order_acquire);
+            if(histogram == nullptr){
+                continue;
+            }
+            for(size_t bucket = 0; bucket < BUCKETS; bucket++){
+                counts[bucket] += histogram->counts[bucket].load(std::memory_order_relaxed);
+            }
+            count += histogram->count.load(std::memory_order_relaxed);
+            sum += histogram->sum.load(std::memory_order_relaxed);
+            max = std::max(max, histogram->max.load(std::memory_order_relaxed));
+        }
+        if(count == 0){
+            continue;
+        }
+        Summary summary;
+        summary.stage = registry.names[stage];
+        summary.count = count;
+        summary.sum = sum * 1e-9;
+        summary.max = max * 1e-9;
+        //the count is read after the buckets, so it may be a concurrent sample ahead of them. Quantiles rank against the buckets
+        uint64_t total = 0;
+        for(size_t bucket = 0; bucket < BUCKETS; bucket++){
+            if(counts[bucket] > 0){
+                summary.buckets.push_back(std::make_pair(BucketHigh(bucket), counts[bucket]));
+                total += counts[bucket];
+            }
+        }
+        const double quantiles[4] = {0.5, 0.9, 0.99, 0.999};
+        double *targets[4] = {&summary.p50, &summary.p90, &summary.p99, &summary.p999};
+        for(int q = 0; q < 4; q++){
+            uint64_t rank = static_cast<uint64_t>(quantiles[q] * total + 0.5);
+            rank = rank == 0 ? 1 : rank;
+            uint64_t seen = 0;
+            uint64_t value = max;
+            for(size_t i = 0; i < summary.buckets.size(); i++){
+                seen += summary.buckets[i].second;
+                if(seen >= rank){
+                    value = std::min(summary.buckets[i].first, max);
+                    break;
+                }
+            }
+            *targets[q] = value * 1e-9;
+        }
+        summaries.push_back(summary);
+    }
+    return summaries;
+}
+
+//seconds with up to 9 decimals (whole nanoseconds, which is what every value is made of), trailing zeros dropped
+static std::string FormatNumber(double value){
+    char buffer[40];
+    std::snprintf(buffer, sizeof(buffer), "%.9f", value);
+    std::string text(buffer);
+    text.erase(text.find_last_not_of('0') + 1);
+    if(text[text.size() - 1] == '.'){
+        text.erase(text.size() - 1);
+    }
+    return text;
+}
+
+//stage names are code identifiers, but escape anyway so the output always parses
+static std::string Escape(const std::string& text){
+    std::string escaped;
+    for(size_t i = 0; i < text.size(); i++){
+        if(text[i] == '"' || text[i] == '\\'){
+            escaped += '\\';
+        }
+        escaped += text[i] == '\n' ? ' ' : text[i];
+    }
+    return escaped;
+}
+
+//Prometheus buckets: 2^10 ns (~1us) to 2^36 ns (~69s). Powers of two are the upper bounds of histogram buckets, so
+//the counts are exact
+static const int FIRST_POWER = 10;
+static const int LAST_POWER = 36;
+
+std::string Metrics::PrometheusText(){
+    std::vector<Summary> summaries = Snapshot();
+    std::string out;
+    out += "# HELP marketdata_stage_latency_seconds Latency of one pipeline stage or indicator kernel call.\n";
+    out += "# TYPE marketdata_stage_latency_seconds histogram\n";
+    for(size_t s = 0; s < summaries.size(); s++){
+        const Summary& summary = summaries[s];
+        std::string label = "stage=\"" + Escape(summary.stage) + "\"";
+        uint64_t cumulative = 0;
+        size_t next = 0;
+        for(int power = FIRST_POWER; power <= LAST_POWER; power++){
+            uint64_t edge = 1ULL << power;
+            while(next < summary.buckets.size() && summary.buckets[next].first <= edge){
+                cumulative += summary.buckets[next++].second;
+            }
+            out += "marketdata_stage_latency_seconds_bucket{" + label + ",le=\"" + FormatNumber(edge * 1e-9) + "\"} "
+                   + std::to_string(cumulative) + "\n";
+        }
+        while(next < summary.buckets.size()){
+            cumulative += summary.buckets[next++].second;
+        }
+        out += "marketdata_stage_latency_seconds_bucket{" + label + ",le=\"+Inf\"} " + std::to_string(cumulative) + "\n";
+        out += "marketdata_stage_latency_seconds_sum{" + label + "} " + FormatNumber(summary.sum) + "\n";
+        out += "marketdata_stage_latency_seconds_count{" + label + "} " + std::to_string(cumulative) + "\n";
+    }
+    out += "# HELP marketdata_stage_latency_quantile_seconds Latency quantiles since start (or the last reset), 6.25% resolution.\n";
+    out += "# TYPE marketdata_stage_latency_quantile_seconds gauge\n";
+    for(size_t s = 0; s < summaries.size(); s++){
+        const Summary& summary = summaries[s];
+        std::string label = "stage=\"" + Escape(summary.stage) + "\"";
+        const char *names[5] = {"0.5", "0.9", "0.99", "0.999", "1"};
+        const double values[5] = {summary.p50, summary.p90, summary.p99, summary.p999, summary.max};
+        for(int q = 0; q < 5; q++){
+            out += "marketdata_stage_latency_quantile_seconds{" + label + ",quantile=\"" + names[q] + "\"} "
+                   + FormatNumber(values[q]) + "\n";
+        }
+    }
+    return out;
+}
+
+std::string Metrics::JSON(){
+    std::vector<Summary> summaries = Snapshot();
+    std::string out = "{\"stages\":[";
+    for(size_t s = 0; s < summaries.size(); s++){
+        const Summary& summary = summaries[s];
+        out += s == 0 ? "{" : ",{";
+        out += "\"stage\":\"" + Escape(summary.stage) + "\",\"count\":" + std::to_string(summary.count)
+               + ",\"sum_seconds\":" + FormatNumber(summary.sum) + ",\"p50\":" + FormatNumber(summary.p50)
+               + ",\"p90\":" + FormatNumber(summary.p90) + ",\"p99\":" + FormatNumber(summary.p99)
+               + ",\"p999\":" + FormatNumber(summary.p999) + ",\"max\":" + FormatNumber(summary.max) + ",\"buckets\":[";
+        for(size_t i = 0; i < summary.buckets.size(); i++){
+            out += (i == 0 ? "[" : ",[") + std::to_string(summary.buckets[i].first) + "," + std::to_string(summary.buckets[i].second) + "]";
+        }
+        out += "]}";
+    }
+    return out + "]}\n";
+}
+
+static std::atomic<unsigned long> tempSequence(0);
+
+static void WriteAtomically(const std::string& fileName, const std::string& text, const char *function){
+    std::string tempName = fileName + ".tmp" + std::to_string(static_cast<long>(getpid())) + "_" + std::to_string(tempSequence++);
+    FILE *fp = fopen(tempName.c_str(), "wb");
+    if(fp == NULL){
+        throw std::runtime_error(std::string("Metrics.cpp @ ") + function + ": failed to open " + tempName + " for writing");
+    }
+    bool written = fwrite(text.data(), 1, text.size(), fp) == text.size();
+    written = (fclose(fp) == 0) && written;
+    if(!written || std::rename(tempName.c_str(), fileName.c_str()) != 0){
+        std::remove(tempName.c_str());
+        throw std::runtime_error(std::string("Metrics.cpp @ ") + function + ": failed to write " + fileName);
+    }
+}
+
+void Metrics::WritePrometheus(const std::string& fileName){
+    WriteAtomically(fileName, PrometheusText(), "WritePrometheus");
+}
+
+void Metrics::WriteJSON(const std::string& fileName){
+    WriteAtomically(fileName, JSON(), "WriteJSON");
+}
+
+void Metrics::Reset(){
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+    for(size_t i = 0; i < registry.blocks.size(); i++){
+        for(size_t stage = 0; stage < MAX_STAGES; stage++){
+            Histogram *histogram = registry.blocks[i]->stages[stage].load(std::memory_order_acquire);
+            if(histogram != nullptr){
+                histogram->clear();
+            }
+        }
+    }
+}
+
+#endif
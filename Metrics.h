@@ -0,0 +1,119 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define METRICS_USE_TSC 1
+#endif
+
+/// @brief Latency histograms per pipeline stage (http transfer, parse, cache load, every indicator kernel...),
+///        cheap enough to leave on in production. Off by default, see SetEnabled.
+///
+///        A span reads the time stamp counter at its start and end (rdtsc on x86, about half the cost of a steady clock
+///        read; the steady clock elsewhere) and adds the duration to a histogram of the calling thread: each thread
+///        records into histograms of its own, with plain loads and stores, no lock and no read-modify-write instruction.
+///        Exporting sums the histograms of all threads.
+///        Buckets are HDR style, log-linear: exact up to 32 ns, then 16 buckets per power of two (6.25% resolution)
+///        up to the full 64 bit range, so the tail keeps its shape at any magnitude. A bucket includes its upper bound,
+///        as a Prometheus 'le' bucket does.
+///
+///        static const Metrics::Stage STAGE = Metrics::Register("ChaikinAD");
+///        Metrics::Span span(STAGE);   //records the rest of the scope
+///        ...
+///        Metrics::WritePrometheus("/var/lib/node_exporter/textfile/marketdata.prom");
+class Metrics{
+    public:
+        typedef size_t Stage;
+
+        /// @brief most stages one process can register
+        static const size_t MAX_STAGES = 128;
+
+        /// @brief id of the stage called 'name', registering it on first use (the same name always gives the same id).
+        ///        Takes a lock, so look ids up once (e.g. into a static) and not per span.
+        ///        Throws std::runtime_error when MAX_STAGES stages exist already
+        static Stage Register(const std::string& name);
+
+        /// @brief turn recording on or off for every thread. While off a span costs one relaxed atomic load.
+        ///        The first call turning it on measures the counter's rate against the steady clock, which takes 2 ms
+        static void SetEnabled(bool enabled);
+        static bool IsEnabled();
+
+        /// @brief add one sample of 'nanoseconds' to 'stage', for durations measured elsewhere (e.g. by curl)
+        static void Record(Stage stage, uint64_t nanoseconds);
+
+        /// @brief the counter spans read: TSC ticks on x86 (invariant on every CPU of the last 15 years), steady clock
+        ///        nanoseconds elsewhere. Only differences mean anything, see ToNanoseconds
+        static uint64_t Ticks(){
+#ifdef METRICS_USE_TSC
+            return __rdtsc();
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+        /// @brief a difference of Ticks() in nanoseconds. Only calibrated once recording was enabled
+        static uint64_t ToNanoseconds(uint64_t ticks){
+            return static_cast<uint64_t>(ticks * nanosecondsPerTick.load(std::memory_order_relaxed));
+        }
+
+        /// @brief records the time from construction to destruction into 'stage'
+        class Span{
+            public:
+                explicit Span(Stage stage) : stage(stage), start(IsEnabled() ? Ticks() : 0) {}
+                ~Span(){
+                    if(start != 0){
+                        Record(stage, ToNanoseconds(Ticks() - start));
+                    }
+                }
+
+            private:
+                Span(const Span&);
+                Span& operator=(const Span&);
+
+                Stage stage;
+                uint64_t start;     //0 when recording was off at construction
+        };
+
+        /// @brief one stage's histogram summed over all threads. Latencies in seconds
+        struct Summary{
+            std::string stage;
+            uint64_t count;
+            double sum;
+            double p50, p90, p99, p999;     //upper bound of the bucket holding the quantile, at most max
+            double max;
+            std::vector<std::pair<uint64_t, uint64_t>> buckets;     //(highest nanoseconds of the bucket, samples) of the non empty buckets, ascending
+        };
+        /// @brief every stage with at least one sample. Reads while other threads record, so a concurrent sample
+        ///        may be seen in the count but not yet in its bucket
+        static std::vector<Summary> Snapshot();
+
+        /// @brief Prometheus text exposition format: histogram marketdata_stage_latency_seconds{stage="..."}
+        ///        (power of two buckets from ~1us to ~69s) and gauge marketdata_stage_latency_quantile_seconds{stage,quantile}
+        static std::string PrometheusText();
+        /// @brief {"stages":[{"stage":...,"count":...,"sum_seconds":...,"p50":...,"p90":...,"p99":...,"p999":...,"max":...,
+        ///        "buckets":[[nanoseconds,samples],...]},...]}
+        static std::string JSON();
+        /// @brief write PrometheusText()/JSON() to 'fileName' through a temp file and a rename, so a scraper (e.g. the
+        ///        node_exporter textfile collector) never reads half a file. Throws std::runtime_error if it cannot be written
+        static void WritePrometheus(const std::string& fileName);
+        static void WriteJSON(const std::string& fileName);
+
+        /// @brief zero every histogram, the stages stay registered. Samples recorded meanwhile may survive
+        static void Reset();
+
+    private:
+        static std::atomic<bool> enabled;
+        static std::atomic<double> nanosecondsPerTick;
+};
+
+inline bool Metrics::IsEnabled(){
+    return enabled.load(std::memory_order_relaxed);
+}
+
+#endif
@@ -1,40 +1,457 @@
 #ifndef PARSE_CPP
 #define PARSE_CPP
 #include "Parse.h"
+#include "TimeSeriesParser.h"
+#include "EpochTime.h"
 
 #include <curl/curl.h>
 #include <json-c/json.h>
 #include <string>
 #include <iostream>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
 
 size_t Parse::WriteCallBack(void *contents, size_t size, size_t nmemb, void *userp){
     ((std::string*)userp)->append((char*)contents, size * nmemb);
     return size * nmemb;
 }
 
+size_t Parse::StreamCallBack(void *contents, size_t size, size_t nmemb, void *userp){
+    ((TimeSeriesParser*)userp)->feed((const char*)contents, size * nmemb);
+    return size * nmemb;
+}
+
+
+std::atomic<bool> Parse::debugDump(false);
+std::atomic<unsigned long> Parse::dumpSequence(0);
+
+std::string Parse::WriteToJSON(const std::string& readBuffer, const std::string& fileName){
+    // pid and a process wide counter: no other request, thread or process writes this name
+    std::string name = fileName;
+    if (name.empty()) {
+        name = "response_" + std::to_string(static_cast<long>(getpid())) + "_" + std::to_string(dumpSequence++) + ".json";
+    }
+    // Write the raw response to file, no need to parse and reserialize it
+    FILE *fp = fopen(name.c_str(), "w");
+    if (fp != NULL) {
+        fwrite(readBuffer.data(), 1, readBuffer.size(), fp);
+        fclose(fp);
+    }
+    return name;
+}
+
+void Parse::SetDebugDump(bool enabled){
+    debugDump = enabled;
+}
+
+bool Parse::DebugDumpEnabled(){
+    return debugDump;
+}
+
+//Output file for the CSV export: rows are formatted into 'buffer' and it goes to the file in large write() calls
+class CsvOutput{
+    public:
+        explicit CsvOutput(const std::string& fileName) : fileName(fileName), buffer(BUFFER_SIZE), used(0){
+            fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                throw std::runtime_error("Parse.cpp @ WriteToCSV: failed to open " + fileName + " for writing");
+            }
+        }
+        ~CsvOutput(){
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
 
-void Parse::WriteToJSON(std::string readBuffer){
-    json_object *parsed_json = json_tokener_parse(readBuffer.c_str()); // Parse the response data as JSON
+        //room for 'bytes' more chars, flushing first if the buffer is too full
+        char *reserve(size_t bytes){
+            if (used + bytes > buffer.size()) {
+                flush();
+            }
+            return buffer.data() + used;
+        }
+        void commit(char *end){
+            used = end - buffer.data();
+        }
+        void text(const std::string& value){
+            if (value.size() > buffer.size()) {
+                flush();
+                Write(value.data(), value.size());
+                return;
+            }
+            char *out = reserve(value.size());
+            std::memcpy(out, value.data(), value.size());
+            commit(out + value.size());
+        }
+        void flush(){
+            Write(buffer.data(), used);
+            used = 0;
+        }
+        void close(){
+            flush();
+            int result = ::close(fd);
+            fd = -1;
+            if (result != 0) {
+                throw std::runtime_error("Parse.cpp @ WriteToCSV: failed to write " + fileName);
+            }
+        }
+
+        //longest row piece reserved at once: a datetime or a number plus its delimiter
+        static const size_t FIELD_SIZE = 32;
+
+    private:
+        static const size_t BUFFER_SIZE = 1 << 20;
 
-        // Write parsed JSON to file
-        FILE *fp = fopen("response.json", "w");
-        if (fp != NULL) {
-            fputs(json_object_to_json_string(parsed_json), fp);
-            fclose(fp);
+        void Write(const char *data, size_t size){
+            while (size > 0) {
+                ssize_t written = ::write(fd, data, size);
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (written <= 0) {
+                    throw std::runtime_error("Parse.cpp @ WriteToCSV: failed to write " + fileName);
+                }
+                data += written;
+                size -= written;
+            }
         }
 
-        // Clean up JSON object
-        json_object_put(parsed_json);
-    
+        std::string fileName;
+        std::vector<char> buffer;
+        size_t used;
+        int fd;
+};
+
+void Parse::WriteToCSV(const std::string& fileName, const BarStore& bars, char delimiter){
+    CsvOutput output(fileName);
+    const char names[][9] = {"datetime", "open", "high", "low", "close", "volume"};
+    for (size_t i = 0; i < 6; i++) {
+        output.text(names[i]);
+        output.text(std::string(1, i == 5 ? '\n' : delimiter));
+    }
+    ColumnView<int64_t> timeStamps = bars.getTimeStamps(), volumes = bars.getVolumes();
+    ColumnView<double> opens = bars.getOpens(), highs = bars.getHighs(), lows = bars.getLows(), closes = bars.getCloses();
+    for (size_t i = 0; i < bars.size(); i++) {
+        char *out = output.reserve(6 * CsvOutput::FIELD_SIZE);
+        out = EpochTime::Format(timeStamps[i], bars.hasTimeOfDay(), out);
+        *out++ = delimiter;
+        out = FormatDouble(opens[i], out);
+        *out++ = delimiter;
+        out = FormatDouble(highs[i], out);
+        *out++ = delimiter;
+        out = FormatDouble(lows[i], out);
+        *out++ = delimiter;
+        out = FormatDouble(closes[i], out);
+        *out++ = delimiter;
+        out = FormatInteger(volumes[i], out);
+        *out++ = '\n';
+        output.commit(out);
+    }
+    output.close();
+}
+
+void Parse::WriteToCSV(const std::string& fileName, const std::vector<std::pair<std::string, double>>& values,
+                       const std::string& valueName, char delimiter){
+    CsvOutput output(fileName);
+    output.text("datetime" + std::string(1, delimiter) + valueName + "\n");
+    for (size_t i = 0; i < values.size(); i++) {
+        output.text(values[i].first);
+        char *out = output.reserve(CsvOutput::FIELD_SIZE);
+        *out++ = delimiter;
+        out = FormatDouble(values[i].second, out);
+        *out++ = '\n';
+        output.commit(out);
+    }
+    output.close();
 }
 
-void Parse::WriteToCSV(void *contents, std::string readBuffer){}
+void Parse::WriteToCSV(const std::string& fileName, ColumnView<int64_t> timeStamps, bool timeOfDay,
+                       const std::vector<std::string>& names, const std::vector<const double*>& columns, char delimiter){
+    if (names.size() != columns.size()) {
+        throw std::invalid_argument("Parse.cpp @ WriteToCSV: every column needs a name");
+    }
+    CsvOutput output(fileName);
+    output.text("datetime");
+    for (size_t j = 0; j < names.size(); j++) {
+        output.text(std::string(1, delimiter) + names[j]);
+    }
+    output.text("\n");
+    for (size_t i = 0; i < timeStamps.size(); i++) {
+        char *out = output.reserve((columns.size() + 1) * CsvOutput::FIELD_SIZE);
+        out = EpochTime::Format(timeStamps[i], timeOfDay, out);
+        for (size_t j = 0; j < columns.size(); j++) {
+            *out++ = delimiter;
+            out = FormatDouble(columns[j][i], out);
+        }
+        *out++ = '\n';
+        output.commit(out);
+    }
+    output.close();
+}
 
-//Time series only. Data parsing. DELETE THESE TWO?
-void Parse::ParseTSMetaToArr(std::string readBuffer){}
-void Parse::ParseTSValuesToVec(std::string readBuffer){}
+//FormatDouble generates the digits with Grisu2 (Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+//with Integers"): 64 bit integer arithmetic against a table of cached powers of ten, no big numbers and no printf.
+//The digits always read back to the same double and are the shortest ones for all but a tiny fraction of values
 
+//64 bit significand f and binary exponent e, the value is f * 2^e
+struct DiyFp{
+    uint64_t f;
+    int e;
+};
 
+static DiyFp Multiply(const DiyFp& a, const DiyFp& b){
+    //upper 64 bits of the 128 bit product, rounded
+    unsigned __int128 product = static_cast<unsigned __int128>(a.f) * b.f;
+    uint64_t high = static_cast<uint64_t>(product >> 64);
+    if (static_cast<uint64_t>(product) & (1ULL << 63)) {
+        high++;
+    }
+    DiyFp result = {high, a.e + b.e + 64};
+    return result;
+}
 
+static DiyFp Normalize(DiyFp value){
+    int shift = __builtin_clzll(value.f);
+    value.f <<= shift;
+    value.e -= shift;
+    return value;
+}
+
+//10^(-348 + 8 i), normalized: significands and binary exponents
+static const uint64_t CACHED_POWERS_F[] = {
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL, 0xcf42894a5dce35eaULL,
+    0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL, 0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL,
+    0xbe5691ef416bd60cULL, 0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL, 0xc21094364dfb5637ULL,
+    0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL, 0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL,
+    0xb23867fb2a35b28eULL, 0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL, 0xb5b5ada8aaff80b8ULL,
+    0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL, 0x964e858c91ba2655ULL, 0xdff9772470297ebdULL,
+    0xa6dfbd9fb8e5b88fULL, 0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL, 0xaa242499697392d3ULL,
+    0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL, 0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL,
+    0x9c40000000000000ULL, 0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL, 0x9f4f2726179a2245ULL,
+    0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL, 0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL,
+    0x924d692ca61be758ULL, 0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL, 0x952ab45cfa97a0b3ULL,
+    0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL, 0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL,
+    0x88fcf317f22241e2ULL, 0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL, 0x8bab8eefb6409c1aULL,
+    0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL, 0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL,
+    0x80444b5e7aa7cf85ULL, 0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+static const int16_t CACHED_POWERS_E[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927, -901, -874, -847, -821,
+    -794, -768, -741, -715, -688, -661, -635, -608, -582, -555, -529, -502, -475, -449, -422, -396,
+    -369, -343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348, 375, 402, 428, 455,
+    481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+static const uint64_t POWERS_OF_TEN[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+    10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+//cached power c with 'e' + c.e in [-60, -32], so the scaled value's integer part fits 32 bits. Sets K with c ~ 10^-K
+static DiyFp CachedPower(int e, int& K){
+    double estimate = (-61 - e) * 0.30102999566398114 + 347;
+    int k = static_cast<int>(estimate);
+    if (estimate - k > 0.0) {
+        k++;
+    }
+    unsigned index = static_cast<unsigned>((k >> 3) + 1);
+    K = -(-348 + static_cast<int>(index) * 8);
+    DiyFp power = {CACHED_POWERS_F[index], CACHED_POWERS_E[index]};
+    return power;
+}
+
+//nudge the last digit down while that brings it closer to the exact value and stays inside the rounding interval
+static void GrisuRound(char *digits, int length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t distance){
+    while (rest < distance && delta - rest >= tenKappa && (rest + tenKappa < distance || distance - rest > rest + tenKappa - distance)) {
+        digits[length - 1]--;
+        rest += tenKappa;
+    }
+}
+
+static int CountDigits(uint32_t value){
+    int count = 1;
+    while (count < 10 && value >= POWERS_OF_TEN[count]) {
+        count++;
+    }
+    return count;
+}
+
+//digits of 'upper' until they identify a number inside the interval (upper - delta, upper]
+static void DigitGen(const DiyFp& scaled, const DiyFp& upper, uint64_t delta, char *digits, int& length, int& K){
+    int shift = -upper.e;
+    uint64_t one = 1ULL << shift;
+    uint64_t distance = upper.f - scaled.f;
+    uint32_t integral = static_cast<uint32_t>(upper.f >> shift);
+    uint64_t fraction = upper.f & (one - 1);
+    int kappa = CountDigits(integral);
+    length = 0;
+    while (kappa > 0) {
+        uint32_t divisor = static_cast<uint32_t>(POWERS_OF_TEN[kappa - 1]);
+        uint32_t digit = integral / divisor;
+        integral %= divisor;
+        if (digit || length) {
+            digits[length++] = static_cast<char>('0' + digit);
+        }
+        kappa--;
+        uint64_t rest = (static_cast<uint64_t>(integral) << shift) + fraction;
+        if (rest <= delta) {
+            K += kappa;
+            GrisuRound(digits, length, delta, rest, POWERS_OF_TEN[kappa] << shift, distance);
+            return;
+        }
+    }
+    while (true) {
+        fraction *= 10;
+        delta *= 10;
+        char digit = static_cast<char>(fraction >> shift);
+        if (digit || length) {
+            digits[length++] = static_cast<char>('0' + digit);
+        }
+        fraction &= one - 1;
+        kappa--;
+        if (fraction < delta) {
+            K += kappa;
+            GrisuRound(digits, length, delta, fraction, one, -kappa < 20 ? distance * POWERS_OF_TEN[-kappa] : 0);
+            return;
+        }
+    }
+}
+
+//shortest digits of a positive finite 'value': value ~ digits * 10^K
+static void Grisu2(double value, char *digits, int& length, int& K){
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    int biasedExponent = static_cast<int>((bits >> 52) & 0x7FF);
+    DiyFp v;
+    v.f = bits & ((1ULL << 52) - 1);
+    if (biasedExponent != 0) {
+        v.f += 1ULL << 52;
+        v.e = biasedExponent - 1075;
+    }
+    else {
+        v.e = -1074;
+    }
+    //boundaries halfway to the neighbouring doubles, closer below a power of two
+    DiyFp plus = {(v.f << 1) + 1, v.e - 1};
+    plus = Normalize(plus);
+    DiyFp minus = v.f == (1ULL << 52) ? DiyFp{(v.f << 2) - 1, v.e - 2} : DiyFp{(v.f << 1) - 1, v.e - 1};
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    DiyFp power = CachedPower(plus.e, K);
+    DiyFp scaled = Multiply(Normalize(v), power);
+    DiyFp upper = Multiply(plus, power);
+    DiyFp lower = Multiply(minus, power);
+    //one unit in from both ends, the products may be off by one
+    upper.f--;
+    lower.f++;
+    DigitGen(scaled, upper, upper.f - lower.f, digits, length, K);
+}
+
+static char *WriteExponent(int exponent, char *out){
+    *out++ = 'e';
+    if (exponent < 0) {
+        *out++ = '-';
+        exponent = -exponent;
+    }
+    if (exponent >= 100) {
+        *out++ = static_cast<char>('0' + exponent / 100);
+        exponent %= 100;
+        *out++ = static_cast<char>('0' + exponent / 10);
+    }
+    else if (exponent >= 10) {
+        *out++ = static_cast<char>('0' + exponent / 10);
+    }
+    *out++ = static_cast<char>('0' + exponent % 10);
+    return out;
+}
+
+char *Parse::FormatDouble(double value, char *out){
+    if (std::isnan(value)) {
+        return out;
+    }
+    if (std::signbit(value)) {
+        *out++ = '-';
+        value = -value;
+    }
+    if (value == 0.0) {
+        *out++ = '0';
+        return out;
+    }
+    if (std::isinf(value)) {
+        std::memcpy(out, "inf", 3);
+        return out + 3;
+    }
+    char digits[20];
+    int length, K;
+    Grisu2(value, digits, length, K);
+
+    //the value is 0.digits * 10^point, write it plainly unless that takes long runs of zeros
+    int point = length + K;
+    if (K >= 0 && point <= 21) {
+        std::memcpy(out, digits, length);
+        out += length;
+        std::memset(out, '0', K);
+        return out + K;
+    }
+    if (point > 0 && point <= 21) {
+        std::memcpy(out, digits, point);
+        out += point;
+        *out++ = '.';
+        std::memcpy(out, digits + point, length - point);
+        return out + (length - point);
+    }
+    if (point > -6 && point <= 0) {
+        *out++ = '0';
+        *out++ = '.';
+        std::memset(out, '0', -point);
+        out += -point;
+        std::memcpy(out, digits, length);
+        return out + length;
+    }
+    *out++ = digits[0];
+    if (length > 1) {
+        *out++ = '.';
+        std::memcpy(out, digits + 1, length - 1);
+        out += length - 1;
+    }
+    return WriteExponent(point - 1, out);
+}
+
+char *Parse::FormatInteger(int64_t value, char *out){
+    //through uint64_t, INT64_MIN has no positive int64_t
+    uint64_t magnitude = static_cast<uint64_t>(value);
+    if (value < 0) {
+        *out++ = '-';
+        magnitude = 0 - magnitude;
+    }
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    return out;
+}
 
 #endif
\ No newline at end of file
@@ -1,7 +1,12 @@
 #ifndef PARSE_H
 #define PARSE_H
 
+#include "BarStore.h"
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 #include <curl/curl.h>
 #include <json-c/json.h>
 #include <iostream>
@@ -13,12 +18,41 @@ class Parse{
         //static because it doesnt use any member vars of the Parse class
         static size_t WriteCallBack(void *contents, size_t size, size_t nmemb, void *userp);
 
-        //Sends the written data from the read buffer to a .json file called "response.json"
+        //Hands the received data to the TimeSeriesParser passed as 'userp' instead of buffering it
+        //bars are parsed while the transfer is still running
+        static size_t StreamCallBack(void *contents, size_t size, size_t nmemb, void *userp);
+
+        //Sends the written data from the read buffer to a .json file and returns its name
         //static cuz it doesnt use any memeber vars of the Parse class
-        static void WriteToJSON(std::string readBuffer);
+        //Debug only: responses are parsed from memory, this is called for every response only when SetDebugDump(true)
+        //Without a fileName every call gets its own "response_<pid>_<n>.json", so concurrent requests never share a file
+        static std::string WriteToJSON(const std::string& readBuffer, const std::string& fileName = "");
+
+        //Turn dumping of every response to its own .json file on or off. Off by default. Safe to call from any thread
+        static void SetDebugDump(bool enabled);
+        static bool DebugDumpEnabled();
+
+        //BULK CSV EXPORT. No iostream: rows are formatted straight into one big buffer that goes out in large write() calls.
+        //Prices are written in their shortest form that reads back to the same double (see FormatDouble), NaN as an empty field.
+        //'delimiter' '\t' gives TSV. All of them throw std::runtime_error if the file cannot be written
 
-        //Sends the written data from the read buffer to a .csv file called "response.csv"
-        void WriteToCSV(void *contents, std::string readBuffer);
+        //bars, newest first like the store: datetime,open,high,low,close,volume
+        static void WriteToCSV(const std::string& fileName, const BarStore& bars, char delimiter = ',');
+        //indicator output in the <date,value.....date,value> form of Analytics/IndicatorSession: datetime,'valueName'
+        static void WriteToCSV(const std::string& fileName, const std::vector<std::pair<std::string, double>>& values,
+                               const std::string& valueName = "value", char delimiter = ',');
+        //several indicator outputs against one timestamp column: datetime,names[0],names[1].....
+        //every column holds timeStamps.size() values, row i belongs to timeStamps[i]
+        static void WriteToCSV(const std::string& fileName, ColumnView<int64_t> timeStamps, bool timeOfDay,
+                               const std::vector<std::string>& names, const std::vector<const double*>& columns, char delimiter = ',');
+
+        //FORMATTERS used by the export, each writes at 'out' and returns the end of what it wrote (no terminating 0)
+
+        //shortest decimal that reads back to exactly 'value' (Grisu2, see Parse.cpp), at most 25 chars. NaN writes nothing
+        static char *FormatDouble(double value, char *out);
+        //at most 20 chars
+        static char *FormatInteger(int64_t value, char *out);
+        //datetimes are written by EpochTime::Format
 
 
 
@@ -32,6 +66,10 @@ class Parse{
         //take all the values object data (high,low,volume,open,close) and put into a vector 'genValues'
         void ParseTSValuesToVec(std::string readBuffer);
 
+    private:
+        static std::atomic<bool> debugDump;
+        static std::atomic<unsigned long> dumpSequence; //numbers the default dump file names
+
 };
 
 #endif
\ No newline at end of file
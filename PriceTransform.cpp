@@ -0,0 +1,480 @@
+#ifndef PRICETRANSFORM_CPP
+#define PRICETRANSFORM_CPP
+#include "PriceTransform.h"
+
+#include <atomic>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PRICETRANSFORM_X86 1
+#include <immintrin.h>
+#endif
+
+//SCALAR KERNELS, also used for the tail a vector kernel leaves over
+
+static void AvgPriceScalar(const double *open, const double *high, const double *low, const double *close, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = (open[i] + high[i] + low[i] + close[i]) / 4.0;
+    }
+}
+
+static void MedPriceScalar(const double *high, const double *low, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = (high[i] + low[i]) / 2.0;
+    }
+}
+
+static void TypPriceScalar(const double *high, const double *low, const double *close, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = (high[i] + low[i] + close[i]) / 3.0;
+    }
+}
+
+static void WclPriceScalar(const double *high, const double *low, const double *close, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = (high[i] + low[i] + close[i] * 2.0) / 4.0;
+    }
+}
+
+static void BopScalar(const double *open, const double *high, const double *low, const double *close, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        double range = high[i] - low[i];
+        out[i] = range > 0.0 ? (close[i] - open[i]) / range : 0.0;
+    }
+}
+
+static void DivScalar(const double *a, const double *b, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = a[i] / b[i];
+    }
+}
+
+static void MultScalar(const double *a, const double *b, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = a[i] * b[i];
+    }
+}
+
+static void SubScalar(const double *a, const double *b, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = a[i] - b[i];
+    }
+}
+
+static void SqrtScalar(const double *in, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = std::sqrt(in[i]);
+    }
+}
+
+static void CeilScalar(const double *in, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = std::ceil(in[i]);
+    }
+}
+
+static void FloorScalar(const double *in, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = std::floor(in[i]);
+    }
+}
+
+#ifdef PRICETRANSFORM_X86
+
+//SSE4.1 KERNELS, 2 doubles per step
+
+__attribute__((target("sse4.1")))
+static void AvgPriceSSE41(const double *open, const double *high, const double *low, const double *close, double *out, size_t count){
+    const __m128d quarter = _mm_set1_pd(4.0);
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        __m128d sum = _mm_add_pd(_mm_loadu_pd(open + i), _mm_loadu_pd(high + i));
+        sum = _mm_add_pd(sum, _mm_loadu_pd(low + i));
+        sum = _mm_add_pd(sum, _mm_loadu_pd(close + i));
+        _mm_storeu_pd(out + i, _mm_div_pd(sum, quarter));
+    }
+    AvgPriceScalar(open + i, high + i, low + i, close + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void MedPriceSSE41(const double *high, const double *low, double *out, size_t count){
+    const __m128d two = _mm_set1_pd(2.0);
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        __m128d sum = _mm_add_pd(_mm_loadu_pd(high + i), _mm_loadu_pd(low + i));
+        _mm_storeu_pd(out + i, _mm_div_pd(sum, two));
+    }
+    MedPriceScalar(high + i, low + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void TypPriceSSE41(const double *high, const double *low, const double *close, double *out, size_t count){
+    const __m128d three = _mm_set1_pd(3.0);
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        __m128d sum = _mm_add_pd(_mm_loadu_pd(high + i), _mm_loadu_pd(low + i));
+        sum = _mm_add_pd(sum, _mm_loadu_pd(close + i));
+        _mm_storeu_pd(out + i, _mm_div_pd(sum, three));
+    }
+    TypPriceScalar(high + i, low + i, close + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void WclPriceSSE41(const double *high, const double *low, const double *close, double *out, size_t count){
+    const __m128d two = _mm_set1_pd(2.0);
+    const __m128d four = _mm_set1_pd(4.0);
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        __m128d sum = _mm_add_pd(_mm_loadu_pd(high + i), _mm_loadu_pd(low + i));
+        sum = _mm_add_pd(sum, _mm_mul_pd(_mm_loadu_pd(close + i), two));
+        _mm_storeu_pd(out + i, _mm_div_pd(sum, four));
+    }
+    WclPriceScalar(high + i, low + i, close + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void BopSSE41(const double *open, const double *high, const double *low, const double *close, double *out, size_t count){
+    const __m128d zero = _mm_setzero_pd();
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        __m128d range = _mm_sub_pd(_mm_loadu_pd(high + i), _mm_loadu_pd(low + i));
+        __m128d body = _mm_sub_pd(_mm_loadu_pd(close + i), _mm_loadu_pd(open + i));
+        //lanes with range <= 0 divided by 0, the mask zeroes them
+        __m128d valid = _mm_cmpgt_pd(range, zero);
+        _mm_storeu_pd(out + i, _mm_and_pd(_mm_div_pd(body, range), valid));
+    }
+    BopScalar(open + i, high + i, low + i, close + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void DivSSE41(const double *a, const double *b, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        _mm_storeu_pd(out + i, _mm_div_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    DivScalar(a + i, b + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void MultSSE41(const double *a, const double *b, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    MultScalar(a + i, b + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void SubSSE41(const double *a, const double *b, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        _mm_storeu_pd(out + i, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    }
+    SubScalar(a + i, b + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void SqrtSSE41(const double *in, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        _mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_loadu_pd(in + i)));
+    }
+    SqrtScalar(in + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void CeilSSE41(const double *in, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        _mm_storeu_pd(out + i, _mm_round_pd(_mm_loadu_pd(in + i), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+    }
+    CeilScalar(in + i, out + i, count - i);
+}
+
+__attribute__((target("sse4.1")))
+static void FloorSSE41(const double *in, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 2 <= count; i += 2){
+        _mm_storeu_pd(out + i, _mm_round_pd(_mm_loadu_pd(in + i), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    }
+    FloorScalar(in + i, out + i, count - i);
+}
+
+//AVX2 KERNELS, 4 doubles per step
+
+__attribute__((target("avx2")))
+static void AvgPriceAVX2(const double *open, const double *high, const double *low, const double *close, double *out, size_t count){
+    const __m256d quarter = _mm256_set1_pd(4.0);
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        __m256d sum = _mm256_add_pd(_mm256_loadu_pd(open + i), _mm256_loadu_pd(high + i));
+        sum = _mm256_add_pd(sum, _mm256_loadu_pd(low + i));
+        sum = _mm256_add_pd(sum, _mm256_loadu_pd(close + i));
+        _mm256_storeu_pd(out + i, _mm256_div_pd(sum, quarter));
+    }
+    AvgPriceScalar(open + i, high + i, low + i, close + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void MedPriceAVX2(const double *high, const double *low, double *out, size_t count){
+    const __m256d two = _mm256_set1_pd(2.0);
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        __m256d sum = _mm256_add_pd(_mm256_loadu_pd(high + i), _mm256_loadu_pd(low + i));
+        _mm256_storeu_pd(out + i, _mm256_div_pd(sum, two));
+    }
+    MedPriceScalar(high + i, low + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void TypPriceAVX2(const double *high, const double *low, const double *close, double *out, size_t count){
+    const __m256d three = _mm256_set1_pd(3.0);
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        __m256d sum = _mm256_add_pd(_mm256_loadu_pd(high + i), _mm256_loadu_pd(low + i));
+        sum = _mm256_add_pd(sum, _mm256_loadu_pd(close + i));
+        _mm256_storeu_pd(out + i, _mm256_div_pd(sum, three));
+    }
+    TypPriceScalar(high + i, low + i, close + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void WclPriceAVX2(const double *high, const double *low, const double *close, double *out, size_t count){
+    const __m256d two = _mm256_set1_pd(2.0);
+    const __m256d four = _mm256_set1_pd(4.0);
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        __m256d sum = _mm256_add_pd(_mm256_loadu_pd(high + i), _mm256_loadu_pd(low + i));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_loadu_pd(close + i), two));
+        _mm256_storeu_pd(out + i, _mm256_div_pd(sum, four));
+    }
+    WclPriceScalar(high + i, low + i, close + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void BopAVX2(const double *open, const double *high, const double *low, const double *close, double *out, size_t count){
+    const __m256d zero = _mm256_setzero_pd();
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        __m256d range = _mm256_sub_pd(_mm256_loadu_pd(high + i), _mm256_loadu_pd(low + i));
+        __m256d body = _mm256_sub_pd(_mm256_loadu_pd(close + i), _mm256_loadu_pd(open + i));
+        //lanes with range <= 0 divided by 0, the mask zeroes them
+        __m256d valid = _mm256_cmp_pd(range, zero, _CMP_GT_OQ);
+        _mm256_storeu_pd(out + i, _mm256_and_pd(_mm256_div_pd(body, range), valid));
+    }
+    BopScalar(open + i, high + i, low + i, close + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void DivAVX2(const double *a, const double *b, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        _mm256_storeu_pd(out + i, _mm256_div_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    DivScalar(a + i, b + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void MultAVX2(const double *a, const double *b, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    MultScalar(a + i, b + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void SubAVX2(const double *a, const double *b, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    }
+    SubScalar(a + i, b + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void SqrtAVX2(const double *in, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(in + i)));
+    }
+    SqrtScalar(in + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void CeilAVX2(const double *in, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        _mm256_storeu_pd(out + i, _mm256_round_pd(_mm256_loadu_pd(in + i), _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+    }
+    CeilScalar(in + i, out + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void FloorAVX2(const double *in, double *out, size_t count){
+    size_t i = 0;
+    for(; i + 4 <= count; i += 4){
+        _mm256_storeu_pd(out + i, _mm256_round_pd(_mm256_loadu_pd(in + i), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    }
+    FloorScalar(in + i, out + i, count - i);
+}
+
+#endif
+
+//DISPATCH
+
+//one entry per transform that has vector versions
+struct KernelTable{
+    PriceTransform::Kernel kernel;
+    void (*avgPrice)(const double*, const double*, const double*, const double*, double*, size_t);
+    void (*medPrice)(const double*, const double*, double*, size_t);
+    void (*typPrice)(const double*, const double*, const double*, double*, size_t);
+    void (*wclPrice)(const double*, const double*, const double*, double*, size_t);
+    void (*bop)(const double*, const double*, const double*, const double*, double*, size_t);
+    void (*div)(const double*, const double*, double*, size_t);
+    void (*mult)(const double*, const double*, double*, size_t);
+    void (*sub)(const double*, const double*, double*, size_t);
+    void (*sqrt)(const double*, double*, size_t);
+    void (*ceil)(const double*, double*, size_t);
+    void (*floor)(const double*, double*, size_t);
+};
+
+static const KernelTable SCALAR_TABLE = {
+    PriceTransform::KERNEL_SCALAR, AvgPriceScalar, MedPriceScalar, TypPriceScalar, WclPriceScalar, BopScalar,
+    DivScalar, MultScalar, SubScalar, SqrtScalar, CeilScalar, FloorScalar
+};
+
+#ifdef PRICETRANSFORM_X86
+static const KernelTable SSE41_TABLE = {
+    PriceTransform::KERNEL_SSE41, AvgPriceSSE41, MedPriceSSE41, TypPriceSSE41, WclPriceSSE41, BopSSE41,
+    DivSSE41, MultSSE41, SubSSE41, SqrtSSE41, CeilSSE41, FloorSSE41
+};
+static const KernelTable AVX2_TABLE = {
+    PriceTransform::KERNEL_AVX2, AvgPriceAVX2, MedPriceAVX2, TypPriceAVX2, WclPriceAVX2, BopAVX2,
+    DivAVX2, MultAVX2, SubAVX2, SqrtAVX2, CeilAVX2, FloorAVX2
+};
+#endif
+
+static const KernelTable *TableFor(PriceTransform::Kernel kernel){
+#ifdef PRICETRANSFORM_X86
+    if(kernel == PriceTransform::KERNEL_AVX2){
+        return &AVX2_TABLE;
+    }
+    if(kernel == PriceTransform::KERNEL_SSE41){
+        return &SSE41_TABLE;
+    }
+#endif
+    return &SCALAR_TABLE;
+}
+
+//nullptr until the first transform runs, then the table of the detected (or forced) kernel
+static std::atomic<const KernelTable*> activeTable(nullptr);
+
+static const KernelTable *Active(){
+    const KernelTable *table = activeTable.load(std::memory_order_acquire);
+    if(table == nullptr){
+        table = TableFor(PriceTransform::DetectKernel());
+        activeTable.store(table, std::memory_order_release);
+    }
+    return table;
+}
+
+PriceTransform::Kernel PriceTransform::DetectKernel(){
+#ifdef PRICETRANSFORM_X86
+    if(__builtin_cpu_supports("avx2")){
+        return KERNEL_AVX2;
+    }
+    if(__builtin_cpu_supports("sse4.1")){
+        return KERNEL_SSE41;
+    }
+#endif
+    return KERNEL_SCALAR;
+}
+
+PriceTransform::Kernel PriceTransform::getKernel(){
+    return Active()->kernel;
+}
+
+void PriceTransform::SetKernel(Kernel kernel){
+    //never hand out a kernel the CPU can not run
+    if(kernel > DetectKernel()){
+        kernel = DetectKernel();
+    }
+    activeTable.store(TableFor(kernel), std::memory_order_release);
+}
+
+const char *PriceTransform::KernelName(Kernel kernel){
+    switch(kernel){
+        case KERNEL_AVX2:
+            return "avx2";
+        case KERNEL_SSE41:
+            return "sse4.1";
+        case KERNEL_SCALAR:
+            return "scalar";
+    }
+    return "scalar";
+}
+
+void PriceTransform::AvgPrice(const double *open, const double *high, const double *low, const double *close, double *out, size_t count){
+    Active()->avgPrice(open, high, low, close, out, count);
+}
+
+void PriceTransform::MedPrice(const double *high, const double *low, double *out, size_t count){
+    Active()->medPrice(high, low, out, count);
+}
+
+void PriceTransform::TypPrice(const double *high, const double *low, const double *close, double *out, size_t count){
+    Active()->typPrice(high, low, close, out, count);
+}
+
+void PriceTransform::WclPrice(const double *high, const double *low, const double *close, double *out, size_t count){
+    Active()->wclPrice(high, low, close, out, count);
+}
+
+void PriceTransform::Bop(const double *open, const double *high, const double *low, const double *close, double *out, size_t count){
+    Active()->bop(open, high, low, close, out, count);
+}
+
+void PriceTransform::Div(const double *a, const double *b, double *out, size_t count){
+    Active()->div(a, b, out, count);
+}
+
+void PriceTransform::Mult(const double *a, const double *b, double *out, size_t count){
+    Active()->mult(a, b, out, count);
+}
+
+void PriceTransform::Sub(const double *a, const double *b, double *out, size_t count){
+    Active()->sub(a, b, out, count);
+}
+
+void PriceTransform::Exp(const double *in, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = std::exp(in[i]);
+    }
+}
+
+void PriceTransform::Ln(const double *in, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = std::log(in[i]);
+    }
+}
+
+void PriceTransform::Log10(const double *in, double *out, size_t count){
+    for(size_t i = 0; i < count; i++){
+        out[i] = std::log10(in[i]);
+    }
+}
+
+void PriceTransform::Sqrt(const double *in, double *out, size_t count){
+    Active()->sqrt(in, out, count);
+}
+
+void PriceTransform::Ceil(const double *in, double *out, size_t count){
+    Active()->ceil(in, out, count);
+}
+
+void PriceTransform::Floor(const double *in, double *out, size_t count){
+    Active()->floor(in, out, count);
+}
+
+#endif
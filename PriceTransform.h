@@ -0,0 +1,57 @@
+#ifndef PRICETRANSFORM_H
+#define PRICETRANSFORM_H
+
+#include <cstddef>
+
+/// @brief Element-wise price transforms over contiguous double columns (e.g. BarStore::getCloses().data()).
+///        Every kernel has an AVX2, an SSE4.1 and a scalar version; the widest one the CPU supports is picked once at
+///        runtime, so the binary needs no -m flags and still runs on any x86-64 (or non x86) machine.
+///        The vector versions perform the same operations in the same order as the scalar ones (no FMA), so the
+///        result does not depend on the kernel picked. EXP, LN and LOG10 have no exact vector form and call the
+///        C library per element in every kernel.
+///        'out' may alias an input. All pointers must hold at least 'count' values.
+///
+///        ColumnView<double> highs = bars.getHighs(), lows = bars.getLows(), closes = bars.getCloses();
+///        std::vector<double> typical(bars.size());
+///        PriceTransform::TypPrice(highs.data(), lows.data(), closes.data(), typical.data(), bars.size());
+class PriceTransform{
+    public:
+        enum Kernel { KERNEL_SCALAR, KERNEL_SSE41, KERNEL_AVX2 };
+
+        /// @brief (open + high + low + close) / 4
+        static void AvgPrice(const double *open, const double *high, const double *low, const double *close, double *out, size_t count);
+        /// @brief (high + low) / 2
+        static void MedPrice(const double *high, const double *low, double *out, size_t count);
+        /// @brief (high + low + close) / 3, also HLC3
+        static void TypPrice(const double *high, const double *low, const double *close, double *out, size_t count);
+        /// @brief (high + low + 2 * close) / 4
+        static void WclPrice(const double *high, const double *low, const double *close, double *out, size_t count);
+        /// @brief (close - open) / (high - low), 0 for a bar with high <= low
+        static void Bop(const double *open, const double *high, const double *low, const double *close, double *out, size_t count);
+
+        /// @brief a / b
+        static void Div(const double *a, const double *b, double *out, size_t count);
+        /// @brief a * b
+        static void Mult(const double *a, const double *b, double *out, size_t count);
+        /// @brief a - b
+        static void Sub(const double *a, const double *b, double *out, size_t count);
+
+        static void Exp(const double *in, double *out, size_t count);
+        static void Ln(const double *in, double *out, size_t count);
+        static void Log10(const double *in, double *out, size_t count);
+        static void Sqrt(const double *in, double *out, size_t count);
+        static void Ceil(const double *in, double *out, size_t count);
+        static void Floor(const double *in, double *out, size_t count);
+
+        /// @brief widest kernel this CPU supports
+        static Kernel DetectKernel();
+        /// @brief kernel currently used by the transforms
+        static Kernel getKernel();
+        /// @brief force a kernel, e.g. KERNEL_SCALAR to compare against. Capped at DetectKernel().
+        ///        Not synchronized with transforms running on other threads, set it before starting them
+        static void SetKernel(Kernel kernel);
+        /// @brief "avx2", "sse4.1" or "scalar"
+        static const char *KernelName(Kernel kernel);
+};
+
+#endif
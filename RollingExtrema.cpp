@@ -0,0 +1,154 @@
+#ifndef ROLLINGEXTREMA_CPP
+#define ROLLINGEXTREMA_CPP
+#include "RollingExtrema.h"
+#include "ScratchArena.h"
+
+#include <stdexcept>
+
+RollingExtrema::RollingExtrema(int period) : period(period){
+    if(period <= 0){
+        throw std::invalid_argument("RollingExtrema.cpp @ RollingExtrema: 'period' must be positive");
+    }
+    reset();
+}
+
+bool RollingExtrema::update(double value){
+    uint64_t sequence = state.count;
+    size_t capacity = static_cast<size_t>(period);
+
+    //drop what falls out of the window, it is always at the front
+    if(state.maxSize > 0 && state.maxSequence[state.maxHead] + period <= sequence){
+        state.maxHead = (state.maxHead + 1) % capacity;
+        state.maxSize--;
+    }
+    if(state.minSize > 0 && state.minSequence[state.minHead] + period <= sequence){
+        state.minHead = (state.minHead + 1) % capacity;
+        state.minSize--;
+    }
+
+    //values the new one beats can never be the extreme again
+    while(state.maxSize > 0 && state.maxValue[(state.maxHead + state.maxSize - 1) % capacity] <= value){
+        state.maxSize--;
+    }
+    size_t back = (state.maxHead + state.maxSize) % capacity;
+    state.maxSequence[back] = sequence;
+    state.maxValue[back] = value;
+    state.maxSize++;
+
+    while(state.minSize > 0 && state.minValue[(state.minHead + state.minSize - 1) % capacity] >= value){
+        state.minSize--;
+    }
+    back = (state.minHead + state.minSize) % capacity;
+    state.minSequence[back] = sequence;
+    state.minValue[back] = value;
+    state.minSize++;
+
+    state.count++;
+    return isReady();
+}
+
+double RollingExtrema::getMax() const{
+    return state.maxValue[state.maxHead];
+}
+
+double RollingExtrema::getMin() const{
+    return state.minValue[state.minHead];
+}
+
+size_t RollingExtrema::getMaxAge() const{
+    return static_cast<size_t>(state.count - 1 - state.maxSequence[state.maxHead]);
+}
+
+size_t RollingExtrema::getMinAge() const{
+    return static_cast<size_t>(state.count - 1 - state.minSequence[state.minHead]);
+}
+
+bool RollingExtrema::isReady() const{
+    return state.count >= static_cast<uint64_t>(period);
+}
+
+int RollingExtrema::getPeriod() const{
+    return period;
+}
+
+void RollingExtrema::reset(){
+    state.maxSequence.assign(period, 0);
+    state.maxValue.assign(period, 0.0);
+    state.maxHead = 0;
+    state.maxSize = 0;
+    state.minSequence.assign(period, 0);
+    state.minValue.assign(period, 0.0);
+    state.minHead = 0;
+    state.minSize = 0;
+    state.count = 0;
+}
+
+RollingExtrema::State RollingExtrema::snapshot() const{
+    return state;
+}
+
+void RollingExtrema::restore(const State& state){
+    if(state.maxValue.size() != static_cast<size_t>(period)){
+        throw std::invalid_argument("RollingExtrema.cpp @ restore: snapshot of a different period");
+    }
+    this->state = state;
+}
+
+void RollingExtrema::Window(const double *values, size_t count, int period, size_t outputCount,
+                            double *min, double *max, size_t *minIndex, size_t *maxIndex){
+    if(period <= 0){
+        throw std::invalid_argument("RollingExtrema.cpp @ Window: 'period' must be positive");
+    }
+    if(outputCount == 0){
+        return;
+    }
+    size_t span = outputCount + period - 1;
+    if(count < span){
+        throw std::invalid_argument("RollingExtrema.cpp @ Window: 'values' holds less than outputCount + period - 1 values");
+    }
+
+    //every index is pushed once, so plain arrays with moving head/tail are enough as deques. They are temporaries of
+    //this call, taken from the thread's arena
+    ScratchArena& arena = ScratchArena::ForThread();
+    ScratchArena::Scope scope(arena);
+    size_t *maxDeque = arena.allocate<size_t>(span);
+    size_t *minDeque = arena.allocate<size_t>(span);
+    size_t maxHead = 0, maxTail = 0;
+    size_t minHead = 0, minTail = 0;
+
+    //oldest to newest, the window of output i is [i, i + period - 1]
+    for(size_t j = span; j-- > 0;){
+        while(maxTail > maxHead && values[maxDeque[maxTail - 1]] <= values[j]){
+            maxTail--;
+        }
+        maxDeque[maxTail++] = j;
+        while(minTail > minHead && values[minDeque[minTail - 1]] >= values[j]){
+            minTail--;
+        }
+        minDeque[minTail++] = j;
+
+        if(j >= outputCount){
+            continue;
+        }
+        while(maxDeque[maxHead] > j + period - 1){
+            maxHead++;
+        }
+        while(minDeque[minHead] > j + period - 1){
+            minHead++;
+        }
+        if(max != nullptr){
+            max[j] = values[maxDeque[maxHead]];
+        }
+        if(maxIndex != nullptr){
+            maxIndex[j] = maxDeque[maxHead];
+        }
+        if(min != nullptr){
+            min[j] = values[minDeque[minHead]];
+        }
+        if(minIndex != nullptr){
+            minIndex[j] = minDeque[minHead];
+        }
+    }
+}
+
+#endif
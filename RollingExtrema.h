@@ -0,0 +1,60 @@
+#ifndef ROLLINGEXTREMA_H
+#define ROLLINGEXTREMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Sliding window minimum and maximum with monotonic deques: every value enters and leaves each deque once,
+///        so a window step is O(1) amortized whatever the period (MIN/MAX, MIDPOINT, MIDPRICE, WILLR, AROON, STOCH,
+///        ICHIMOKU...). On ties the most recent value is the extreme.
+///
+///        Streaming: feed values oldest to newest, one update() per bar.
+///            RollingExtrema highest(52);
+///            highest.update(newHigh);
+///            if(highest.isReady()) highest.getMax();
+///
+///        Batch: Window() over a newest first column (as held by BarStore), output i covers values[i .. i + period - 1].
+class RollingExtrema{
+    public:
+        struct State{
+            std::vector<uint64_t> maxSequence;  //ring buffer of (sequence, value) with decreasing values, front = max
+            std::vector<double> maxValue;
+            size_t maxHead;
+            size_t maxSize;
+            std::vector<uint64_t> minSequence;  //same with increasing values, front = min
+            std::vector<double> minValue;
+            size_t minHead;
+            size_t minSize;
+            uint64_t count;                     //values seen, also the sequence number of the next one
+        };
+
+        explicit RollingExtrema(int period);
+        /// @brief take the next (newer) value, returns isReady()
+        bool update(double value);
+        /// @brief extremes of the last 'period' values
+        double getMax() const;
+        double getMin() const;
+        /// @brief bars since the extreme was fed, 0 = the last value fed. AROON uses these
+        size_t getMaxAge() const;
+        size_t getMinAge() const;
+        /// @brief true once 'period' values were fed
+        bool isReady() const;
+        int getPeriod() const;
+        void reset();
+        State snapshot() const;
+        void restore(const State& state);
+
+        /// @brief extremes of every window of a newest first column. For i in [0, outputCount) the window of output i
+        ///        is values[i .. i + period - 1], so 'values' must hold outputCount + period - 1 values.
+        ///        Any output pointer may be nullptr when not wanted. Indices are positions in 'values'.
+        ///        Throws std::invalid_argument if period <= 0 or the column is too short
+        static void Window(const double *values, size_t count, int period, size_t outputCount,
+                           double *min, double *max, size_t *minIndex, size_t *maxIndex);
+
+    private:
+        int period;
+        State state;
+};
+
+#endif
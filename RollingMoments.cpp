@@ -0,0 +1,171 @@
+#ifndef ROLLINGMOMENTS_CPP
+#define ROLLINGMOMENTS_CPP
+#include "RollingMoments.h"
+
+#include <cmath>
+#include <stdexcept>
+
+RollingMoments::RollingMoments(int period) : period(period){
+    if(period <= 0){
+        throw std::invalid_argument("RollingMoments.cpp @ RollingMoments: 'period' must be positive");
+    }
+    reset();
+}
+
+bool RollingMoments::update(double y){
+    double x = static_cast<double>(state.bars);
+    state.bars++;
+    return update(x, y);
+}
+
+bool RollingMoments::update(double x, double y){
+    if(state.count == static_cast<size_t>(period)){
+        Remove(state.xWindow[state.next], state.yWindow[state.next]);
+    }
+    Add(x, y);
+    state.xWindow[state.next] = x;
+    state.yWindow[state.next] = y;
+    state.next = (state.next + 1) % period;
+    //once per lap, throw away whatever the add/remove updates accumulated. A window of two is recomputed every step:
+    //Remove leaves one pair whose mean carries the rounding of the removal, and the next Add would build the moments of
+    //the new window (possibly two close values, e.g. two highs a tick apart) on that rounding
+    if(state.next == 0 || period == 2){
+        Recompute();
+    }
+    return isReady();
+}
+
+void RollingMoments::Add(double x, double y){
+    //Welford: the second moments grow by (value - old mean) * (value - new mean)
+    state.count++;
+    double dx = x - state.meanX;
+    double dy = y - state.meanY;
+    state.meanX += dx / state.count;
+    state.meanY += dy / state.count;
+    state.m2X += dx * (x - state.meanX);
+    state.m2Y += dy * (y - state.meanY);
+    state.cXY += dx * (y - state.meanY);
+}
+
+void RollingMoments::Remove(double x, double y){
+    if(state.count <= 1){
+        state.count = 0;
+        state.meanX = state.meanY = 0.0;
+        state.m2X = state.m2Y = state.cXY = 0.0;
+        return;
+    }
+    //inverse of Add: the moments shrink by (value - mean without it) * (value - mean with it)
+    double remaining = static_cast<double>(state.count - 1);
+    double meanX = state.meanX - (x - state.meanX) / remaining;
+    double meanY = state.meanY - (y - state.meanY) / remaining;
+    state.m2X -= (x - meanX) * (x - state.meanX);
+    state.m2Y -= (y - meanY) * (y - state.meanY);
+    state.cXY -= (x - meanX) * (y - state.meanY);
+    state.meanX = meanX;
+    state.meanY = meanY;
+    state.count--;
+}
+
+void RollingMoments::Recompute(){
+    double sumX = 0.0, sumY = 0.0;
+    for(size_t i = 0; i < state.count; i++){
+        sumX += state.xWindow[i];
+        sumY += state.yWindow[i];
+    }
+    state.meanX = sumX / state.count;
+    state.meanY = sumY / state.count;
+    state.m2X = state.m2Y = state.cXY = 0.0;
+    for(size_t i = 0; i < state.count; i++){
+        double dx = state.xWindow[i] - state.meanX;
+        double dy = state.yWindow[i] - state.meanY;
+        state.m2X += dx * dx;
+        state.m2Y += dy * dy;
+        state.cXY += dx * dy;
+    }
+}
+
+double RollingMoments::getMean() const{
+    return state.meanY;
+}
+
+double RollingMoments::getVariance() const{
+    //rounding can leave a constant window a hair below 0
+    return state.m2Y > 0.0 ? state.m2Y / state.count : 0.0;
+}
+
+double RollingMoments::getSampleVariance() const{
+    if(state.count < 2){
+        return 0.0;
+    }
+    return state.m2Y > 0.0 ? state.m2Y / (state.count - 1) : 0.0;
+}
+
+double RollingMoments::getStdDev() const{
+    return std::sqrt(getVariance());
+}
+
+double RollingMoments::getCovariance() const{
+    return state.cXY / state.count;
+}
+
+double RollingMoments::getCorrelation() const{
+    if(state.m2X <= 0.0 || state.m2Y <= 0.0){
+        return 0.0;
+    }
+    return state.cXY / std::sqrt(state.m2X * state.m2Y);
+}
+
+double RollingMoments::getSlope() const{
+    if(state.m2X <= 0.0){
+        return 0.0;
+    }
+    return state.cXY / state.m2X;
+}
+
+double RollingMoments::getFit(double x) const{
+    return state.meanY + getSlope() * (x - state.meanX);
+}
+
+double RollingMoments::getLinearReg() const{
+    //bar numbers are consecutive, the newest sits (count - 1) / 2 after the mean
+    return state.meanY + getSlope() * ((state.count - 1) / 2.0);
+}
+
+double RollingMoments::getLinearRegIntercept() const{
+    return state.meanY - getSlope() * ((state.count - 1) / 2.0);
+}
+
+double RollingMoments::getForecast() const{
+    return state.meanY + getSlope() * ((state.count + 1) / 2.0);
+}
+
+bool RollingMoments::isReady() const{
+    return state.count == static_cast<size_t>(period);
+}
+
+int RollingMoments::getPeriod() const{
+    return period;
+}
+
+void RollingMoments::reset(){
+    state.xWindow.assign(period, 0.0);
+    state.yWindow.assign(period, 0.0);
+    state.next = 0;
+    state.count = 0;
+    state.bars = 0;
+    state.meanX = state.meanY = 0.0;
+    state.m2X = state.m2Y = state.cXY = 0.0;
+}
+
+RollingMoments::State RollingMoments::snapshot() const{
+    return state;
+}
+
+void RollingMoments::restore(const State& state){
+    if(state.xWindow.size() != static_cast<size_t>(period)){
+        throw std::invalid_argument("RollingMoments.cpp @ restore: snapshot of a different period");
+    }
+    this->state = state;
+}
+
+#endif
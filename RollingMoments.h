@@ -0,0 +1,80 @@
+#ifndef ROLLINGMOMENTS_H
+#define ROLLINGMOMENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Sliding window mean, variance, covariance and least squares fit over the last 'period' (x, y) pairs.
+///        Values enter and leave the window with Welford's updates (means and centered second moments, not raw sums),
+///        so a window step is O(1) and prices around 10^4 do not lose their decimals to a sum of squares.
+///        Once per 'period' steps (every step for a period of 2) the moments are recomputed exactly from the window,
+///        which bounds whatever rounding the add/remove updates accumulate on very long series.
+///
+///        Two ways to feed it, do not mix them on one object:
+///            update(y)     x is the bar number, so the fit is a regression of y over time (LINEARREG, TSF...)
+///            update(x, y)  two series side by side (CORREL)
+///        Bars go in oldest to newest. Getters are meaningful once isReady() is true.
+class RollingMoments{
+    public:
+        struct State{
+            std::vector<double> xWindow;  //ring buffers of the pairs in the window
+            std::vector<double> yWindow;
+            size_t next;                  //slot the next pair goes to
+            size_t count;                 //pairs in the window
+            uint64_t bars;                //update(y) calls so far, the next bar number
+            double meanX;
+            double meanY;
+            double m2X;                   //sum of (x - meanX)^2
+            double m2Y;                   //sum of (y - meanY)^2
+            double cXY;                   //sum of (x - meanX) * (y - meanY)
+        };
+
+        explicit RollingMoments(int period);
+        /// @brief next value of a time series, x is its bar number. Returns isReady()
+        bool update(double y);
+        /// @brief next pair of two series. Returns isReady()
+        bool update(double x, double y);
+
+        /// @brief mean of y over the window
+        double getMean() const;
+        /// @brief population variance of y, sum((y - mean)^2) / period
+        double getVariance() const;
+        /// @brief sample variance of y, sum((y - mean)^2) / (period - 1)
+        double getSampleVariance() const;
+        /// @brief sqrt(getVariance())
+        double getStdDev() const;
+        /// @brief population covariance of x and y
+        double getCovariance() const;
+        /// @brief Pearson correlation of x and y, 0 when either is constant over the window
+        double getCorrelation() const;
+        /// @brief least squares slope of y over x
+        double getSlope() const;
+        /// @brief value of the least squares line at 'x'
+        double getFit(double x) const;
+
+        //TIME SERIES FIT (update(y) only), the oldest bar of the window is x = 0, the newest x = period - 1
+        /// @brief fit at the newest bar (LINEARREG)
+        double getLinearReg() const;
+        /// @brief fit at the oldest bar (LINEARREGINTERCEPT)
+        double getLinearRegIntercept() const;
+        /// @brief fit one bar past the newest (TSF)
+        double getForecast() const;
+
+        bool isReady() const;
+        int getPeriod() const;
+        void reset();
+        State snapshot() const;
+        void restore(const State& state);
+
+    private:
+        void Add(double x, double y);
+        void Remove(double x, double y);
+        /// @brief exact two pass moments of the window
+        void Recompute();
+
+        int period;
+        State state;
+};
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef SCRATCHARENA_CPP
+#define SCRATCHARENA_CPP
+#include "ScratchArena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+const size_t ScratchArena::ALIGNMENT;
+const size_t ScratchArena::DEFAULT_BLOCK_SIZE;
+
+ScratchArena::ScratchArena(size_t blockSize)
+    : current(0), offset(0), blockSize(std::max(blockSize, ALIGNMENT)), blockAllocations(0) {}
+
+ScratchArena::~ScratchArena(){
+    release();
+}
+
+void* ScratchArena::allocateBytes(size_t bytes){
+    if(bytes == 0){
+        return nullptr;
+    }
+    bytes = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    //the rest of the current block, then the next kept block it fits into, then a new block
+    while(current < blocks.size() && offset + bytes > blocks[current].size){
+        current++;
+        offset = 0;
+    }
+    if(current == blocks.size()){
+        Grow(bytes);
+    }
+    void *result = blocks[current].base + offset;
+    offset += bytes;
+    return result;
+}
+
+ScratchArena::Mark ScratchArena::mark() const{
+    Mark position = {current, offset};
+    return position;
+}
+
+void ScratchArena::rewind(const Mark& position){
+    //back at the start nothing is in use, the moment to merge the blocks
+    if(position.block == 0 && position.offset == 0){
+        reset();
+        return;
+    }
+    current = position.block;
+    offset = position.offset;
+}
+
+void ScratchArena::reset(){
+    current = 0;
+    offset = 0;
+    if(blocks.size() > 1){
+        size_t total = getCapacity();
+        release();
+        Grow(total);
+    }
+}
+
+void ScratchArena::release(){
+    for(size_t i = 0; i < blocks.size(); i++){
+        delete[] blocks[i].memory;
+    }
+    blocks.clear();
+    current = 0;
+    offset = 0;
+}
+
+size_t ScratchArena::getCapacity() const{
+    size_t capacity = 0;
+    for(size_t i = 0; i < blocks.size(); i++){
+        capacity += blocks[i].size;
+    }
+    return capacity;
+}
+
+size_t ScratchArena::getUsed() const{
+    size_t used = offset;
+    for(size_t i = 0; i < current && i < blocks.size(); i++){
+        used += blocks[i].size;
+    }
+    return used;
+}
+
+size_t ScratchArena::getBlockAllocations() const{
+    return blockAllocations;
+}
+
+ScratchArena& ScratchArena::ForThread(){
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+void ScratchArena::Grow(size_t bytes){
+    //at least double what is there, so a growing workload needs few blocks before the next merge
+    size_t size = std::max(std::max(bytes, blockSize), getCapacity());
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    Block block;
+    block.memory = new char[size + ALIGNMENT - 1];
+    uintptr_t address = reinterpret_cast<uintptr_t>(block.memory);
+    block.base = block.memory + ((ALIGNMENT - address % ALIGNMENT) % ALIGNMENT);
+    block.size = size;
+    blocks.push_back(block);
+    blockAllocations++;
+    current = blocks.size() - 1;
+    offset = 0;
+}
+
+#endif
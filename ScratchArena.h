@@ -0,0 +1,98 @@
+#ifndef SCRATCHARENA_H
+#define SCRATCHARENA_H
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+/// @brief Bump allocator for the temporaries of one indicator evaluation (the A/D line under ADOSC, the EMAs of it...).
+///        An allocation moves a pointer forward in a block the arena owns; nothing is freed one by one, a Scope (or
+///        reset()) gives back everything allocated after it at once. Blocks are kept for the next evaluation, and when a
+///        reset finds more than one block they are merged into a single block of their total size, so once an arena has
+///        seen the largest evaluation of a workload it makes no heap allocation at all.
+///
+///        Not thread safe: every thread uses its own arena (ForThread), which also keeps the workers of a scan off the
+///        shared heap and its locks. Only trivially destructible types, memory is uninitialized and 64 byte aligned.
+///
+///        ScratchArena& arena = ScratchArena::ForThread();
+///        ScratchArena::Scope scope(arena);            //everything below is given back when the scope ends
+///        double *ad = arena.allocate<double>(bars);
+class ScratchArena{
+    public:
+        /// @brief position to rewind to, see mark()/rewind()
+        struct Mark{
+            size_t block;
+            size_t offset;
+        };
+
+        /// @brief rewinds 'arena' to where it was at construction when destroyed, also when leaving by an exception.
+        ///        Scopes on one arena must end in the reverse order they began
+        class Scope{
+            public:
+                explicit Scope(ScratchArena& arena) : arena(arena), start(arena.mark()) {}
+                ~Scope(){
+                    arena.rewind(start);
+                }
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                ScratchArena& arena;
+                Mark start;
+        };
+
+        /// @brief alignment of every allocation, one cache line
+        static const size_t ALIGNMENT = 64;
+        /// @brief size of the first block, larger requests get a block of their own size
+        static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+        explicit ScratchArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+        ~ScratchArena();
+
+        ScratchArena(const ScratchArena&) = delete;
+        ScratchArena& operator=(const ScratchArena&) = delete;
+
+        /// @brief uninitialized room for 'count' T, valid until the arena is rewound past it. nullptr when count is 0
+        template<typename T>
+        T* allocate(size_t count){
+            static_assert(std::is_trivially_destructible<T>::value, "ScratchArena never runs destructors");
+            return static_cast<T*>(allocateBytes(count * sizeof(T)));
+        }
+        void* allocateBytes(size_t bytes);
+
+        Mark mark() const;
+        /// @brief give back everything allocated since 'position' was taken
+        void rewind(const Mark& position);
+        /// @brief give back everything. Merges the blocks into one when there are several
+        void reset();
+        /// @brief reset() and free the blocks, e.g. after a one off evaluation much larger than the usual ones
+        void release();
+
+        /// @brief bytes in the blocks / bytes handed out since the last reset
+        size_t getCapacity() const;
+        size_t getUsed() const;
+        /// @brief blocks taken from the heap since construction
+        size_t getBlockAllocations() const;
+
+        /// @brief the calling thread's arena, created on first use and freed when the thread ends
+        static ScratchArena& ForThread();
+
+    private:
+        struct Block{
+            char *memory;   //as allocated
+            char *base;     //'memory' rounded up to ALIGNMENT
+            size_t size;    //usable bytes from 'base'
+        };
+
+        /// @brief append a block of at least 'bytes'
+        void Grow(size_t bytes);
+
+        std::vector<Block> blocks;
+        size_t current;     //block allocations are made from
+        size_t offset;      //first free byte of blocks[current]
+        size_t blockSize;
+        size_t blockAllocations;
+};
+
+#endif
@@ -0,0 +1,357 @@
+#ifndef STREAMINGINDICATORS_CPP
+#define STREAMINGINDICATORS_CPP
+#include "StreamingIndicators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+//STREAMING EMA
+StreamingEMA::StreamingEMA(int period) : period(period), k(2.0 / (static_cast<double>(period) + 1.0)){
+    if(period <= 0){
+        throw std::invalid_argument("StreamingIndicators.cpp @ StreamingEMA: 'period' must be positive");
+    }
+    reset();
+}
+
+bool StreamingEMA::update(double value){
+    state.count++;
+    if(state.count < static_cast<size_t>(period)){
+        state.sum += value;
+    }
+    else if(state.count == static_cast<size_t>(period)){
+        //initial EMA is the SMA of the first 'period' values, as in Analytics::ExponentialMovingAverage
+        state.sum += value;
+        state.ema = state.sum / period;
+    }
+    else{
+        state.ema = (value * k) + (state.ema * (1 - k));
+    }
+    return isReady();
+}
+
+double StreamingEMA::value() const{
+    return state.ema;
+}
+
+bool StreamingEMA::isReady() const{
+    return state.count >= static_cast<size_t>(period);
+}
+
+int StreamingEMA::getPeriod() const{
+    return period;
+}
+
+void StreamingEMA::reset(){
+    state.sum = 0.0;
+    state.ema = 0.0;
+    state.count = 0;
+}
+
+StreamingEMA::State StreamingEMA::snapshot() const{
+    return state;
+}
+
+void StreamingEMA::restore(const State& state){
+    this->state = state;
+}
+
+//STREAMING SMA
+StreamingSMA::StreamingSMA(int period) : period(period){
+    if(period <= 0){
+        throw std::invalid_argument("StreamingIndicators.cpp @ StreamingSMA: 'period' must be positive");
+    }
+    reset();
+}
+
+bool StreamingSMA::update(double value){
+    if(state.count >= static_cast<size_t>(period)){
+        state.sum -= state.window[state.next];
+    }
+    else{
+        state.count++;
+    }
+    state.sum += value;
+    state.window[state.next] = value;
+    state.next = (state.next + 1) % period;
+    //the running sum drifts with every add/subtract, re-add the window once per lap (amortized O(1))
+    if(state.next == 0){
+        state.sum = 0.0;
+        for(size_t i = 0; i < state.count; i++){
+            state.sum += state.window[i];
+        }
+    }
+    return isReady();
+}
+
+double StreamingSMA::value() const{
+    return state.sum / period;
+}
+
+bool StreamingSMA::isReady() const{
+    return state.count >= static_cast<size_t>(period);
+}
+
+int StreamingSMA::getPeriod() const{
+    return period;
+}
+
+void StreamingSMA::reset(){
+    state.window.assign(period, 0.0);
+    state.next = 0;
+    state.count = 0;
+    state.sum = 0.0;
+}
+
+StreamingSMA::State StreamingSMA::snapshot() const{
+    return state;
+}
+
+void StreamingSMA::restore(const State& state){
+    if(state.window.size() != static_cast<size_t>(period)){
+        throw std::invalid_argument("StreamingIndicators.cpp @ StreamingSMA::restore: snapshot of a different period");
+    }
+    this->state = state;
+}
+
+//STREAMING WMA
+StreamingWMA::StreamingWMA(int period) : period(period), divisor(period * (period + 1.0) / 2.0){
+    if(period <= 0){
+        throw std::invalid_argument("StreamingIndicators.cpp @ StreamingWMA: 'period' must be positive");
+    }
+    reset();
+}
+
+bool StreamingWMA::update(double value){
+    if(state.count >= static_cast<size_t>(period)){
+        //every weight drops by one (the oldest value's to 0) and the new value comes in at 'period'
+        state.weightedSum = state.weightedSum - state.sum + period * value;
+        state.sum = state.sum - state.window[state.next] + value;
+    }
+    else{
+        state.count++;
+        state.weightedSum += state.count * value;
+        state.sum += value;
+    }
+    state.window[state.next] = value;
+    state.next = (state.next + 1) % period;
+    //recompute both sums once per lap so rounding does not accumulate. Oldest value is at 'next' when full
+    if(state.next == 0){
+        state.sum = 0.0;
+        state.weightedSum = 0.0;
+        for(size_t i = 0; i < state.count; i++){
+            state.sum += state.window[i];
+            state.weightedSum += (i + 1) * state.window[i];
+        }
+    }
+    return isReady();
+}
+
+double StreamingWMA::value() const{
+    return state.weightedSum / divisor;
+}
+
+bool StreamingWMA::isReady() const{
+    return state.count >= static_cast<size_t>(period);
+}
+
+int StreamingWMA::getPeriod() const{
+    return period;
+}
+
+void StreamingWMA::reset(){
+    state.window.assign(period, 0.0);
+    state.next = 0;
+    state.count = 0;
+    state.sum = 0.0;
+    state.weightedSum = 0.0;
+}
+
+StreamingWMA::State StreamingWMA::snapshot() const{
+    return state;
+}
+
+void StreamingWMA::restore(const State& state){
+    if(state.window.size() != static_cast<size_t>(period)){
+        throw std::invalid_argument("StreamingIndicators.cpp @ StreamingWMA::restore: snapshot of a different period");
+    }
+    this->state = state;
+}
+
+//STREAMING TRUE RANGE
+StreamingTrueRange::StreamingTrueRange(){
+    reset();
+}
+
+bool StreamingTrueRange::update(double high, double low, double close){
+    if(state.count > 0){
+        double highLowRange     = high - low;
+        double absHighPrevClose = std::abs(high - state.previousClose);
+        double absLowPrevClose  = std::abs(low - state.previousClose);
+        state.trueRange = std::max({highLowRange, absHighPrevClose, absLowPrevClose});
+    }
+    state.previousClose = close;
+    state.count++;
+    return isReady();
+}
+
+double StreamingTrueRange::value() const{
+    return state.trueRange;
+}
+
+bool StreamingTrueRange::isReady() const{
+    //the first bar has no previous close
+    return state.count > 1;
+}
+
+void StreamingTrueRange::reset(){
+    state.previousClose = 0.0;
+    state.trueRange = 0.0;
+    state.count = 0;
+}
+
+StreamingTrueRange::State StreamingTrueRange::snapshot() const{
+    return state;
+}
+
+void StreamingTrueRange::restore(const State& state){
+    this->state = state;
+}
+
+//STREAMING ATR
+StreamingATR::StreamingATR(int period) : period(period){
+    if(period <= 0){
+        throw std::invalid_argument("StreamingIndicators.cpp @ StreamingATR: 'period' must be positive");
+    }
+    reset();
+}
+
+bool StreamingATR::update(double high, double low, double close){
+    if(!trueRange.update(high, low, close)){
+        return false;
+    }
+    double tr = trueRange.value();
+    state.count++;
+    if(state.count < static_cast<size_t>(period)){
+        state.sum += tr;
+    }
+    else if(state.count == static_cast<size_t>(period)){
+        state.sum += tr;
+        state.atr = state.sum / period;
+    }
+    else{
+        state.atr = (state.atr * (period - 1) + tr) / period;
+    }
+    return isReady();
+}
+
+double StreamingATR::value() const{
+    return state.atr;
+}
+
+bool StreamingATR::isReady() const{
+    return state.count >= static_cast<size_t>(period);
+}
+
+int StreamingATR::getPeriod() const{
+    return period;
+}
+
+void StreamingATR::reset(){
+    trueRange.reset();
+    state.sum = 0.0;
+    state.atr = 0.0;
+    state.count = 0;
+}
+
+StreamingATR::State StreamingATR::snapshot() const{
+    State snapshot = state;
+    snapshot.trueRange = trueRange.snapshot();
+    return snapshot;
+}
+
+void StreamingATR::restore(const State& state){
+    this->state = state;
+    trueRange.restore(state.trueRange);
+}
+
+//STREAMING CHAIKIN AD
+StreamingChaikinAD::StreamingChaikinAD(){
+    reset();
+}
+
+bool StreamingChaikinAD::update(double high, double low, double close, int64_t volume){
+    if(high == low){
+        throw std::runtime_error("StreamingIndicators.cpp @ StreamingChaikinAD::update: high and low values are equal resulting in division by 0");
+    }
+    //MFV = MFM * volume, MFM = ((close-low)-(high-close)) / (high-low)
+    double moneyFlowMultiplier = ((close - low) - (high - close)) / (high - low);
+    state.ad = state.ad + moneyFlowMultiplier * static_cast<double>(volume);
+    state.count++;
+    return true;
+}
+
+double StreamingChaikinAD::value() const{
+    return state.ad;
+}
+
+bool StreamingChaikinAD::isReady() const{
+    return state.count > 0;
+}
+
+void StreamingChaikinAD::reset(){
+    state.ad = 0.0;
+    state.count = 0;
+}
+
+StreamingChaikinAD::State StreamingChaikinAD::snapshot() const{
+    return state;
+}
+
+void StreamingChaikinAD::restore(const State& state){
+    this->state = state;
+}
+
+//STREAMING ADOSC
+StreamingADOSC::StreamingADOSC(int shortEMA, int longEMA) : shortEMA(shortEMA), longEMA(longEMA){
+    if(longEMA < shortEMA){
+        throw std::invalid_argument("StreamingIndicators.cpp @ StreamingADOSC: longEMA < shortEMA");
+    }
+}
+
+bool StreamingADOSC::update(double high, double low, double close, int64_t volume){
+    ad.update(high, low, close, volume);
+    shortEMA.update(ad.value());
+    longEMA.update(ad.value());
+    return isReady();
+}
+
+double StreamingADOSC::value() const{
+    return shortEMA.value() - longEMA.value();
+}
+
+bool StreamingADOSC::isReady() const{
+    return longEMA.isReady();
+}
+
+void StreamingADOSC::reset(){
+    ad.reset();
+    shortEMA.reset();
+    longEMA.reset();
+}
+
+StreamingADOSC::State StreamingADOSC::snapshot() const{
+    State state;
+    state.ad = ad.snapshot();
+    state.shortEMA = shortEMA.snapshot();
+    state.longEMA = longEMA.snapshot();
+    return state;
+}
+
+void StreamingADOSC::restore(const State& state){
+    ad.restore(state.ad);
+    shortEMA.restore(state.shortEMA);
+    longEMA.restore(state.longEMA);
+}
+
+#endif
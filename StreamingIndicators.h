@@ -0,0 +1,194 @@
+#ifndef STREAMINGINDICATORS_H
+#define STREAMINGINDICATORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief Streaming counterparts of the Analytics indicators. Each one keeps the state its formula needs and takes
+///        bars one at a time, oldest to newest, producing the next value in O(1) instead of recomputing the series.
+///        Fed the same bars, they give the values of the batch functions:
+///            StreamingEMA        Analytics::ExponentialMovingAverage (seeded with the SMA of the first 'period' values)
+///            StreamingSMA        Analytics::SimpleMovingAverage
+///            StreamingWMA        linearly weighted moving average, newest value weighted 'period'
+///            StreamingTrueRange  Analytics::TrueRange
+///            StreamingATR        Wilder's average true range, seeded with the SMA of the first 'period' true ranges
+///            StreamingChaikinAD  Analytics::ChaikinAD
+///            StreamingADOSC      Analytics::ADOSC
+///        value() is only meaningful once isReady() is true. snapshot()/restore() copy the whole state out and back,
+///        e.g. to evaluate a still forming bar and roll it back when the bar closes.
+///
+///        StreamingEMA ema(12);
+///        ColumnView<double> closes = analytics.getCloses();
+///        for(size_t i = closes.size(); i-- > 0;) ema.update(closes[i]);   //warm up on history, oldest first
+///        ema.update(newClose);                                              //then one call per new bar
+///        if(ema.isReady()) ema.value();
+
+/// @brief exponential moving average. k = 2 / (period + 1)
+class StreamingEMA{
+    public:
+        struct State{
+            double sum;      //running sum of the seed values
+            double ema;
+            size_t count;    //values seen
+        };
+
+        explicit StreamingEMA(int period);
+        /// @brief take the next value, returns isReady()
+        bool update(double value);
+        double value() const;
+        bool isReady() const;
+        int getPeriod() const;
+        void reset();
+        State snapshot() const;
+        void restore(const State& state);
+
+    private:
+        int period;
+        double k;
+        State state;
+};
+
+/// @brief simple moving average over the last 'period' values
+class StreamingSMA{
+    public:
+        struct State{
+            std::vector<double> window;  //ring buffer of the last 'period' values
+            size_t next;                 //slot the next value goes to
+            size_t count;
+            double sum;
+        };
+
+        explicit StreamingSMA(int period);
+        bool update(double value);
+        double value() const;
+        bool isReady() const;
+        int getPeriod() const;
+        void reset();
+        State snapshot() const;
+        void restore(const State& state);
+
+    private:
+        int period;
+        State state;
+};
+
+/// @brief weighted moving average over the last 'period' values, weights 1 (oldest) ... period (newest)
+///        WMA = sum(weight * value) / (period * (period + 1) / 2)
+class StreamingWMA{
+    public:
+        struct State{
+            std::vector<double> window;
+            size_t next;
+            size_t count;
+            double sum;          //plain sum of the window
+            double weightedSum;  //sum of weight * value over the window
+        };
+
+        explicit StreamingWMA(int period);
+        bool update(double value);
+        double value() const;
+        bool isReady() const;
+        int getPeriod() const;
+        void reset();
+        State snapshot() const;
+        void restore(const State& state);
+
+    private:
+        int period;
+        double divisor;
+        State state;
+};
+
+/// @brief true range, max(high - low, |high - previousClose|, |low - previousClose|). Not ready on the first bar
+class StreamingTrueRange{
+    public:
+        struct State{
+            double previousClose;
+            double trueRange;
+            size_t count;
+        };
+
+        StreamingTrueRange();
+        bool update(double high, double low, double close);
+        double value() const;
+        bool isReady() const;
+        void reset();
+        State snapshot() const;
+        void restore(const State& state);
+
+    private:
+        State state;
+};
+
+/// @brief average true range with Wilder's smoothing, ATR = (ATRprevious * (period - 1) + TR) / period
+class StreamingATR{
+    public:
+        struct State{
+            StreamingTrueRange::State trueRange;
+            double sum;      //running sum of the seed true ranges
+            double atr;
+            size_t count;    //true ranges seen
+        };
+
+        explicit StreamingATR(int period);
+        bool update(double high, double low, double close);
+        double value() const;
+        bool isReady() const;
+        int getPeriod() const;
+        void reset();
+        State snapshot() const;
+        void restore(const State& state);
+
+    private:
+        int period;
+        StreamingTrueRange trueRange;
+        State state;
+};
+
+/// @brief Chaikin A/D line, ADcurrent = ADprevious + MFVcurrent, accumulated from the first bar fed.
+///        Like Analytics::MoneyFlowMultiplier, a bar with high == low throws std::runtime_error; the state is left untouched
+class StreamingChaikinAD{
+    public:
+        struct State{
+            double ad;
+            size_t count;
+        };
+
+        StreamingChaikinAD();
+        bool update(double high, double low, double close, int64_t volume);
+        double value() const;
+        bool isReady() const;
+        void reset();
+        State snapshot() const;
+        void restore(const State& state);
+
+    private:
+        State state;
+};
+
+/// @brief Chaikin A/D oscillator, EMA(AD, shortEMA) - EMA(AD, longEMA). Ready once 'longEMA' bars were fed
+class StreamingADOSC{
+    public:
+        struct State{
+            StreamingChaikinAD::State ad;
+            StreamingEMA::State shortEMA;
+            StreamingEMA::State longEMA;
+        };
+
+        /// @brief throws std::invalid_argument if longEMA < shortEMA
+        StreamingADOSC(int shortEMA, int longEMA);
+        bool update(double high, double low, double close, int64_t volume);
+        double value() const;
+        bool isReady() const;
+        void reset();
+        State snapshot() const;
+        void restore(const State& state);
+
+    private:
+        StreamingChaikinAD ad;
+        StreamingEMA shortEMA;
+        StreamingEMA longEMA;
+};
+
+#endif
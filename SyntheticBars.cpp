@@ -0,0 +1,39 @@
+#ifndef SYNTHETICBARS_CPP
+#define SYNTHETICBARS_CPP
+#include "SyntheticBars.h"
+
+//splitmix64, one 64 bit state word, passes BigCrush. Plenty for prices that only need to look like prices
+static uint64_t NextRandom(uint64_t& state){
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+//uniform in [0, 1), the top 53 bits scaled exactly
+static double NextUniform(uint64_t& state){
+    return static_cast<double>(NextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void SyntheticBars::Generate(BarStore& bars, size_t count, uint64_t seed, int64_t newestTime, int64_t spacing){
+    bars.clear();
+    bars.reserve(count);
+    bars.setHasTimeOfDay(true);
+    uint64_t state = seed;
+    //the walk runs from the newest bar back, so bars can be appended in store order: a bar's open is the close
+    //of the bar before it (the next one appended)
+    double close = 100.0;
+    for(size_t i = 0; i < count; i++){
+        double change = (NextUniform(state) - 0.5) * 0.002;
+        double open = close / (1.0 + change);
+        double top = open > close ? open : close;
+        double bottom = open > close ? close : open;
+        double high = top * (1.0 + NextUniform(state) * 0.001);
+        double low = bottom * (1.0 - NextUniform(state) * 0.001);
+        int64_t volume = 1000 + static_cast<int64_t>(NextUniform(state) * 100000.0);
+        bars.append(newestTime - static_cast<int64_t>(i) * spacing, open, high, low, close, volume);
+        close = open;
+    }
+}
+
+#endif
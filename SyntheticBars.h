@@ -0,0 +1,26 @@
+#ifndef SYNTHETICBARS_H
+#define SYNTHETICBARS_H
+
+#include "BarStore.h"
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Deterministic synthetic OHLCV bars, for benchmarks (bench.cpp) and offline runs without the API.
+///        The same (count, seed) gives the same bars bit for bit on every platform and compiler: the random numbers come
+///        from a splitmix64 generator of its own, not from <random> distributions (their output is implementation defined).
+///
+///        Closes follow a random walk of small relative returns. A bar opens at the previous bar's close, its high and low
+///        bracket the open and close, volumes are spread over 1000-101000. Bars are evenly spaced, sessions are not modeled.
+///
+///        BarStore bars;
+///        SyntheticBars::Generate(bars, 1000000);
+class SyntheticBars{
+    public:
+        /// @brief replace the content of 'bars' with 'count' bars, newest first like every other store
+        /// @param seed different seeds give unrelated series
+        /// @param newestTime epoch seconds of the newest bar
+        /// @param spacing seconds between two bars
+        static void Generate(BarStore& bars, size_t count, uint64_t seed = 1, int64_t newestTime = 1712678340, int64_t spacing = 60);
+};
+
+#endif
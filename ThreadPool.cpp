@@ -0,0 +1,219 @@
+#ifndef THREADPOOL_CPP
+#define THREADPOOL_CPP
+#include "ThreadPool.h"
+
+#include <stdexcept>
+
+//pool and worker index of the calling thread, so a task that submits more work keeps it on its own deque
+static thread_local ThreadPool *currentPool = nullptr;
+static thread_local size_t currentWorker = 0;
+
+ThreadPool::ThreadPool(size_t threads) : nextWorker(0), queued(0), unfinished(0), helpers(0), stopping(false){
+    if(threads == 0){
+        threads = std::thread::hardware_concurrency();
+    }
+    if(threads == 0){
+        threads = 1;
+    }
+    for(size_t i = 0; i < threads; i++){
+        workers.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+    for(size_t i = 0; i < threads; i++){
+        this->threads.push_back(std::thread(&ThreadPool::Run, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for(size_t i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task){
+    Task queuedTask = {std::move(task), nullptr};
+    Enqueue(std::move(queuedTask));
+}
+
+void ThreadPool::Enqueue(Task task){
+    size_t target = currentPool == this ? currentWorker : nextWorker++ % workers.size();
+    bool wakeHelpers;
+    {
+        //counted under the same lock the workers wait on, so no wake up is lost
+        std::lock_guard<std::mutex> guard(stateLock);
+        if(task.batch != nullptr){
+            task.batch->unfinished++;
+            task.batch->queued++;
+        }
+        {
+            std::lock_guard<std::mutex> workerGuard(workers[target]->lock);
+            workers[target]->tasks.push_back(std::move(task));
+        }
+        queued++;
+        unfinished++;
+        wakeHelpers = helpers > 0;
+    }
+    workAvailable.notify_one();
+    if(wakeHelpers){
+        allDone.notify_all();
+    }
+}
+
+void ThreadPool::wait(){
+    if(currentPool == this){
+        throw std::runtime_error("ThreadPool.cpp @ wait: called from a task of this pool, it would wait for itself. Use a Batch");
+    }
+    std::unique_lock<std::mutex> guard(stateLock);
+    allDone.wait(guard, [this]{ return unfinished == 0; });
+    if(firstError){
+        std::exception_ptr error = firstError;
+        firstError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+size_t ThreadPool::getThreadCount() const{
+    return threads.size();
+}
+
+bool ThreadPool::TakeOf(const Batch *batch, size_t index, Task& task){
+    //newest first on the own deque, oldest first elsewhere, like Take
+    for(size_t offset = 0; offset < workers.size(); offset++){
+        Worker& worker = *workers[(index + offset) % workers.size()];
+        std::lock_guard<std::mutex> guard(worker.lock);
+        for(size_t i = 0; i < worker.tasks.size(); i++){
+            size_t position = offset == 0 ? worker.tasks.size() - 1 - i : i;
+            if(worker.tasks[position].batch == batch){
+                task = std::move(worker.tasks[position]);
+                worker.tasks.erase(worker.tasks.begin() + position);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::Take(size_t index, Task& task){
+    {
+        std::lock_guard<std::mutex> guard(workers[index]->lock);
+        if(!workers[index]->tasks.empty()){
+            task = std::move(workers[index]->tasks.back());
+            workers[index]->tasks.pop_back();
+            return true;
+        }
+    }
+    //steal from the other end, starting with the next worker so thieves spread out
+    for(size_t offset = 1; offset < workers.size(); offset++){
+        Worker& victim = *workers[(index + offset) % workers.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if(!victim.tasks.empty()){
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::Run(size_t index){
+    currentPool = this;
+    currentWorker = index;
+    while(true){
+        Task task;
+        if(Take(index, task)){
+            Execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(stateLock);
+        workAvailable.wait(guard, [this]{ return queued > 0 || stopping; });
+        if(stopping && queued == 0){
+            return;
+        }
+    }
+}
+
+void ThreadPool::Execute(Task& task){
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        queued--;
+        if(task.batch != nullptr){
+            task.batch->queued--;
+        }
+    }
+    std::exception_ptr error;
+    try{
+        task.run();
+    }
+    catch(...){
+        error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> guard(stateLock);
+    //the batch may be gone as soon as the lock is released, it is not touched after that
+    std::exception_ptr& slot = task.batch != nullptr ? task.batch->firstError : firstError;
+    if(error && !slot){
+        slot = error;
+    }
+    bool batchDone = task.batch != nullptr && --task.batch->unfinished == 0;
+    if(--unfinished == 0 || batchDone){
+        allDone.notify_all();
+    }
+}
+
+ThreadPool::Batch::Batch(ThreadPool& pool) : pool(pool), unfinished(0), queued(0) {}
+
+ThreadPool::Batch::~Batch(){
+    try{
+        wait();
+    }
+    catch(...){
+    }
+}
+
+void ThreadPool::Batch::submit(std::function<void()> task){
+    Task queuedTask = {std::move(task), this};
+    pool.Enqueue(std::move(queuedTask));
+}
+
+void ThreadPool::Batch::wait(){
+    //only tasks of this batch are run here: an unrelated task could be long, or wait for this very thread.
+    //A worker looks on its own deque first, where the tasks it submitted are
+    size_t index = currentPool == &pool ? currentWorker : 0;
+    std::unique_lock<std::mutex> guard(pool.stateLock);
+    while(unfinished > 0){
+        if(queued > 0){
+            guard.unlock();
+            Task task;
+            if(pool.TakeOf(this, index, task)){
+                //run as a worker of 'pool' would, so what the task submits or waits for is handled the same way
+                ThreadPool *outerPool = currentPool;
+                size_t outerWorker = currentWorker;
+                currentPool = &pool;
+                currentWorker = index;
+                pool.Execute(task);
+                currentPool = outerPool;
+                currentWorker = outerWorker;
+            }
+            else{
+                //counted but not on a deque yet or any more, the taker updates 'queued' right after
+                std::this_thread::yield();
+            }
+            guard.lock();
+            continue;
+        }
+        //the rest of the batch is running on other threads
+        pool.helpers++;
+        pool.allDone.wait(guard, [this]{ return unfinished == 0 || queued > 0; });
+        pool.helpers--;
+    }
+    if(firstError){
+        std::exception_ptr error = firstError;
+        firstError = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+#endif
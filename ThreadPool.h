@@ -0,0 +1,104 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Fixed size thread pool with work stealing. Every worker has its own task deque: it runs its newest task first
+///        (cache warm), and when it runs dry it steals the oldest task of another worker, so a worker that drew a few
+///        slow symbols does not leave the others idle at the end of a scan.
+///
+///        Work that has to be waited for goes into a Batch: waiting on it covers only its own tasks, and the waiting
+///        thread runs the batch's queued tasks meanwhile instead of blocking, so a task may itself submit a batch and
+///        wait for it.
+///
+///        ThreadPool pool;                       //one worker per core
+///        ThreadPool::Batch batch(pool);
+///        for(...) batch.submit([&, i]{ work(i); });
+///        batch.wait();                          //rethrows the first exception a task of the batch threw
+class ThreadPool{
+    public:
+        /// @brief tasks submitted together and waited for together, independently of everything else in the pool.
+        ///        Destroying an unfinished batch waits for its tasks (their exceptions are dropped then)
+        class Batch{
+            public:
+                explicit Batch(ThreadPool& pool);
+                ~Batch();
+
+                Batch(const Batch&) = delete;
+                Batch& operator=(const Batch&) = delete;
+
+                /// @brief queue a task on the pool as part of this batch
+                void submit(std::function<void()> task);
+                /// @brief return once every task of this batch has finished, running its queued tasks on the calling
+                ///        thread until then. Safe from inside a task of the same pool. Rethrows the first exception a task
+                ///        of this batch threw
+                void wait();
+
+            private:
+                friend class ThreadPool;
+                ThreadPool& pool;
+                size_t unfinished;                  //guarded by the pool's stateLock
+                size_t queued;                      //not taken from a deque yet
+                std::exception_ptr firstError;
+        };
+
+        /// @param threads number of workers, 0 = std::thread::hardware_concurrency()
+        explicit ThreadPool(size_t threads = 0);
+        /// @brief finishes the queued tasks, then joins the workers
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// @brief queue a task. Called from a worker it goes to that worker's own deque, otherwise round robin
+        void submit(std::function<void()> task);
+        /// @brief block until every submitted task has finished, batches included. If a task outside a batch threw, the
+        ///        first exception is rethrown here. Throws std::runtime_error when called from a task of this pool, which
+        ///        would wait for itself (use a Batch there)
+        void wait();
+
+        size_t getThreadCount() const;
+
+    private:
+        struct Task{
+            std::function<void()> run;
+            Batch *batch;                   //nullptr for a plain submit
+        };
+        struct Worker{
+            std::mutex lock;
+            std::deque<Task> tasks;
+        };
+
+        void Enqueue(Task task);
+        void Run(size_t index);
+        /// @brief own newest task, else the oldest task of another worker
+        bool Take(size_t index, Task& task);
+        /// @brief a task of 'batch', looked for on worker 'index' first
+        bool TakeOf(const Batch *batch, size_t index, Task& task);
+        /// @brief run a task taken from a deque and count it finished
+        void Execute(Task& task);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<std::thread> threads;
+        std::atomic<size_t> nextWorker;   //round robin target of outside submits
+
+        std::mutex stateLock;             //guards the counters below together with the condition variables
+        std::condition_variable workAvailable;
+        std::condition_variable allDone;
+        size_t queued;                    //submitted, not taken yet
+        size_t unfinished;                //submitted, not finished yet
+        size_t helpers;                   //threads in Batch::wait sleeping on allDone, woken by submits as well
+        bool stopping;
+        std::exception_ptr firstError;
+};
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef TIMESERIESPARSER_CPP
+#define TIMESERIESPARSER_CPP
+#include "TimeSeriesParser.h"
+#include "EpochTime.h"
+#include "Metrics.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+TimeSeriesParser::TimeSeriesParser(BarStore *bars)
+    : bars(bars), lexer(LEX_DEFAULT), unicodeLeft(0), tokenIsKey(false), depth(0), expectKey(false),
+      currentKey(FIELD_NONE), scratchLength(0), valuesDepth(0), sawValues(false),
+      barTime(0), barOpen(0.0), barHigh(0.0), barLow(0.0), barClose(0.0), barVolume(0),
+      barHasTime(false), barTimeOfDay(true), barPrices(0), barCount(0), apiError(false), malformed(false), parseTicks(0) {
+    scratch[0] = '\0';
+}
+
+void TimeSeriesParser::feed(const char *data, size_t length){
+    if(!Metrics::IsEnabled()){
+        consume(data, length);
+        return;
+    }
+    //only the time spent in here counts, not the waits for the network between chunks
+    uint64_t start = Metrics::Ticks();
+    consume(data, length);
+    parseTicks += Metrics::Ticks() - start;
+}
+
+void TimeSeriesParser::consume(const char *data, size_t length){
+    for(size_t i = 0; i < length && !malformed; i++){
+        char c = data[i];
+        switch(lexer){
+            case LEX_STRING:
+                if(c == '"'){
+                    lexer = LEX_DEFAULT;
+                    if(tokenIsKey){
+                        onKey();
+                    }
+                    else{
+                        onScalar(true);
+                    }
+                }
+                else if(c == '\\'){
+                    lexer = LEX_ESCAPE;
+                }
+                else{
+                    appendScratch(c);
+                }
+                continue;
+            case LEX_ESCAPE:
+                //none of the fields we keep use escapes, keep the common ones readable for error messages
+                if(c == 'u'){
+                    lexer = LEX_UNICODE;
+                    unicodeLeft = 4;
+                    appendScratch('?');
+                    continue;
+                }
+                appendScratch(c == 'n' ? '\n' : c == 't' ? '\t' : c);
+                lexer = LEX_STRING;
+                continue;
+            case LEX_UNICODE:
+                if(--unicodeLeft == 0){
+                    lexer = LEX_STRING;
+                }
+                continue;
+            case LEX_LITERAL:
+                if(c != ',' && c != '}' && c != ']' && c != ' ' && c != '\t' && c != '\r' && c != '\n'){
+                    appendScratch(c);
+                    continue;
+                }
+                lexer = LEX_DEFAULT;
+                onScalar(false);
+                //the delimiter still has to be handled below
+                break;
+            case LEX_DEFAULT:
+                break;
+        }
+
+        switch(c){
+            case ' ': case '\t': case '\r': case '\n':
+                break;
+            case '{': case '[':
+                onOpen(c);
+                break;
+            case '}': case ']':
+                onClose(c);
+                break;
+            case ':':
+                expectKey = false;
+                break;
+            case ',':
+                expectKey = (depth > 0 && containers[depth - 1] == '{');
+                break;
+            case '"':
+                lexer = LEX_STRING;
+                tokenIsKey = expectKey;
+                scratchLength = 0;
+                break;
+            default:
+                lexer = LEX_LITERAL;
+                tokenIsKey = false;
+                scratchLength = 0;
+                appendScratch(c);
+                break;
+        }
+    }
+}
+
+void TimeSeriesParser::finish(){
+    static const Metrics::Stage STAGE_PARSE = Metrics::Register("parse_time_series");
+    if(parseTicks > 0){
+        Metrics::Record(STAGE_PARSE, Metrics::ToNanoseconds(parseTicks));
+    }
+    //a bare literal at the very end of the input has no delimiter after it
+    if(lexer == LEX_LITERAL && !malformed){
+        lexer = LEX_DEFAULT;
+        onScalar(false);
+    }
+    if(apiError){
+        throw std::runtime_error("TimeSeriesParser.cpp @ finish: API returned an error: " + errorMessage);
+    }
+    if(malformed){
+        throw std::runtime_error("TimeSeriesParser.cpp @ finish: malformed time_series response: " + errorMessage);
+    }
+    if(depth != 0 || lexer != LEX_DEFAULT){
+        throw std::runtime_error("TimeSeriesParser.cpp @ finish: time_series response ended early");
+    }
+    if(!sawValues){
+        throw std::runtime_error("TimeSeriesParser.cpp @ finish: response has no 'values' array");
+    }
+}
+
+size_t TimeSeriesParser::getBarCount() const{
+    return barCount;
+}
+
+void TimeSeriesParser::appendScratch(char c){
+    //longer tokens are truncated, none of the fields we read come close
+    if(scratchLength < SCRATCH_SIZE - 1){
+        scratch[scratchLength++] = c;
+    }
+}
+
+void TimeSeriesParser::fail(const char *reason){
+    //the first reason is the one to report, the delimiter after a bad literal is still handled in the same step
+    if(malformed){
+        return;
+    }
+    malformed = true;
+    errorMessage = reason;
+}
+
+void TimeSeriesParser::onOpen(char bracket){
+    if(depth == MAX_DEPTH){
+        fail("nesting too deep");
+        return;
+    }
+    bool isArray = (bracket == '[');
+    if(isArray && depth == 1 && currentKey == FIELD_VALUES){
+        valuesDepth = depth + 1;
+        sawValues = true;
+    }
+    else if(!isArray && valuesDepth != 0 && depth == valuesDepth){
+        //a new bar starts
+        barTime = 0;
+        barOpen = barHigh = barLow = barClose = 0.0;
+        barVolume = 0;
+        barHasTime = false;
+        barPrices = 0;
+    }
+    containers[depth++] = bracket;
+    expectKey = !isArray;
+    currentKey = FIELD_NONE;
+}
+
+void TimeSeriesParser::onClose(char bracket){
+    if(depth == 0 || containers[depth - 1] != (bracket == '}' ? '{' : '[')){
+        fail("unbalanced brackets");
+        return;
+    }
+    depth--;
+    if(bracket == '}' && valuesDepth != 0 && depth == valuesDepth){
+        //a bar ends
+        if(!barHasTime){
+            fail("bar without a datetime field");
+            return;
+        }
+        //volume may be missing (forex symbols have none), a price may not
+        if(barPrices != ALL_PRICES){
+            fail("bar without an open, high, low or close field");
+            return;
+        }
+        bars->setHasTimeOfDay(barTimeOfDay);
+        bars->append(barTime, barOpen, barHigh, barLow, barClose, barVolume);
+        barCount++;
+    }
+    else if(bracket == ']' && depth + 1 == valuesDepth){
+        valuesDepth = 0;
+    }
+    expectKey = false;
+}
+
+void TimeSeriesParser::onPrice(double& price, int bit){
+    char *end;
+    price = std::strtod(scratch, &end);
+    //a null, an empty string or trailing text is not a price
+    if(scratchLength == 0 || end != scratch + scratchLength){
+        fail("price is not a number");
+        return;
+    }
+    barPrices |= bit;
+}
+
+void TimeSeriesParser::onKey(){
+    scratch[scratchLength] = '\0';
+    currentKey = FIELD_NONE;
+    if(depth == 1){
+        if(std::strcmp(scratch, "values") == 0) currentKey = FIELD_VALUES;
+        else if(std::strcmp(scratch, "status") == 0) currentKey = FIELD_STATUS;
+        else if(std::strcmp(scratch, "message") == 0) currentKey = FIELD_MESSAGE;
+    }
+    else if(valuesDepth != 0 && depth == valuesDepth + 1){
+        if(std::strcmp(scratch, "datetime") == 0) currentKey = FIELD_DATETIME;
+        else if(std::strcmp(scratch, "open") == 0) currentKey = FIELD_OPEN;
+        else if(std::strcmp(scratch, "high") == 0) currentKey = FIELD_HIGH;
+        else if(std::strcmp(scratch, "low") == 0) currentKey = FIELD_LOW;
+        else if(std::strcmp(scratch, "close") == 0) currentKey = FIELD_CLOSE;
+        else if(std::strcmp(scratch, "volume") == 0) currentKey = FIELD_VOLUME;
+    }
+}
+
+void TimeSeriesParser::onScalar(bool isString){
+    scratch[scratchLength] = '\0';
+    switch(currentKey){
+        case FIELD_DATETIME:
+            if(!EpochTime::Parse(scratch, scratchLength, barTime)){
+                fail("datetime is not in the form YYYY-MM-DD[ HH:MM:SS]");
+                return;
+            }
+            barHasTime = true;
+            barTimeOfDay = (scratchLength > 10);
+            break;
+        //the API sends prices and volume as strings, convert them here, once
+        case FIELD_OPEN:   onPrice(barOpen, 1); break;
+        case FIELD_HIGH:   onPrice(barHigh, 2); break;
+        case FIELD_LOW:    onPrice(barLow, 4); break;
+        case FIELD_CLOSE:  onPrice(barClose, 8); break;
+        case FIELD_VOLUME:{
+            //an integer, a fractional part (some crypto volumes) is dropped
+            char *end;
+            errno = 0;
+            barVolume = std::strtoll(scratch, &end, 10);
+            if(*end == '.'){
+                do{
+                    end++;
+                } while(*end >= '0' && *end <= '9');
+            }
+            if(scratchLength == 0 || end != scratch + scratchLength || errno == ERANGE){
+                fail("volume is not a number");
+            }
+            break;
+        }
+        case FIELD_STATUS:
+            if(isString && std::strcmp(scratch, "error") == 0){
+                apiError = true;
+            }
+            break;
+        case FIELD_MESSAGE:
+            errorMessage.assign(scratch, scratchLength);
+            break;
+        default:
+            break;
+    }
+}
+
+#endif
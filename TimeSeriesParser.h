@@ -0,0 +1,85 @@
+#ifndef TIMESERIESPARSER_H
+#define TIMESERIESPARSER_H
+
+#include "BarStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @brief Streaming parser for the TwelveData time_series payload.
+///        Bytes are fed in whatever chunks curl hands over (see Parse::StreamCallBack), no DOM is built and
+///        each bar is converted to numbers and appended to the BarStore as soon as its object closes.
+///        Tokens are collected in a fixed scratch buffer, so parsing a bar allocates nothing.
+///        With Metrics enabled, the time spent parsing one response is recorded as stage "parse_time_series". Parsing and
+///        filling the store are one pass, so that time includes the appends.
+///
+///        {"meta":{...},"values":[{"datetime":"2024-04-08 15:55:00","open":"168.49","high":...,"volume":"2464327"},...],"status":"ok"}
+class TimeSeriesParser{
+    public:
+        /// @param bars store the parsed bars are appended to, in document order (newest first). Not owned.
+        explicit TimeSeriesParser(BarStore *bars);
+
+        /// @brief consume the next chunk of the response. Never throws (safe to call from a curl callback);
+        ///        malformed input is remembered and reported by finish()
+        void feed(const char *data, size_t length);
+        /// @brief call once after the last chunk.
+        ///        Throws std::runtime_error if the document was malformed or incomplete (including a bar missing its
+        ///        datetime, open, high, low or close, or a price or volume that is not a number), had no 'values' array,
+        ///        or the API answered with an error payload. Volume is optional, a bar without one gets 0
+        void finish();
+
+        /// @brief number of bars appended to the store so far
+        size_t getBarCount() const;
+
+    private:
+        enum Lexer { LEX_DEFAULT, LEX_STRING, LEX_ESCAPE, LEX_UNICODE, LEX_LITERAL };
+        enum Field { FIELD_NONE, FIELD_DATETIME, FIELD_OPEN, FIELD_HIGH, FIELD_LOW, FIELD_CLOSE, FIELD_VOLUME,
+                     FIELD_VALUES, FIELD_STATUS, FIELD_MESSAGE };
+
+        static const int MAX_DEPTH = 32;
+        static const size_t SCRATCH_SIZE = 256;
+        static const int ALL_PRICES = 15;   //barPrices once open (1), high (2), low (4) and close (8) were read
+
+        /// @brief the lexer and parser behind feed()
+        void consume(const char *data, size_t length);
+        void onKey();
+        void onScalar(bool isString);
+        /// @brief scratch --> 'price', marks 'bit' of barPrices as read. fail()s unless the whole token is a number
+        void onPrice(double& price, int bit);
+        void onOpen(char bracket);
+        void onClose(char bracket);
+        void appendScratch(char c);
+        void fail(const char *reason);
+
+        BarStore *bars;
+
+        Lexer lexer;
+        int unicodeLeft;            //hex digits left in a \uXXXX escape
+        bool tokenIsKey;            //string being read is an object key
+        char containers[MAX_DEPTH]; //'{' or '[' for every open container
+        int depth;
+        bool expectKey;             //inside an object, the next string is a key
+        Field currentKey;           //meaning of the last key read at the current depth
+
+        char scratch[SCRATCH_SIZE];
+        size_t scratchLength;
+
+        int valuesDepth;            //depth of the 'values' array, 0 when not inside it
+        bool sawValues;
+
+        //bar currently being read
+        int64_t barTime;
+        double barOpen, barHigh, barLow, barClose;
+        int64_t barVolume;
+        bool barHasTime;
+        bool barTimeOfDay;
+        int barPrices;              //prices of the bar read so far, see ALL_PRICES
+
+        size_t barCount;
+        bool apiError;
+        std::string errorMessage;
+        bool malformed;
+        uint64_t parseTicks;        //time spent in feed() (lexing, number conversion and BarStore appends), see Metrics.h
+};
+
+#endif
@@ -0,0 +1,359 @@
+//Micro benchmarks for the Analytics kernels and the time series getters, on deterministic synthetic bars (SyntheticBars.h).
+//No network for these: every run sees the same bars, so numbers of two builds can be compared directly.
+//
+//  make bench && ./bench [--filter=NAME] [--max-bars=N] [--min-time=SECONDS] [--repetitions=N] [--csv]
+//  ./bench --fetch=REQUESTS [--fetch-bars=N] [--metrics=FILE]
+//
+//Every benchmark runs at 100, 1k, 10k, 100k, 1M and 10M bars (up to --max-bars). One measurement repeats the benchmark
+//until it ran for --min-time seconds; the median of --repetitions measurements is reported as ns per bar and Mbars/s,
+//next to the heap allocations (and bytes) one call makes.
+//--fetch measures fetch + parse + indicator end to end instead: REQUESTS time series requests of --fetch-bars bars each,
+//against the server in TWELVEDATA_BASE_URL with the key in TWELVEDATA_API_KEY, e.g. the local stand-in replay/mock_twelvedata.py.
+//--metrics turns on the per stage latency histograms (Metrics.h) and writes them to FILE in Prometheus text format
+//(FILE ending in .json: as JSON) when the run is done.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <string>
+#include <vector>
+#include "Analytics.h"
+#include "Metrics.h"
+#include "SyntheticBars.h"
+
+//ALLOCATION COUNTING. Every operator new of the process goes through here, the benchmarks run on one thread
+
+static size_t allocationCount = 0;
+static size_t allocationBytes = 0;
+
+static void *CountedAllocate(size_t size){
+    allocationCount++;
+    allocationBytes += size;
+    void *memory = std::malloc(size == 0 ? 1 : size);
+    if(memory == nullptr){
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void *operator new(size_t size){
+    return CountedAllocate(size);
+}
+void *operator new[](size_t size){
+    return CountedAllocate(size);
+}
+void *operator new(size_t size, const std::nothrow_t&) noexcept{
+    try{
+        return CountedAllocate(size);
+    }
+    catch(...){
+        return nullptr;
+    }
+}
+void *operator new[](size_t size, const std::nothrow_t&) noexcept{
+    try{
+        return CountedAllocate(size);
+    }
+    catch(...){
+        return nullptr;
+    }
+}
+void operator delete(void *memory) noexcept{
+    std::free(memory);
+}
+void operator delete[](void *memory) noexcept{
+    std::free(memory);
+}
+void operator delete(void *memory, size_t) noexcept{
+    std::free(memory);
+}
+void operator delete[](void *memory, size_t) noexcept{
+    std::free(memory);
+}
+
+
+//BENCHMARKS
+
+//state shared by the benchmarks of one size, built once per size
+struct Fixture{
+    Analytics analytics;            //valuesTS holds the synthetic bars
+    std::vector<double> closes;     //close column as the vector the moving averages take
+    std::vector<double> output;     //one value per bar, for the kernels writing into a caller's buffer
+    size_t bars;
+};
+
+//runs the code under test once. Returns something derived from the result, so the call cannot be optimized away
+typedef double (*BenchFunction)(Fixture& fixture);
+
+struct Benchmark{
+    const char *name;
+    BenchFunction run;
+};
+
+static const int TIME_PERIOD = 14;
+
+static double BenchExponentialMovingAverage(Fixture& fixture){
+    return fixture.analytics.ExponentialMovingAverage(fixture.closes, TIME_PERIOD).front();
+}
+static double BenchSimpleMovingAverage(Fixture& fixture){
+    return fixture.analytics.SimpleMovingAverage(fixture.closes, TIME_PERIOD).front();
+}
+static double BenchWeightedMovingAverage(Fixture& fixture){
+    return fixture.analytics.WeightedMovingAverage(fixture.closes, TIME_PERIOD).front();
+}
+static double BenchTrueRange(Fixture& fixture){
+    return fixture.analytics.TrueRange(static_cast<int>(fixture.bars) - 1).front();
+}
+static double BenchChaikinAD(Fixture& fixture){
+    return fixture.analytics.ChaikinAD(static_cast<int>(fixture.bars)).back().second;
+}
+static double BenchADOSC(Fixture& fixture){
+    return fixture.analytics.ADOSC(static_cast<int>(fixture.bars) - 10, 3, 10).front().second;
+}
+//temporaries in the thread's ScratchArena and the output in the fixture's buffer: no allocation per call once warm
+static double BenchADOSCInto(Fixture& fixture){
+    fixture.analytics.ADOSC(static_cast<int>(fixture.bars) - 10, 3, 10, fixture.output.data());
+    return fixture.output.front();
+}
+//getters: every bar is read once
+static double BenchGetAllCloseTS(Fixture& fixture){
+    return static_cast<double>(fixture.analytics.getAllCloseTS().size());
+}
+static double BenchGetCloseTSAt(Fixture& fixture){
+    size_t length = 0;
+    for(size_t i = 0; i < fixture.bars; i++){
+        length += fixture.analytics.getCloseTSAt(static_cast<int>(i)).size();
+    }
+    return static_cast<double>(length);
+}
+static double BenchGetAllTimeStampTS(Fixture& fixture){
+    return static_cast<double>(fixture.analytics.getAllTimeStampTS().size());
+}
+//one hour range query per bar, each starting at a different bar
+static double BenchGetRangeTS(Fixture& fixture){
+    ColumnView<int64_t> timeStamps = fixture.analytics.valuesTS->getTimeStamps();
+    size_t found = 0;
+    for(size_t i = 0; i < fixture.bars; i++){
+        int64_t start = timeStamps[(i * 7919) % fixture.bars];
+        found += fixture.analytics.getRangeTS(start, start + 3600).size();
+    }
+    return static_cast<double>(found);
+}
+
+static const Benchmark BENCHMARKS[] = {
+    {"ExponentialMovingAverage", BenchExponentialMovingAverage},
+    {"SimpleMovingAverage", BenchSimpleMovingAverage},
+    {"WeightedMovingAverage", BenchWeightedMovingAverage},
+    {"TrueRange", BenchTrueRange},
+    {"ChaikinAD", BenchChaikinAD},
+    {"ADOSC", BenchADOSC},
+    {"ADOSC(out)", BenchADOSCInto},
+    {"getAllCloseTS", BenchGetAllCloseTS},
+    {"getCloseTSAt", BenchGetCloseTSAt},
+    {"getAllTimeStampTS", BenchGetAllTimeStampTS},
+    {"getRangeTS", BenchGetRangeTS},
+};
+
+static const size_t SIZES[] = {100, 1000, 10000, 100000, 1000000, 10000000};
+
+//seed of the synthetic bars, fixed so every run measures the same input
+static const uint64_t SEED = 20240409;
+
+
+//RUNNER
+
+struct Options{
+    std::string filter;     //run only benchmarks whose name contains this
+    size_t maxBars;
+    double minTime;
+    int repetitions;
+    bool csv;
+    size_t fetchRequests;   //0 runs the kernel benchmarks
+    size_t fetchBars;
+    std::string metricsFile;    //empty: no metrics
+};
+
+struct Measurement{
+    size_t iterations;
+    double nanosecondsPerBar;
+    size_t allocations;     //per call
+    size_t bytes;           //per call
+};
+
+static volatile double sink;
+
+static double Seconds(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static Measurement Measure(const Benchmark& benchmark, Fixture& fixture, const Options& options){
+    Measurement result;
+    //one warm up call, which also counts the allocations of a call
+    size_t countBefore = allocationCount, bytesBefore = allocationBytes;
+    sink = benchmark.run(fixture);
+    result.allocations = allocationCount - countBefore;
+    result.bytes = allocationBytes - bytesBefore;
+
+    std::vector<double> perBar;
+    for(int repetition = 0; repetition < options.repetitions; repetition++){
+        //double the iterations until one batch lasts min-time
+        size_t iterations = 1;
+        double elapsed;
+        while(true){
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            for(size_t i = 0; i < iterations; i++){
+                sink = benchmark.run(fixture);
+            }
+            elapsed = Seconds(start);
+            if(elapsed >= options.minTime){
+                break;
+            }
+            iterations *= 2;
+        }
+        result.iterations = iterations;
+        perBar.push_back(elapsed * 1e9 / (static_cast<double>(iterations) * fixture.bars));
+    }
+    std::sort(perBar.begin(), perBar.end());
+    result.nanosecondsPerBar = perBar[perBar.size() / 2];
+    return result;
+}
+
+//fetch + parse + ChaikinAD, one request after the other on one instance
+static void RunFetch(const Options& options){
+    Analytics analytics;
+    size_t failures = 0, bars = 0;
+    std::string firstError;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < options.fetchRequests; i++){
+        try{
+            analytics.setValuesTS("AAPL", "1min", std::to_string(options.fetchBars));
+            size_t size = analytics.valuesTS->size();
+            if(size > 0){
+                sink = analytics.ChaikinAD(static_cast<int>(size)).back().second;
+            }
+            bars += size;
+        }
+        catch(const std::exception& error){
+            if(failures++ == 0){
+                firstError = error.what();
+            }
+        }
+    }
+    double elapsed = Seconds(start);
+    std::printf("%zu requests (%zu failed) of %zu bars in %.3f s: %.1f requests/s, %.1f ns/bar, %.2f Mbar/s\n",
+                options.fetchRequests, failures, options.fetchBars, elapsed, options.fetchRequests / elapsed,
+                bars ? elapsed * 1e9 / bars : 0.0, bars / elapsed / 1e6);
+    if(failures > 0){
+        std::printf("first failure: %s\n", firstError.c_str());
+    }
+}
+
+//the benchmark table, every benchmark at every size
+static void RunKernels(const Options& options){
+    if(options.csv){
+        std::printf("benchmark,bars,iterations,ns_per_bar,mbars_per_s,allocs_per_call,bytes_per_call\n");
+    }
+    else{
+        std::printf("%-26s %10s %10s %12s %10s %12s %14s\n", "Benchmark", "Bars", "Iterations", "ns/bar", "Mbar/s", "allocs/call", "bytes/call");
+        std::printf("%s\n", std::string(100, '-').c_str());
+    }
+    for(size_t size : SIZES){
+        if(size > options.maxBars){
+            break;
+        }
+        Fixture fixture;
+        fixture.bars = size;
+        SyntheticBars::Generate(*fixture.analytics.valuesTS, size, SEED);
+        ColumnView<double> closes = fixture.analytics.valuesTS->getCloses();
+        fixture.closes.assign(closes.begin(), closes.end());
+        fixture.output.resize(size);
+
+        for(const Benchmark& benchmark : BENCHMARKS){
+            if(!options.filter.empty() && std::string(benchmark.name).find(options.filter) == std::string::npos){
+                continue;
+            }
+            Measurement result = Measure(benchmark, fixture, options);
+            double throughput = 1e3 / result.nanosecondsPerBar;
+            if(options.csv){
+                std::printf("%s,%zu,%zu,%.3f,%.3f,%zu,%zu\n", benchmark.name, size, result.iterations, result.nanosecondsPerBar,
+                            throughput, result.allocations, result.bytes);
+            }
+            else{
+                std::printf("%-26s %10zu %10zu %12.3f %10.2f %12zu %14zu\n", benchmark.name, size, result.iterations,
+                            result.nanosecondsPerBar, throughput, result.allocations, result.bytes);
+            }
+            std::fflush(stdout);
+        }
+    }
+}
+
+static bool ReadOption(const char *argument, const char *name, const char *& value){
+    size_t length = std::strlen(name);
+    if(std::strncmp(argument, name, length) != 0 || argument[length] != '='){
+        return false;
+    }
+    value = argument + length + 1;
+    return true;
+}
+
+int main(int argc, char **argv){
+    Options options;
+    options.maxBars = 10000000;
+    options.minTime = 0.2;
+    options.repetitions = 3;
+    options.csv = false;
+    options.fetchRequests = 0;
+    options.fetchBars = 5000;
+    for(int i = 1; i < argc; i++){
+        const char *value;
+        if(ReadOption(argv[i], "--filter", value)){
+            options.filter = value;
+        }
+        else if(ReadOption(argv[i], "--max-bars", value)){
+            options.maxBars = std::strtoull(value, nullptr, 10);
+        }
+        else if(ReadOption(argv[i], "--min-time", value)){
+            options.minTime = std::strtod(value, nullptr);
+        }
+        else if(ReadOption(argv[i], "--repetitions", value)){
+            options.repetitions = std::max(1, std::atoi(value));
+        }
+        else if(ReadOption(argv[i], "--fetch", value)){
+            options.fetchRequests = std::strtoull(value, nullptr, 10);
+        }
+        else if(ReadOption(argv[i], "--fetch-bars", value)){
+            options.fetchBars = std::strtoull(value, nullptr, 10);
+        }
+        else if(ReadOption(argv[i], "--metrics", value)){
+            options.metricsFile = value;
+        }
+        else if(std::strcmp(argv[i], "--csv") == 0){
+            options.csv = true;
+        }
+        else{
+            std::fprintf(stderr, "usage: %s [--filter=NAME] [--max-bars=N] [--min-time=SECONDS] [--repetitions=N] [--csv]\n"
+                                 "       %s --fetch=REQUESTS [--fetch-bars=N] [--metrics=FILE]\n", argv[0], argv[0]);
+            return 2;
+        }
+    }
+    Metrics::SetEnabled(!options.metricsFile.empty());
+    if(options.fetchRequests > 0){
+        RunFetch(options);
+    }
+    else{
+        RunKernels(options);
+    }
+    if(!options.metricsFile.empty()){
+        const std::string& file = options.metricsFile;
+        if(file.size() > 5 && file.compare(file.size() - 5, 5, ".json") == 0){
+            Metrics::WriteJSON(file);
+        }
+        else{
+            Metrics::WritePrometheus(file);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,1543 @@
+//Correctness checks for the indicator engines, on deterministic synthetic bars (SyntheticBars.h). Every engine is held
+//against a naive scalar implementation written out below, one obvious loop per formula with nothing shared with the
+//code under test.
+//
+//  make check            (builds ./checks and runs it)
+//  ./checks [--filter=NAME]
+//
+//Every failing comparison prints the check, the position and both values; the exit status is 1 when anything failed.
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "Analytics.h"
+#include "BarCache.h"
+#include "BarSnapshot.h"
+#include "CsvImporter.h"
+#include "EpochTime.h"
+#include "IndicatorScan.h"
+#include "IndicatorSession.h"
+#include "Parse.h"
+#include "PriceTransform.h"
+#include "RollingExtrema.h"
+#include "RollingMoments.h"
+#include "StreamingIndicators.h"
+#include "SyntheticBars.h"
+#include "ThreadPool.h"
+#include "TimeSeriesParser.h"
+
+//REPORTING
+
+static size_t failures = 0;
+
+//true when 'actual' is within 'tolerance' of 'expected', relative to the larger of the two (absolute below 1)
+static bool Near(double actual, double expected, double tolerance){
+    if(actual == expected){
+        return true;
+    }
+    if(std::isnan(actual) || std::isnan(expected)){
+        return std::isnan(actual) && std::isnan(expected);
+    }
+    double scale = std::max(1.0, std::max(std::abs(actual), std::abs(expected)));
+    return std::abs(actual - expected) <= tolerance * scale;
+}
+
+//compares actual[0 .. count) with expected[0 .. count), reports the first difference.
+//Tolerance 0 asks for the same bits, where any NaN matches any NaN (the payload is up to the instruction)
+static void ExpectNear(const char *check, const double *actual, const double *expected, size_t count, double tolerance){
+    for(size_t i = 0; i < count; i++){
+        bool same = tolerance == 0 ? std::memcmp(&actual[i], &expected[i], sizeof(double)) == 0
+                                     || (std::isnan(actual[i]) && std::isnan(expected[i]))
+                                   : Near(actual[i], expected[i], tolerance);
+        if(!same){
+            std::printf("FAIL %s: index %zu of %zu is %.17g, expected %.17g\n", check, i, count, actual[i], expected[i]);
+            failures++;
+            return;
+        }
+    }
+}
+
+static void Expect(const char *check, bool condition){
+    if(!condition){
+        std::printf("FAIL %s\n", check);
+        failures++;
+    }
+}
+
+//every column of 'actual' holds the bits of the same column of 'expected'
+static void ExpectSameBars(const char *check, const BarStore& actual, const BarStore& expected){
+    if(actual.size() != expected.size() || actual.hasTimeOfDay() != expected.hasTimeOfDay()){
+        std::printf("FAIL %s: %zu bars (time of day %d), expected %zu (time of day %d)\n", check, actual.size(),
+                    actual.hasTimeOfDay(), expected.size(), expected.hasTimeOfDay());
+        failures++;
+        return;
+    }
+    size_t count = actual.size();
+    bool same = std::equal(actual.getTimeStamps().begin(), actual.getTimeStamps().end(), expected.getTimeStamps().begin())
+                && std::equal(actual.getVolumes().begin(), actual.getVolumes().end(), expected.getVolumes().begin());
+    Expect(check, same);
+    ExpectNear(check, actual.getOpens().data(), expected.getOpens().data(), count, 0);
+    ExpectNear(check, actual.getHighs().data(), expected.getHighs().data(), count, 0);
+    ExpectNear(check, actual.getLows().data(), expected.getLows().data(), count, 0);
+    ExpectNear(check, actual.getCloses().data(), expected.getCloses().data(), count, 0);
+}
+
+
+//NAIVE IMPLEMENTATIONS. Newest first like the columns, output i covers values[i .. i + period - 1]
+
+static const double TOLERANCE = 1e-9;
+
+static std::vector<double> NaiveSMA(const std::vector<double>& values, int period){
+    std::vector<double> result(values.size() - period + 1);
+    for(size_t i = 0; i < result.size(); i++){
+        double sum = 0;
+        for(int j = 0; j < period; j++){
+            sum += values[i + j];
+        }
+        result[i] = sum / period;
+    }
+    return result;
+}
+
+static std::vector<double> NaiveEMA(const std::vector<double>& values, int period){
+    std::vector<double> result(values.size() - period + 1);
+    size_t oldest = result.size() - 1;
+    double ema = 0;
+    for(int j = 0; j < period; j++){
+        ema += values[oldest + j];
+    }
+    ema /= period;
+    result[oldest] = ema;
+    double k = 2.0 / (period + 1);
+    for(size_t i = oldest; i-- > 0;){
+        ema = values[i] * k + ema * (1 - k);
+        result[i] = ema;
+    }
+    return result;
+}
+
+//two pass moments of one window, x = 0 at the oldest value
+struct NaiveMoments{
+    double mean;
+    double variance;    //population
+    double slope;       //least squares of the values over x
+    double intercept;   //fit at x = 0
+};
+
+static NaiveMoments NaiveWindow(const double *newest, int period){
+    NaiveMoments moments;
+    double meanX = (period - 1) / 2.0, sum = 0;
+    for(int j = 0; j < period; j++){
+        sum += newest[j];
+    }
+    moments.mean = sum / period;
+    double squares = 0, products = 0, squaresX = 0;
+    for(int x = 0; x < period; x++){
+        double y = newest[period - 1 - x];
+        squares += (y - moments.mean) * (y - moments.mean);
+        products += (x - meanX) * (y - moments.mean);
+        squaresX += (x - meanX) * (x - meanX);
+    }
+    moments.variance = squares / period;
+    moments.slope = squaresX > 0 ? products / squaresX : 0;
+    moments.intercept = moments.mean - moments.slope * meanX;
+    return moments;
+}
+
+static double NaiveCorrelation(const double *a, const double *b, int period){
+    double meanA = 0, meanB = 0;
+    for(int j = 0; j < period; j++){
+        meanA += a[j];
+        meanB += b[j];
+    }
+    meanA /= period;
+    meanB /= period;
+    double products = 0, squaresA = 0, squaresB = 0;
+    for(int j = 0; j < period; j++){
+        products += (a[j] - meanA) * (b[j] - meanB);
+        squaresA += (a[j] - meanA) * (a[j] - meanA);
+        squaresB += (b[j] - meanB) * (b[j] - meanB);
+    }
+    return squaresA > 0 && squaresB > 0 ? products / std::sqrt(squaresA * squaresB) : 0;
+}
+
+static std::vector<double> NaiveWMA(const std::vector<double>& values, int period){
+    std::vector<double> result(values.size() - period + 1);
+    for(size_t i = 0; i < result.size(); i++){
+        double sum = 0, weights = 0;
+        for(int j = 0; j < period; j++){
+            sum += (period - j) * values[i + j];
+            weights += period - j;
+        }
+        result[i] = sum / weights;
+    }
+    return result;
+}
+
+//bar i against the close of bar i + 1, so one value less than bars
+static std::vector<double> NaiveTrueRange(const BarStore& bars){
+    std::vector<double> result(bars.size() - 1);
+    for(size_t i = 0; i < result.size(); i++){
+        double high = bars.getHighs()[i], low = bars.getLows()[i], previousClose = bars.getCloses()[i + 1];
+        result[i] = std::max(high - low, std::max(std::abs(high - previousClose), std::abs(low - previousClose)));
+    }
+    return result;
+}
+
+//Wilder: the oldest output is the mean of the oldest 'period' true ranges, then (ATR * (period - 1) + TR) / period
+static std::vector<double> NaiveATR(const BarStore& bars, int period){
+    std::vector<double> trueRange = NaiveTrueRange(bars);
+    std::vector<double> result(trueRange.size() - period + 1);
+    size_t oldest = result.size() - 1;
+    double atr = 0;
+    for(int j = 0; j < period; j++){
+        atr += trueRange[oldest + j];
+    }
+    atr /= period;
+    result[oldest] = atr;
+    for(size_t i = oldest; i-- > 0;){
+        atr = (atr * (period - 1) + trueRange[i]) / period;
+        result[i] = atr;
+    }
+    return result;
+}
+
+//accumulated from the oldest bar
+static std::vector<double> NaiveChaikinAD(const BarStore& bars){
+    std::vector<double> result(bars.size());
+    double ad = 0;
+    for(size_t i = bars.size(); i-- > 0;){
+        double high = bars.getHighs()[i], low = bars.getLows()[i], close = bars.getCloses()[i];
+        ad += ((close - low) - (high - close)) / (high - low) * static_cast<double>(bars.getVolumes()[i]);
+        result[i] = ad;
+    }
+    return result;
+}
+
+static std::vector<double> NaiveADOSC(const BarStore& bars, int shortEMA, int longEMA){
+    std::vector<double> ad = NaiveChaikinAD(bars);
+    std::vector<double> shortValues = NaiveEMA(ad, shortEMA), longValues = NaiveEMA(ad, longEMA);
+    std::vector<double> result(longValues.size());
+    for(size_t i = 0; i < result.size(); i++){
+        result[i] = shortValues[i] - longValues[i];
+    }
+    return result;
+}
+
+
+//CHECKS
+
+//the bars every check runs on
+struct Fixture{
+    Analytics analytics;            //valuesTS holds the synthetic bars
+    std::vector<double> closes;
+    size_t bars;
+};
+
+//bars of the fixture, enough for every period below several times over
+static const size_t BARS = 5000;
+static const uint64_t SEED = 20240409;
+
+typedef void (*CheckFunction)(Fixture& fixture);
+
+struct Check{
+    const char *name;
+    CheckFunction run;
+};
+
+static const int PERIODS[] = {1, 2, 14, 50};
+
+//feeds 'closes' oldest first to 'indicator', out[i] = value after bar i (NaN before ready)
+template<typename Indicator>
+static std::vector<double> StreamCloses(Indicator indicator, const std::vector<double>& closes){
+    std::vector<double> out(closes.size(), NAN);
+    for(size_t i = closes.size(); i-- > 0;){
+        if(indicator.update(closes[i])){
+            out[i] = indicator.value();
+        }
+    }
+    return out;
+}
+
+template<typename Indicator>
+static std::vector<double> StreamBars(Indicator indicator, const BarStore& bars){
+    std::vector<double> out(bars.size(), NAN);
+    for(size_t i = bars.size(); i-- > 0;){
+        if(indicator.update(bars.getHighs()[i], bars.getLows()[i], bars.getCloses()[i], bars.getVolumes()[i])){
+            out[i] = indicator.value();
+        }
+    }
+    return out;
+}
+
+//adapters to the one update signature of StreamBars
+struct TrueRangeBars{
+    StreamingTrueRange indicator;
+    bool update(double high, double low, double close, int64_t){ return indicator.update(high, low, close); }
+    double value() const{ return indicator.value(); }
+};
+struct ATRBars{
+    StreamingATR indicator;
+    explicit ATRBars(int period) : indicator(period) {}
+    bool update(double high, double low, double close, int64_t){ return indicator.update(high, low, close); }
+    double value() const{ return indicator.value(); }
+};
+
+static void CheckStreamingMovingAverages(Fixture& fixture){
+    for(int period : PERIODS){
+        std::vector<double> sma = StreamCloses(StreamingSMA(period), fixture.closes);
+        std::vector<double> ema = StreamCloses(StreamingEMA(period), fixture.closes);
+        std::vector<double> wma = StreamCloses(StreamingWMA(period), fixture.closes);
+        std::vector<double> expected = NaiveSMA(fixture.closes, period);
+        ExpectNear("StreamingSMA vs naive", sma.data(), expected.data(), expected.size(), TOLERANCE);
+        Expect("StreamingSMA not ready early", period == 1 || std::isnan(sma[expected.size()]));
+        expected = NaiveEMA(fixture.closes, period);
+        ExpectNear("StreamingEMA vs naive", ema.data(), expected.data(), expected.size(), TOLERANCE);
+        expected = NaiveWMA(fixture.closes, period);
+        ExpectNear("StreamingWMA vs naive", wma.data(), expected.data(), expected.size(), TOLERANCE);
+        //and the batch kernels of Analytics
+        std::vector<double> batch(expected.size());
+        Analytics::SimpleMovingAverage(fixture.closes.data(), fixture.closes.size(), period, batch.data());
+        ExpectNear("StreamingSMA vs SimpleMovingAverage", sma.data(), batch.data(), batch.size(), TOLERANCE);
+        Analytics::ExponentialMovingAverage(fixture.closes.data(), fixture.closes.size(), period, batch.data());
+        ExpectNear("StreamingEMA vs ExponentialMovingAverage", ema.data(), batch.data(), batch.size(), TOLERANCE);
+        Analytics::WeightedMovingAverage(fixture.closes.data(), fixture.closes.size(), period, batch.data());
+        ExpectNear("StreamingWMA vs WeightedMovingAverage", wma.data(), batch.data(), batch.size(), TOLERANCE);
+    }
+}
+
+static void CheckStreamingRanges(Fixture& fixture){
+    const BarStore& bars = *fixture.analytics.valuesTS;
+    std::vector<double> trueRange = StreamBars(TrueRangeBars(), bars);
+    std::vector<double> expected = NaiveTrueRange(bars);
+    ExpectNear("StreamingTrueRange vs naive", trueRange.data(), expected.data(), expected.size(), 0);
+    std::vector<double> batch = fixture.analytics.TrueRange(static_cast<int>(fixture.bars) - 1);
+    ExpectNear("StreamingTrueRange vs TrueRange", trueRange.data(), batch.data(), batch.size(), 0);
+    for(int period : PERIODS){
+        std::vector<double> atr = StreamBars(ATRBars(period), bars);
+        expected = NaiveATR(bars, period);
+        ExpectNear("StreamingATR vs naive", atr.data(), expected.data(), expected.size(), TOLERANCE);
+    }
+}
+
+static void CheckStreamingChaikin(Fixture& fixture){
+    const BarStore& bars = *fixture.analytics.valuesTS;
+    int count = static_cast<int>(fixture.bars);
+    std::vector<double> ad = StreamBars(StreamingChaikinAD(), bars);
+    std::vector<double> expected = NaiveChaikinAD(bars);
+    ExpectNear("StreamingChaikinAD vs naive", ad.data(), expected.data(), expected.size(), TOLERANCE);
+    std::vector<double> batch(fixture.bars);
+    fixture.analytics.ChaikinAD(count, batch.data());
+    ExpectNear("StreamingChaikinAD vs ChaikinAD", ad.data(), batch.data(), batch.size(), TOLERANCE);
+
+    const int LENGTHS[][2] = {{3, 10}, {1, 1}, {5, 5}, {12, 26}};
+    for(const int *length : LENGTHS){
+        std::vector<double> adosc = StreamBars(StreamingADOSC(length[0], length[1]), bars);
+        expected = NaiveADOSC(bars, length[0], length[1]);
+        ExpectNear("StreamingADOSC vs naive", adosc.data(), expected.data(), expected.size(), TOLERANCE);
+        int outputs = count - Analytics::LookbackADOSC(length[1]);
+        batch.assign(outputs, 0);
+        fixture.analytics.ADOSC(outputs, length[0], length[1], batch.data());
+        ExpectNear("StreamingADOSC vs ADOSC", adosc.data(), batch.data(), batch.size(), TOLERANCE);
+    }
+    //a bar with high == low is refused and leaves the state as it was
+    StreamingChaikinAD refused;
+    refused.update(11, 9, 10, 100);
+    StreamingChaikinAD::State before = refused.snapshot();
+    bool threw = false;
+    try{
+        refused.update(10, 10, 10, 100);
+    }
+    catch(const std::runtime_error&){
+        threw = true;
+    }
+    StreamingChaikinAD::State after = refused.snapshot();
+    Expect("StreamingChaikinAD refuses high == low", threw && after.ad == before.ad && after.count == before.count);
+}
+
+//evaluating a forming bar on a snapshot and rolling it back must leave no trace
+static void CheckStreamingSnapshots(Fixture& fixture){
+    const BarStore& bars = *fixture.analytics.valuesTS;
+    StreamingEMA ema(14), emaPlain(14);
+    StreamingWMA wma(14), wmaPlain(14);
+    StreamingATR atr(14), atrPlain(14);
+    StreamingADOSC adosc(3, 10), adoscPlain(3, 10);
+    bool same = true;
+    for(size_t i = bars.size(); i-- > 0;){
+        double high = bars.getHighs()[i], low = bars.getLows()[i], close = bars.getCloses()[i];
+        int64_t volume = bars.getVolumes()[i];
+        StreamingEMA::State emaState = ema.snapshot();
+        StreamingWMA::State wmaState = wma.snapshot();
+        StreamingATR::State atrState = atr.snapshot();
+        StreamingADOSC::State adoscState = adosc.snapshot();
+        ema.update(close * 1.5);
+        wma.update(close * 1.5);
+        atr.update(high * 2, low / 2, close);
+        adosc.update(high * 2, low / 2, close, volume * 3);
+        ema.restore(emaState);
+        wma.restore(wmaState);
+        atr.restore(atrState);
+        adosc.restore(adoscState);
+
+        ema.update(close);
+        emaPlain.update(close);
+        wma.update(close);
+        wmaPlain.update(close);
+        atr.update(high, low, close);
+        atrPlain.update(high, low, close);
+        adosc.update(high, low, close, volume);
+        adoscPlain.update(high, low, close, volume);
+        if(adosc.isReady()){
+            same = same && ema.value() == emaPlain.value() && wma.value() == wmaPlain.value() && atr.value() == atrPlain.value()
+                        && adosc.value() == adoscPlain.value();
+        }
+    }
+    Expect("streaming snapshot/restore leaves no trace", same && adosc.isReady());
+}
+
+//PriceTransform through one signature: the inputs as an array (open, high, low, close) and the formula for one element
+struct Transform{
+    const char *name;
+    int aliased;    //input 'out' replaces in the aliasing check, one the transform reads
+    void (*run)(const double *const *in, double *out, size_t count);
+    double (*naive)(const double *in);
+};
+
+static const Transform TRANSFORMS[] = {
+    {"AvgPrice", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::AvgPrice(in[0], in[1], in[2], in[3], out, count); },
+                    [](const double *in){ return (in[0] + in[1] + in[2] + in[3]) / 4; }},
+    {"MedPrice", 2, [](const double *const *in, double *out, size_t count){ PriceTransform::MedPrice(in[1], in[2], out, count); },
+                    [](const double *in){ return (in[1] + in[2]) / 2; }},
+    {"TypPrice", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::TypPrice(in[1], in[2], in[3], out, count); },
+                    [](const double *in){ return (in[1] + in[2] + in[3]) / 3; }},
+    {"WclPrice", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::WclPrice(in[1], in[2], in[3], out, count); },
+                    [](const double *in){ return (in[1] + in[2] + 2 * in[3]) / 4; }},
+    {"Bop", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Bop(in[0], in[1], in[2], in[3], out, count); },
+               [](const double *in){ return in[1] > in[2] ? (in[3] - in[0]) / (in[1] - in[2]) : 0.0; }},
+    {"Div", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Div(in[3], in[0], out, count); },
+               [](const double *in){ return in[3] / in[0]; }},
+    {"Mult", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Mult(in[3], in[0], out, count); },
+                [](const double *in){ return in[3] * in[0]; }},
+    {"Sub", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Sub(in[3], in[0], out, count); },
+               [](const double *in){ return in[3] - in[0]; }},
+    {"Exp", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Exp(in[3], out, count); },
+               [](const double *in){ return std::exp(in[3]); }},
+    {"Ln", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Ln(in[3], out, count); },
+              [](const double *in){ return std::log(in[3]); }},
+    {"Log10", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Log10(in[3], out, count); },
+                 [](const double *in){ return std::log10(in[3]); }},
+    {"Sqrt", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Sqrt(in[3], out, count); },
+                [](const double *in){ return std::sqrt(in[3]); }},
+    {"Ceil", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Ceil(in[3], out, count); },
+                [](const double *in){ return std::ceil(in[3]); }},
+    {"Floor", 3, [](const double *const *in, double *out, size_t count){ PriceTransform::Floor(in[3], out, count); },
+                 [](const double *in){ return std::floor(in[3]); }},
+};
+
+//open, high, low, close of the fixture plus values the formulas treat specially, starting one double past the
+//allocation so the vector kernels also see unaligned columns
+struct TransformInputs{
+    std::vector<double> columns[4];
+    const double *in[4];
+
+    TransformInputs(const BarStore& bars, size_t count){
+        ColumnView<double> views[4] = {bars.getOpens(), bars.getHighs(), bars.getLows(), bars.getCloses()};
+        for(int c = 0; c < 4; c++){
+            columns[c].assign(1, 0.0);
+            columns[c].insert(columns[c].end(), views[c].begin(), views[c].begin() + count);
+            in[c] = columns[c].data() + 1;
+        }
+        double *open = &columns[0][1], *high = &columns[1][1], *low = &columns[2][1], *close = &columns[3][1];
+        close[5] = -1;              //Sqrt, Ln and Log10 of a negative
+        open[6] = 0;                //Div by 0
+        high[7] = low[7];           //Bop of a bar without range
+        close[8] = 2.5;             //Ceil and Floor of an exact half
+        close[9] = -0.0;
+        close[10] = 800;            //Exp overflowing
+        open[11] = -open[11];
+    }
+};
+
+static const size_t TRANSFORM_COUNTS[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 1001};
+
+//the scalar kernel against the formulas above
+static void CheckTransformFormulas(Fixture& fixture){
+    PriceTransform::Kernel kernel = PriceTransform::getKernel();
+    PriceTransform::SetKernel(PriceTransform::KERNEL_SCALAR);
+    size_t count = 1001;
+    TransformInputs inputs(*fixture.analytics.valuesTS, count);
+    std::vector<double> actual(count), expected(count);
+    for(const Transform& transform : TRANSFORMS){
+        transform.run(inputs.in, actual.data(), count);
+        for(size_t i = 0; i < count; i++){
+            double element[4] = {inputs.in[0][i], inputs.in[1][i], inputs.in[2][i], inputs.in[3][i]};
+            expected[i] = transform.naive(element);
+        }
+        ExpectNear(transform.name, actual.data(), expected.data(), count, 1e-15);
+    }
+    PriceTransform::SetKernel(kernel);
+}
+
+//every vector kernel the CPU has against KERNEL_SCALAR, bit for bit, at every tail length, with 'out' aliasing an input
+static void CheckTransformKernels(Fixture& fixture){
+    PriceTransform::Kernel kernel = PriceTransform::getKernel();
+    PriceTransform::Kernel widest = PriceTransform::DetectKernel();
+    size_t largest = TRANSFORM_COUNTS[sizeof(TRANSFORM_COUNTS) / sizeof(TRANSFORM_COUNTS[0]) - 1];
+    TransformInputs inputs(*fixture.analytics.valuesTS, largest);
+    std::vector<double> scalar(largest + 1), vector(largest + 1), aliased(largest + 1);
+    for(int k = PriceTransform::KERNEL_SSE41; k <= widest; k++){
+        std::string name = PriceTransform::KernelName(static_cast<PriceTransform::Kernel>(k));
+        for(const Transform& transform : TRANSFORMS){
+            std::string check = std::string(transform.name) + " " + name + " vs scalar";
+            for(size_t count : TRANSFORM_COUNTS){
+                PriceTransform::SetKernel(PriceTransform::KERNEL_SCALAR);
+                transform.run(inputs.in, scalar.data() + 1, count);
+                PriceTransform::SetKernel(static_cast<PriceTransform::Kernel>(k));
+                transform.run(inputs.in, vector.data() + 1, count);
+                ExpectNear(check.c_str(), vector.data() + 1, scalar.data() + 1, count, 0);
+                const double *in[4] = {inputs.in[0], inputs.in[1], inputs.in[2], inputs.in[3]};
+                std::copy(in[transform.aliased], in[transform.aliased] + count, aliased.begin() + 1);
+                in[transform.aliased] = aliased.data() + 1;
+                transform.run(in, aliased.data() + 1, count);
+                ExpectNear((check + ", aliased").c_str(), aliased.data() + 1, scalar.data() + 1, count, 0);
+            }
+        }
+    }
+    PriceTransform::SetKernel(kernel);
+}
+
+//closes rounded to whole units, so windows hold ties
+static std::vector<double> WithTies(const std::vector<double>& values){
+    std::vector<double> rounded(values.size());
+    for(size_t i = 0; i < values.size(); i++){
+        rounded[i] = std::floor(values[i]);
+    }
+    return rounded;
+}
+
+//Window() against a scan of every window, on ties the most recent (lowest index) value wins
+static void CheckExtremaWindow(Fixture& fixture){
+    std::vector<double> series[2] = {fixture.closes, WithTies(fixture.closes)};
+    for(const std::vector<double>& values : series){
+        for(int period : PERIODS){
+            size_t outputs = values.size() - period + 1;
+            std::vector<double> min(outputs), max(outputs);
+            std::vector<size_t> minIndex(outputs), maxIndex(outputs);
+            RollingExtrema::Window(values.data(), values.size(), period, outputs, min.data(), max.data(), minIndex.data(), maxIndex.data());
+            bool same = true;
+            for(size_t i = 0; i < outputs && same; i++){
+                size_t lowest = i + period - 1, highest = i + period - 1;
+                for(size_t j = i + period - 1; j-- > i;){
+                    lowest = values[j] <= values[lowest] ? j : lowest;
+                    highest = values[j] >= values[highest] ? j : highest;
+                }
+                same = min[i] == values[lowest] && max[i] == values[highest] && minIndex[i] == lowest && maxIndex[i] == highest;
+                if(!same){
+                    std::printf("FAIL RollingExtrema::Window period %d: output %zu is [%g @ %zu, %g @ %zu], expected [%g @ %zu, %g @ %zu]\n",
+                                period, i, min[i], minIndex[i], max[i], maxIndex[i], values[lowest], lowest, values[highest], highest);
+                    failures++;
+                }
+            }
+            //fewer outputs than the column allows, and outputs not wanted
+            std::vector<double> partial(outputs / 2);
+            RollingExtrema::Window(values.data(), values.size(), period, partial.size(), nullptr, partial.data(), nullptr, nullptr);
+            ExpectNear("RollingExtrema::Window, max only", partial.data(), max.data(), partial.size(), 0);
+        }
+    }
+    bool threw = false;
+    try{
+        RollingExtrema::Window(fixture.closes.data(), 10, 5, 7, nullptr, nullptr, nullptr, nullptr);
+    }
+    catch(const std::invalid_argument&){
+        threw = true;
+    }
+    Expect("RollingExtrema::Window refuses a short column", threw);
+}
+
+//update() oldest first against a scan of the last 'period' values, ages included, and snapshot/restore mid stream
+static void CheckExtremaStreaming(Fixture& fixture){
+    std::vector<double> values = WithTies(fixture.closes);
+    std::reverse(values.begin(), values.end());     //oldest first, the order update() takes
+    for(int period : PERIODS){
+        RollingExtrema extrema(period);
+        RollingExtrema::State middle;
+        bool same = true;
+        for(size_t n = 0; n < values.size() && same; n++){
+            bool ready = extrema.update(values[n]);
+            if(n == values.size() / 2){
+                middle = extrema.snapshot();
+            }
+            same = ready == (n + 1 >= static_cast<size_t>(period));
+            if(!ready){
+                continue;
+            }
+            size_t lowest = n + 1 - period, highest = n + 1 - period;
+            for(size_t j = n + 2 - period; j <= n; j++){
+                lowest = values[j] <= values[lowest] ? j : lowest;
+                highest = values[j] >= values[highest] ? j : highest;
+            }
+            same = same && extrema.getMin() == values[lowest] && extrema.getMax() == values[highest]
+                        && extrema.getMinAge() == n - lowest && extrema.getMaxAge() == n - highest;
+            if(!same){
+                std::printf("FAIL RollingExtrema period %d: value %zu is [%g age %zu, %g age %zu], expected [%g age %zu, %g age %zu]\n",
+                            period, n, extrema.getMin(), extrema.getMinAge(), extrema.getMax(), extrema.getMaxAge(),
+                            values[lowest], n - lowest, values[highest], n - highest);
+                failures++;
+            }
+        }
+        //from the middle again: the same extremes as an extrema fed the first half, then the rest
+        RollingExtrema replay(period), reference(period);
+        replay.update(-1e9);
+        replay.restore(middle);
+        for(size_t n = 0; n < values.size(); n++){
+            reference.update(values[n]);
+            if(n > values.size() / 2){
+                replay.update(values[n]);
+            }
+        }
+        Expect("RollingExtrema snapshot/restore", replay.getMin() == reference.getMin() && replay.getMax() == reference.getMax()
+                                                  && replay.getMinAge() == reference.getMinAge() && replay.getMaxAge() == reference.getMaxAge());
+    }
+}
+
+static const int MOMENT_PERIODS[] = {2, 14, 50};
+
+//update(y) and update(x, y) against two pass moments of every window. Besides the closes, a series of prices around
+//10^4 moving in the fourth decimal, where a sum of squares would have lost the variance
+static void CheckMomentsStreaming(Fixture& fixture){
+    std::vector<double> flat(fixture.closes.size());
+    for(size_t i = 0; i < flat.size(); i++){
+        flat[i] = 10000 + (fixture.closes[i] - std::floor(fixture.closes[i])) * 1e-3;
+    }
+    const BarStore& bars = *fixture.analytics.valuesTS;
+    ColumnView<double> highs = bars.getHighs(), lows = bars.getLows();
+    std::vector<double> series[2] = {fixture.closes, flat};
+    for(const std::vector<double>& values : series){
+        for(int period : MOMENT_PERIODS){
+            size_t outputs = values.size() - period + 1;
+            std::vector<double> actual[8], expected[8];
+            for(int k = 0; k < 8; k++){
+                actual[k].resize(outputs);
+                expected[k].resize(outputs);
+            }
+            RollingMoments moments(period), pairs(period);
+            for(size_t i = values.size(); i-- > 0;){
+                pairs.update(highs[i], lows[i]);
+                if(!moments.update(values[i])){
+                    continue;
+                }
+                NaiveMoments naive = NaiveWindow(&values[i], period);
+                actual[0][i] = moments.getMean();
+                expected[0][i] = naive.mean;
+                actual[1][i] = moments.getVariance();
+                expected[1][i] = naive.variance;
+                actual[2][i] = moments.getSampleVariance();
+                expected[2][i] = naive.variance * period / (period - 1);
+                actual[3][i] = moments.getStdDev();
+                expected[3][i] = std::sqrt(naive.variance);
+                actual[4][i] = moments.getSlope();
+                expected[4][i] = naive.slope;
+                actual[5][i] = moments.getLinearReg();
+                expected[5][i] = naive.intercept + naive.slope * (period - 1);
+                actual[6][i] = moments.getLinearRegIntercept();
+                expected[6][i] = naive.intercept;
+                actual[7][i] = pairs.getCorrelation();
+                expected[7][i] = NaiveCorrelation(&highs[i], &lows[i], period);
+            }
+            const char *NAMES[8] = {"RollingMoments mean", "RollingMoments variance", "RollingMoments sample variance",
+                                    "RollingMoments stddev", "RollingMoments slope", "RollingMoments linear reg",
+                                    "RollingMoments intercept", "RollingMoments correlation"};
+            for(int k = 0; k < 8; k++){
+                ExpectNear(NAMES[k], actual[k].data(), expected[k].data(), outputs, TOLERANCE);
+            }
+            Expect("RollingMoments forecast", Near(moments.getForecast(), moments.getLinearReg() + moments.getSlope(), TOLERANCE));
+        }
+    }
+}
+
+//the Analytics indicators on RollingMoments, and SimpleMovingAverage on its own running sum, against the same windows
+static void CheckMomentsIndicators(Fixture& fixture){
+    ColumnView<double> highs = fixture.analytics.getHighs(), lows = fixture.analytics.getLows();
+    for(int period : MOMENT_PERIODS){
+        int outputs = static_cast<int>(fixture.bars) - period + 1;
+        std::vector<double> variance(outputs), deviation(outputs), linearReg(outputs), correlation(outputs), sma(outputs);
+        std::vector<double> expectedVariance(outputs), expectedDeviation(outputs), expectedLinearReg(outputs), expectedCorrelation(outputs);
+        for(int i = 0; i < outputs; i++){
+            NaiveMoments naive = NaiveWindow(&fixture.closes[i], period);
+            expectedVariance[i] = naive.variance;
+            expectedDeviation[i] = 2 * std::sqrt(naive.variance);
+            expectedLinearReg[i] = naive.intercept + naive.slope * (period - 1);
+            expectedCorrelation[i] = NaiveCorrelation(&highs[i], &lows[i], period);
+        }
+        fixture.analytics.VAR(outputs, period, "close", variance.data());
+        ExpectNear("VAR", variance.data(), expectedVariance.data(), outputs, TOLERANCE);
+        fixture.analytics.STDDEV(outputs, period, "close", 2, deviation.data());
+        ExpectNear("STDDEV", deviation.data(), expectedDeviation.data(), outputs, TOLERANCE);
+        fixture.analytics.LINEARREG(outputs, period, "close", linearReg.data());
+        ExpectNear("LINEARREG", linearReg.data(), expectedLinearReg.data(), outputs, TOLERANCE);
+        fixture.analytics.CORREL(outputs, period, "high", "low", correlation.data());
+        ExpectNear("CORREL", correlation.data(), expectedCorrelation.data(), outputs, TOLERANCE);
+    }
+    //long series around 10^4: the periodic resum keeps the running sum from drifting
+    std::vector<double> prices(200000);
+    for(size_t i = 0; i < prices.size(); i++){
+        prices[i] = 10000 + fixture.closes[i % fixture.closes.size()] * 1e-2;
+    }
+    for(int period : PERIODS){
+        std::vector<double> sma(prices.size() - period + 1);
+        Analytics::SimpleMovingAverage(prices.data(), prices.size(), period, sma.data());
+        std::vector<double> expected = NaiveSMA(prices, period);
+        ExpectNear("SimpleMovingAverage, long series", sma.data(), expected.data(), expected.size(), 1e-13);
+    }
+}
+
+//scratch file of the file checks, in the working directory, removed when they are done
+static const char *CHECK_FILE = "checks.tmp";
+
+//overwrite one byte of 'path' at 'offset', or cut the file to 'offset' bytes when 'truncate'
+static void Damage(const char *path, long offset, bool truncate){
+    if(truncate){
+        Expect("truncate the file", ::truncate(path, offset) == 0);
+        return;
+    }
+    FILE *fp = std::fopen(path, "r+b");
+    if(fp == NULL){
+        Expect("open the file to damage", false);
+        return;
+    }
+    std::fseek(fp, offset, SEEK_SET);
+    int byte = std::fgetc(fp);
+    std::fseek(fp, offset, SEEK_SET);
+    std::fputc(byte ^ 0x10, fp);
+    std::fclose(fp);
+}
+
+//Write then Load gives the bars back bit for bit, with or without a checksum, also empty and with values no price has
+static void CheckSnapshotRoundTrip(Fixture& fixture){
+    const BarStore& bars = *fixture.analytics.valuesTS;
+    BarStore odd;
+    odd.append(1712678400, NAN, INFINITY, -INFINITY, -0.0, INT64_MAX);
+    odd.append(-86400, 5e-324, 1.7976931348623157e308, 0.1, 123456.789, -1);
+    odd.setHasTimeOfDay(false);
+    BarStore empty;
+    const BarStore *stores[3] = {&bars, &odd, &empty};
+    for(const BarStore *store : stores){
+        for(int checksum = 0; checksum < 2; checksum++){
+            BarStore loaded;
+            BarSnapshot::Write(CHECK_FILE, *store, checksum == 1);
+            Expect("BarSnapshot::Load", BarSnapshot::Load(CHECK_FILE, loaded, false));
+            ExpectSameBars("BarSnapshot round trip", loaded, *store);
+            Expect("BarSnapshot::Load attaches the mapping", loaded.isAttached());
+            //verify asks for the checksum
+            Expect("BarSnapshot::Load, verify", BarSnapshot::Load(CHECK_FILE, loaded, true) == (checksum == 1));
+        }
+    }
+    std::remove(CHECK_FILE);
+}
+
+//a damaged file is refused by Load, or by Load with 'verify' when only the columns changed
+static void CheckSnapshotDamage(Fixture& fixture){
+    const BarStore& bars = *fixture.analytics.valuesTS;
+    long header = sizeof(BarSnapshot::Header), size = header + 48 * static_cast<long>(bars.size());
+    struct Damaged{
+        const char *name;
+        long offset;
+        bool truncate;
+        bool loads;         //Load without verify still takes it
+    };
+    const Damaged DAMAGE[] = {
+        {"magic", 0, false, false},
+        {"version", 8, false, false},
+        {"count", 16, false, false},
+        {"checksum", 24, false, true},
+        {"first time stamp", header, false, true},
+        {"a close", header + 8 * 4 * static_cast<long>(bars.size()) + 8 * 17, false, true},
+        {"last volume byte", size - 1, false, true},
+        {"cut inside the header", 20, true, false},
+        {"cut inside the columns", size - 8, true, false},
+        {"empty file", 0, true, false},
+    };
+    for(const Damaged& damage : DAMAGE){
+        BarSnapshot::Write(CHECK_FILE, bars);
+        Damage(CHECK_FILE, damage.offset, damage.truncate);
+        BarStore loaded;
+        std::string check = std::string("BarSnapshot refuses ") + damage.name;
+        Expect(check.c_str(), !BarSnapshot::Load(CHECK_FILE, loaded, true) && loaded.empty());
+        Expect((check + ", without verify").c_str(), BarSnapshot::Load(CHECK_FILE, loaded, false) == damage.loads);
+    }
+    std::remove(CHECK_FILE);
+    BarStore loaded;
+    Expect("BarSnapshot refuses a missing file", !BarSnapshot::Load(CHECK_FILE, loaded, false));
+}
+
+static void WriteFile(const char *path, const std::string& content){
+    FILE *fp = std::fopen(path, "wb");
+    Expect("write the file", fp != NULL && std::fwrite(content.data(), 1, content.size(), fp) == content.size());
+    if(fp != NULL){
+        std::fclose(fp);
+    }
+}
+
+//WriteToCSV then CsvImporter::Load gives the bars back bit for bit, as CSV and TSV, parsed in one piece and in chunks
+static void CheckCsvRoundTrip(Fixture& fixture){
+    BarStore large;     //large enough for Load to split it into chunks
+    SyntheticBars::Generate(large, 60000, SEED + 1);
+    BarStore odd;
+    odd.append(1712707200, NAN, INFINITY, -INFINITY, -0.0, INT64_MAX);
+    odd.append(-86400, 5e-324, 1.7976931348623157e308, 0.1, 123456.789, -1);
+    odd.setHasTimeOfDay(false);
+    const BarStore *stores[3] = {fixture.analytics.valuesTS, &large, &odd};
+    ThreadPool pool(4);
+    for(const BarStore *store : stores){
+        for(char delimiter : {',', '\t'}){
+            Parse::WriteToCSV(CHECK_FILE, *store, delimiter);
+            BarStore loaded;
+            Expect("CsvImporter::Load count", CsvImporter::Load(CHECK_FILE, loaded) == store->size());
+            ExpectSameBars("CSV round trip", loaded, *store);
+            CsvImporter::Load(CHECK_FILE, loaded, &pool);
+            ExpectSameBars("CSV round trip, chunked", loaded, *store);
+        }
+    }
+    std::remove(CHECK_FILE);
+}
+
+//a vendor style file: header in another order with a column to skip, quoted fields holding the delimiter, \r\n,
+//oldest first, empty volume. And lines Load must refuse
+static void CheckCsvLayouts(Fixture&){
+    WriteFile(CHECK_FILE, "\"Volume\",\"Symbol\",\"Close\",\"Low\",\"High\",\"Open\",\"Date\"\r\n"
+                          "100,\"AAPL, Inc.\",10.5,10,11,10.25,2024-04-09 13:58:00\r\n"
+                          ",\"AAPL \"\"A\"\"\",10.75,10.5,11.5,10.5,\"2024-04-09T13:59:00\"\r\n");
+    BarStore expected;
+    expected.append(1712671140, 10.5, 11.5, 10.5, 10.75, 0);
+    expected.append(1712671080, 10.25, 11, 10, 10.5, 100);
+    expected.setHasTimeOfDay(true);
+    BarStore loaded;
+    CsvImporter::Load(CHECK_FILE, loaded);
+    ExpectSameBars("CSV layout", loaded, expected);
+
+    const char *MALFORMED[] = {
+        "datetime,open,high,low,close,volume\n2024-04-09 13:58:00,1,2,x,1.5,10\n",
+        "datetime,open,high,low,close,volume\n2024-04-09 13:58:00,1,2,1\n",
+        "datetime,open,high,low,close,volume\n2024-13-09 13:58:00,1,2,1,1.5,10\n",
+        "datetime,open,high,low,close,volume\n\"2024-04-09 13:58:00,1,2,1,1.5,10\n",
+    };
+    for(const char *content : MALFORMED){
+        WriteFile(CHECK_FILE, content);
+        bool threw = false;
+        try{
+            CsvImporter::Load(CHECK_FILE, loaded);
+        }
+        catch(const std::runtime_error&){
+            threw = true;
+        }
+        Expect("CsvImporter::Load refuses a malformed line", threw);
+    }
+    std::remove(CHECK_FILE);
+}
+
+//ParseDouble against strtod on random decimals of every length, both its exact path and the strtod fallback
+static void CheckCsvNumbers(Fixture&){
+    uint64_t state = SEED;
+    char text[64];
+    for(int n = 0; n < 200000; n++){
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t random = state >> 11;
+        int digits = 1 + random % 19, point = random / 19 % (digits + 1), exponent = static_cast<int>(random / 400 % 61) - 30;
+        size_t length = 0;
+        if(random & (1ULL << 40)){
+            text[length++] = '-';
+        }
+        uint64_t mantissa = state;
+        for(int d = 0; d < digits; d++){
+            if(d == point && d > 0){
+                text[length++] = '.';
+            }
+            text[length++] = static_cast<char>('0' + mantissa % 10);
+            mantissa /= 10;
+        }
+        if(random & (1ULL << 41)){
+            length += std::snprintf(text + length, sizeof(text) - length, "e%d", exponent);
+        }
+        text[length] = '\0';
+        double value = 0;
+        double expected = std::strtod(text, NULL);
+        if(!CsvImporter::ParseDouble(text, text + length, value) || std::memcmp(&value, &expected, sizeof(double)) != 0){
+            std::printf("FAIL ParseDouble(\"%s\") is %.17g, expected %.17g\n", text, value, expected);
+            failures++;
+            return;
+        }
+    }
+    double value;
+    Expect("ParseDouble refuses text", !CsvImporter::ParseDouble("1.2.3", std::strchr("1.2.3", 0), value)
+                                       && !CsvImporter::ParseDouble("abc", std::strchr("abc", 0), value));
+
+    //ParseInteger: exact over all of int64_t, refused outside of it instead of overflowing
+    struct IntegerCase{
+        const char *text;
+        bool ok;
+        int64_t expected;
+    };
+    const IntegerCase INTEGERS[] = {
+        {"0", true, 0},
+        {"-42", true, -42},
+        {"+7", true, 7},
+        {"999999999999999999", true, 999999999999999999LL},
+        {"-999999999999999999", true, -999999999999999999LL},
+        {"1000000000000000000", true, 1000000000000000000LL},
+        {"4611686018427387904", true, 4611686018427387904LL},
+        {"9223372036854775807", true, INT64_MAX},
+        {"-9223372036854775807", true, -INT64_MAX},
+        {"-9223372036854775808", true, INT64_MIN},
+        {"9223372036854775808", false, 0},
+        {"-9223372036854775809000", false, 0},
+        {"18446744073709551616", false, 0},
+        {"123456789012345678901234567890", false, 0},
+        {"1234.6", true, 1235},
+        {"1.2e6", true, 1200000},
+        {"1e19", false, 0},
+        {"nan", false, 0},
+        {"", false, 0},
+        {"-", false, 0},
+        {"12a", false, 0},
+    };
+    for(const IntegerCase& integer : INTEGERS){
+        int64_t parsed = 0;
+        bool ok = CsvImporter::ParseInteger(integer.text, std::strchr(integer.text, 0), parsed);
+        if(ok != integer.ok || (ok && parsed != integer.expected)){
+            std::printf("FAIL ParseInteger(\"%s\") is %s %lld, expected %s %lld\n", integer.text, ok ? "ok" : "refused",
+                        static_cast<long long>(parsed), integer.ok ? "ok" : "refused", static_cast<long long>(integer.expected));
+            failures++;
+        }
+    }
+}
+
+//newest first store of 'count' bars, several bars per time stamp and gaps of varying length, close = bar index
+static void IrregularBars(BarStore& bars, size_t count, uint64_t seed){
+    bars.clear();
+    int64_t timeStamp = 1712678340;
+    for(size_t i = 0; i < count; i++){
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        bars.append(timeStamp, 1, 2, 0.5, static_cast<double>(i), 10);
+        timeStamp -= static_cast<int64_t>((seed >> 33) % 4) * 60;     //0: the next bar has the same time stamp
+    }
+}
+
+//indexBefore and range against a scan of the time stamps, on every time stamp of the store, next to it and past both ends
+static void CheckRangeQueries(Fixture&){
+    const size_t SIZES[] = {0, 1, 2, 3, 4, 5, 8, 33, 1000};
+    for(size_t size : SIZES){
+        BarStore bars;
+        IrregularBars(bars, size, SEED + size);
+        ColumnView<int64_t> timeStamps = bars.getTimeStamps();
+        std::vector<int64_t> probes = {INT64_MIN, INT64_MAX, 0};
+        for(size_t i = 0; i < size; i++){
+            probes.push_back(timeStamps[i] - 1);
+            probes.push_back(timeStamps[i]);
+            probes.push_back(timeStamps[i] + 1);
+        }
+        //the first bar older than 't', size if there is none
+        auto scan = [&](int64_t t){
+            size_t i = 0;
+            while(i < size && timeStamps[i] >= t){
+                i++;
+            }
+            return i;
+        };
+        bool same = true;
+        for(int64_t t : probes){
+            if(bars.indexBefore(t) != scan(t)){
+                std::printf("FAIL BarStore::indexBefore(%lld) of %zu bars is %zu, expected %zu\n", static_cast<long long>(t), size,
+                            bars.indexBefore(t), scan(t));
+                failures++;
+                same = false;
+                break;
+            }
+        }
+        for(size_t a = 0; a < probes.size() && same; a += 3){
+            for(size_t b = 0; b < probes.size() && same; b += 2){
+                int64_t from = probes[a], to = probes[b];
+                BarRange range = bars.range(from, to);
+                size_t begin = scan(to), end = from < to ? scan(from) : begin;
+                same = range.first == begin && range.size() == end - begin
+                       && (range.empty() || (range.timeStamps.data() == timeStamps.data() + begin
+                                             && range.closes[0] == static_cast<double>(begin) && range.volumes.size() == range.size()));
+                for(size_t i = 0; i < range.size() && same; i++){
+                    same = range.timeStamps[i] >= from && range.timeStamps[i] < to;
+                }
+                if(!same){
+                    std::printf("FAIL BarStore::range(%lld, %lld) of %zu bars is [%zu, %zu), expected [%zu, %zu)\n",
+                                static_cast<long long>(from), static_cast<long long>(to), size, range.first, range.first + range.size(),
+                                begin, end);
+                    failures++;
+                }
+            }
+        }
+    }
+}
+
+//result 'index' of 'session' holds the bits of 'expected'
+static void ExpectSessionResult(const char *check, const IndicatorSession& session, size_t index, const std::vector<double>& expected){
+    if(!session.getError(index).empty()){
+        std::printf("FAIL %s: %s\n", check, session.getError(index).c_str());
+        failures++;
+        return;
+    }
+    const std::vector<std::pair<std::string, double>>& result = session.getResult(index);
+    std::vector<double> values;
+    for(size_t i = 0; i < result.size(); i++){
+        values.push_back(result[i].second);
+    }
+    Expect(check, values.size() == expected.size());
+    ExpectNear(check, values.data(), expected.data(), std::min(values.size(), expected.size()), 0);
+}
+
+static std::vector<double> StandaloneChaikinAD(Analytics& analytics, int intervalAmount){
+    std::vector<double> out(intervalAmount);
+    analytics.ChaikinAD(intervalAmount, out.data());
+    return out;
+}
+
+static std::vector<double> StandaloneADOSC(Analytics& analytics, int intervalAmount, int shortEMA, int longEMA){
+    std::vector<double> out(intervalAmount);
+    analytics.ADOSC(intervalAmount, shortEMA, longEMA, out.data());
+    return out;
+}
+
+//the A/D line and ADOSC of a session equal the standalone calls whatever other indicators share the session, and a bar
+//with high == low fails only the indicators whose window holds it
+static void CheckSessionChaikin(Fixture& fixture){
+    IndicatorSession session("", "1min");
+    SyntheticBars::Generate(*session.getData().valuesTS, BARS, SEED);
+    size_t ad10 = session.add({IndicatorSession::CHAIKIN_AD, 10, 0, 0, ""});
+    size_t ad300 = session.add({IndicatorSession::CHAIKIN_AD, 300, 0, 0, ""});
+    size_t ad30 = session.add({IndicatorSession::CHAIKIN_AD, 30, 0, 0, ""});
+    size_t osc20 = session.add({IndicatorSession::ADOSC, 20, 3, 10, ""});     //same window as ad30
+    size_t osc50 = session.add({IndicatorSession::ADOSC, 50, 3, 10, ""});
+    size_t osc200 = session.add({IndicatorSession::ADOSC, 200, 12, 26, ""});
+    session.computeAll();
+    ExpectSessionResult("session CHAIKIN_AD 10", session, ad10, StandaloneChaikinAD(fixture.analytics, 10));
+    ExpectSessionResult("session CHAIKIN_AD 300", session, ad300, StandaloneChaikinAD(fixture.analytics, 300));
+    ExpectSessionResult("session CHAIKIN_AD 30", session, ad30, StandaloneChaikinAD(fixture.analytics, 30));
+    ExpectSessionResult("session ADOSC 20 3 10", session, osc20, StandaloneADOSC(fixture.analytics, 20, 3, 10));
+    ExpectSessionResult("session ADOSC 50 3 10", session, osc50, StandaloneADOSC(fixture.analytics, 50, 3, 10));
+    ExpectSessionResult("session ADOSC 200 12 26", session, osc200, StandaloneADOSC(fixture.analytics, 200, 12, 26));
+
+    //the same bars with bar 100 closing at its high and low
+    const BarStore& bars = *fixture.analytics.valuesTS;
+    Analytics flat;
+    for(size_t i = 0; i < bars.size(); i++){
+        double high = i == 100 ? bars.getCloses()[i] : bars.getHighs()[i], low = i == 100 ? bars.getCloses()[i] : bars.getLows()[i];
+        flat.valuesTS->append(bars.getTimeStamps()[i], bars.getOpens()[i], high, low, bars.getCloses()[i], bars.getVolumes()[i]);
+    }
+    IndicatorSession flatSession("", "1min");
+    *flatSession.getData().valuesTS = *flat.valuesTS;
+    size_t before = flatSession.add({IndicatorSession::CHAIKIN_AD, 50, 0, 0, ""});
+    size_t oscBefore = flatSession.add({IndicatorSession::ADOSC, 40, 3, 10, ""});
+    size_t over = flatSession.add({IndicatorSession::CHAIKIN_AD, 150, 0, 0, ""});
+    size_t oscOver = flatSession.add({IndicatorSession::ADOSC, 200, 3, 10, ""});
+    size_t ema = flatSession.add({IndicatorSession::EMA, 300, 14, 0, "close"});
+    flatSession.computeAll();
+    ExpectSessionResult("session CHAIKIN_AD before a bar without range", flatSession, before, StandaloneChaikinAD(flat, 50));
+    ExpectSessionResult("session ADOSC before a bar without range", flatSession, oscBefore, StandaloneADOSC(flat, 40, 3, 10));
+    std::vector<double> closes(flat.getCloses().begin(), flat.getCloses().begin() + 313);
+    ExpectSessionResult("session EMA over a bar without range", flatSession, ema, flat.ExponentialMovingAverage(closes, 14));
+    size_t failing[2] = {over, oscOver};
+    for(size_t index : failing){
+        bool threw = false;
+        try{
+            flatSession.getResult(index);
+        }
+        catch(const std::runtime_error&){
+            threw = true;
+        }
+        Expect("session fails the indicators over a bar without range", threw && !flatSession.getError(index).empty());
+    }
+}
+
+//every kind of session indicator against its own Analytics call on the same bars, with windows shorter and longer
+//than the others in the session
+static void CheckSessionIndicators(Fixture& fixture){
+    IndicatorSession session("", "1min");
+    SyntheticBars::Generate(*session.getData().valuesTS, BARS, SEED);
+    const int AMOUNTS[] = {1, 37, 400};
+    const char *COLUMNS[] = {"close", "open", "high", "low"};
+    std::vector<std::pair<std::string, std::vector<double>>> expected;
+    for(int amount : AMOUNTS){
+        session.add({IndicatorSession::TRUE_RANGE, amount, 0, 0, ""});
+        expected.push_back({"session TRUE_RANGE " + std::to_string(amount), fixture.analytics.TrueRange(amount)});
+        session.add({IndicatorSession::ADOSC, amount, 5, 5, ""});
+        expected.push_back({"session ADOSC 5 5 " + std::to_string(amount), StandaloneADOSC(fixture.analytics, amount, 5, 5)});
+        for(int period : PERIODS){
+            for(const char *column : COLUMNS){
+                std::string name = std::to_string(amount) + " " + std::to_string(period) + " " + column;
+                ColumnView<double> values = fixture.analytics.getSeries(column);
+                std::vector<double> window(values.begin(), values.begin() + amount + period - 1);
+                session.add({IndicatorSession::EMA, amount, period, 0, column});
+                expected.push_back({"session EMA " + name, fixture.analytics.ExponentialMovingAverage(window, period)});
+                session.add({IndicatorSession::SMA, amount, period, 0, column});
+                expected.push_back({"session SMA " + name, fixture.analytics.SimpleMovingAverage(window, period)});
+            }
+        }
+    }
+    //computed twice: the graph must not keep anything from one run to the next
+    for(int run = 0; run < 2; run++){
+        session.computeAll();
+        for(size_t i = 0; i < expected.size(); i++){
+            ExpectSessionResult(expected[i].first.c_str(), session, i, expected[i].second);
+        }
+    }
+}
+
+//parses 'body' fed in chunks of 'chunk' bytes (0: in one piece) into 'bars'. Returns the finish() error, empty when none
+static std::string ParseBody(const std::string& body, size_t chunk, BarStore& bars){
+    bars.clear();
+    TimeSeriesParser parser(&bars);
+    size_t step = chunk == 0 ? std::max<size_t>(body.size(), 1) : chunk;
+    for(size_t i = 0; i < body.size(); i += step){
+        parser.feed(body.data() + i, std::min(step, body.size() - i));
+    }
+    try{
+        parser.finish();
+    }
+    catch(const std::runtime_error& error){
+        return error.what();
+    }
+    return "";
+}
+
+//the time_series parser on a good body in any chunking, and on the bodies it must refuse instead of storing 0
+static void CheckTimeSeriesParser(Fixture&){
+    const std::string HEAD = "{\"meta\":{\"symbol\":\"AAPL\",\"interval\":\"1min\"},\"values\":[";
+    const std::string TAIL = "],\"status\":\"ok\"}";
+    const std::string body = HEAD
+        + "{\"datetime\":\"2024-04-09 13:59:00\",\"open\":\"168.49\",\"high\":\"168.6\",\"low\":\"168.4\",\"close\":\"168.58\",\"volume\":\"2464327\"},\n"
+        + "{\"datetime\":\"2024-04-09 13:58:00\",\"open\":\"1e2\",\"high\":\"-0\",\"low\":\"0.1\",\"close\":\"168.5\",\"volume\":\"12.5\"}" + TAIL;
+    BarStore expected;
+    expected.append(1712671140, 168.49, 168.6, 168.4, 168.58, 2464327);
+    expected.append(1712671080, 100, -0.0, 0.1, 168.5, 12);
+    expected.setHasTimeOfDay(true);
+    const size_t CHUNKS[] = {0, 1, 2, 3, 7, 64};
+    for(size_t chunk : CHUNKS){
+        BarStore bars;
+        std::string error = ParseBody(body, chunk, bars);
+        Expect(("time_series body in chunks of " + std::to_string(chunk) + ": " + error).c_str(), error.empty());
+        ExpectSameBars("time_series body", bars, expected);
+    }
+    //forex: no volume, date only datetimes
+    BarStore bars;
+    std::string error = ParseBody(HEAD + "{\"datetime\":\"2024-04-09\",\"open\":\"1.08\",\"high\":\"1.09\",\"low\":\"1.07\",\"close\":\"1.085\"}" + TAIL, 0, bars);
+    Expect("time_series bar without volume", error.empty() && bars.size() == 1 && bars.getVolumes()[0] == 0 && !bars.hasTimeOfDay());
+
+    //every one of these must fail, and say why
+    struct Refused{
+        const char *name;
+        std::string body;
+        const char *reason;     //part of the message
+    };
+    const std::string DATETIME = "{\"datetime\":\"2024-04-09 13:59:00\"";
+    const Refused REFUSED[] = {
+        {"a price that is not a number", HEAD + DATETIME + ",\"open\":\"abc\",\"high\":\"2\",\"low\":\"1\",\"close\":\"1.5\"}" + TAIL, "not a number"},
+        {"a price with trailing text", HEAD + DATETIME + ",\"open\":\"1.5x\",\"high\":\"2\",\"low\":\"1\",\"close\":\"1.5\"}" + TAIL, "not a number"},
+        {"a null price", HEAD + DATETIME + ",\"open\":\"1\",\"high\":\"2\",\"low\":\"1\",\"close\":null}" + TAIL, "not a number"},
+        {"an empty price", HEAD + DATETIME + ",\"open\":\"\",\"high\":\"2\",\"low\":\"1\",\"close\":\"1.5\"}" + TAIL, "not a number"},
+        {"a volume that is not a number", HEAD + DATETIME + ",\"open\":\"1\",\"high\":\"2\",\"low\":\"1\",\"close\":\"1.5\",\"volume\":\"n/a\"}" + TAIL, "not a number"},
+        {"a bar with only a datetime", HEAD + DATETIME + "}" + TAIL, "without an open"},
+        {"a bar without close", HEAD + DATETIME + ",\"open\":\"1\",\"high\":\"2\",\"low\":\"1\"}" + TAIL, "without an open"},
+        {"an API error", "{\"code\":400,\"message\":\"**symbol** not found: XYZ\",\"status\":\"error\"}", "symbol** not found"},
+        {"no values array", "{\"meta\":{},\"status\":\"ok\"}", "no 'values'"},
+    };
+    for(const Refused& refused : REFUSED){
+        for(size_t chunk : CHUNKS){
+            error = ParseBody(refused.body, chunk, bars);
+            if(error.find(refused.reason) == std::string::npos){
+                std::printf("FAIL time_series parser accepts %s (chunks of %zu): \"%s\"\n", refused.name, chunk, error.c_str());
+                failures++;
+                break;
+            }
+        }
+    }
+    //every cut of the good body is an error, never a shorter store
+    for(size_t length = 0; length < body.size(); length++){
+        if(ParseBody(body.substr(0, length), 0, bars).empty()){
+            std::printf("FAIL time_series parser accepts the body cut to %zu bytes\n", length);
+            failures++;
+            break;
+        }
+    }
+}
+
+//'count' one minute bars from 'newest' back, close = 'close' + bar index so fresh and cached bars tell apart
+static BarStore MinuteBars(int64_t newest, size_t count, double close){
+    BarStore bars;
+    for(size_t i = 0; i < count; i++){
+        bars.append(newest - static_cast<int64_t>(i) * 60, 1, 2, 0.5, close + i, 10);
+    }
+    bars.setHasTimeOfDay(true);
+    return bars;
+}
+
+//BarCache::Merge against the expected layout: cached bars newer than fresh, fresh, cached bars older than fresh
+static void CheckCacheMerge(Fixture&){
+    const int64_t NEWEST = 1712671140;
+    const BarStore cached = MinuteBars(NEWEST, 10, 100);
+    struct MergeCase{
+        const char *check;
+        int64_t freshNewest;
+        size_t freshCount;
+        size_t newer, older;    //cached [0, newer) in front of fresh, cached [older, 10) behind it
+    };
+    const MergeCase CASES[] = {
+        {"Merge, fresh replaces the newest cached bar", NEWEST + 120, 3, 0, 1},
+        {"Merge, fresh replaces several cached bars", NEWEST + 60, 5, 0, 4},
+        {"Merge, fresh covers every cached bar", NEWEST, 10, 0, 10},
+        {"Merge, fresh newer than every cached bar", NEWEST + 600, 3, 0, 0},
+        {"Merge, fresh inside the cached bars", NEWEST - 120, 3, 2, 5},
+        {"Merge, fresh older than every cached bar", NEWEST - 1200, 3, 10, 10},
+    };
+    for(const MergeCase& merge : CASES){
+        BarStore fresh = MinuteBars(merge.freshNewest, merge.freshCount, 200);
+        BarStore expected;
+        expected.append(cached, 0, merge.newer);
+        expected.append(fresh, 0, fresh.size());
+        expected.append(cached, merge.older, cached.size());
+        expected.setHasTimeOfDay(true);
+        BarStore merged = cached;
+        BarCache::Merge(merged, fresh);
+        ExpectSameBars(merge.check, merged, expected);
+    }
+
+    BarStore merged = cached;
+    BarCache::Merge(merged, BarStore());
+    ExpectSameBars("Merge, no fresh bars", merged, cached);
+    merged.clear();
+    BarStore fresh = MinuteBars(NEWEST, 3, 200);
+    BarCache::Merge(merged, fresh);
+    ExpectSameBars("Merge, nothing cached", merged, fresh);
+    merged.clear();
+    BarCache::Merge(merged, BarStore());
+    Expect("Merge, both empty", merged.empty());
+}
+
+//batches submitted and waited for from inside tasks, two levels deep, and exceptions of tasks inside and outside batches
+static void CheckThreadPool(Fixture&){
+    const size_t OUTER = 12, INNER = 8, LEAVES = 6;
+    for(size_t threads : {1, 4}){
+        ThreadPool pool(threads);
+        std::vector<std::atomic<int>> runs(OUTER * INNER * LEAVES);
+        for(std::atomic<int>& count : runs){
+            count = 0;
+        }
+        ThreadPool::Batch outer(pool);
+        for(size_t i = 0; i < OUTER; i++){
+            outer.submit([&, i]{
+                ThreadPool::Batch inner(pool);
+                for(size_t j = 0; j < INNER; j++){
+                    inner.submit([&, i, j]{
+                        ThreadPool::Batch leaves(pool);
+                        for(size_t k = 0; k < LEAVES; k++){
+                            leaves.submit([&, i, j, k]{ runs[(i * INNER + j) * LEAVES + k]++; });
+                        }
+                        leaves.wait();
+                    });
+                }
+                inner.wait();
+            });
+        }
+        outer.wait();
+        bool once = true;
+        for(std::atomic<int>& count : runs){
+            once = once && count == 1;
+        }
+        Expect(threads == 1 ? "nested batches run every task once, 1 thread" : "nested batches run every task once", once);
+
+        //the first exception comes out of wait, the other tasks still run and the pool stays usable
+        std::atomic<int> finished(0);
+        ThreadPool::Batch throwing(pool);
+        for(int i = 0; i < 20; i++){
+            throwing.submit([&, i]{
+                if(i == 7){
+                    throw std::runtime_error("task 7");
+                }
+                finished++;
+            });
+        }
+        std::string error;
+        try{
+            throwing.wait();
+        }
+        catch(const std::runtime_error& e){
+            error = e.what();
+        }
+        Expect("Batch::wait rethrows the task's exception", error == "task 7" && finished == 19);
+
+        //an inner batch's exception reaches the outer wait through the task that waited for it
+        error.clear();
+        ThreadPool::Batch nested(pool);
+        nested.submit([&]{
+            ThreadPool::Batch inner(pool);
+            inner.submit([]{ throw std::runtime_error("inner"); });
+            inner.wait();
+        });
+        try{
+            nested.wait();
+        }
+        catch(const std::runtime_error& e){
+            error = e.what();
+        }
+        Expect("an inner batch's exception reaches the outer wait", error == "inner");
+
+        //plain submits: ThreadPool::wait rethrows, and refuses to be called from a task of the pool
+        error.clear();
+        pool.submit([]{ throw std::runtime_error("plain"); });
+        try{
+            pool.wait();
+        }
+        catch(const std::runtime_error& e){
+            error = e.what();
+        }
+        Expect("ThreadPool::wait rethrows a plain task's exception", error == "plain");
+        bool refused = false;
+        ThreadPool::Batch selfWait(pool);
+        selfWait.submit([&]{
+            try{
+                pool.wait();
+            }
+            catch(const std::runtime_error&){
+                refused = true;
+            }
+        });
+        selfWait.wait();
+        Expect("ThreadPool::wait from a task throws", refused);
+    }
+}
+
+//IndicatorScan::run on fetched bars against one IndicatorSession::computeAll per symbol, also run from inside a task
+static void CheckScanFetched(Fixture&){
+    const IndicatorSession::Spec SPECS[] = {
+        {IndicatorSession::ADOSC, 50, 3, 10, ""},
+        {IndicatorSession::CHAIKIN_AD, 40, 0, 0, ""},
+        {IndicatorSession::TRUE_RANGE, 20, 0, 0, ""},
+        {IndicatorSession::SMA, 50, 20, 0, "close"},
+        {IndicatorSession::EMA, 30, 14, 0, "high"},
+    };
+    std::vector<GeneralInfo::BatchResultTS> fetched(9);
+    for(size_t i = 0; i < fetched.size(); i++){
+        fetched[i].symbol = "S" + std::to_string(i);
+        fetched[i].ok = (i != 4);
+        if(fetched[i].ok){
+            SyntheticBars::Generate(fetched[i].bars, 300 + 37 * i, SEED + i);
+        }
+        else{
+            fetched[i].error = "fetch failed";
+        }
+    }
+    ThreadPool pool(4);
+    IndicatorScan scan("1min", pool);
+    for(const IndicatorSession::Spec& spec : SPECS){
+        scan.add(spec);
+    }
+    std::vector<IndicatorScan::SymbolResult> direct = scan.run(fetched);
+    std::vector<IndicatorScan::SymbolResult> nested;
+    ThreadPool::Batch batch(pool);
+    batch.submit([&]{ nested = scan.run(fetched); });
+    batch.wait();
+
+    for(const std::vector<IndicatorScan::SymbolResult> *results : {&direct, &nested}){
+        const char *check = results == &direct ? "scan on fetched bars" : "scan on fetched bars, inside a task";
+        Expect(check, results->size() == fetched.size());
+        for(size_t i = 0; i < fetched.size() && i < results->size(); i++){
+            const IndicatorScan::SymbolResult& result = (*results)[i];
+            if(!fetched[i].ok){
+                Expect(check, !result.ok && result.error == "fetch failed" && result.symbol == fetched[i].symbol);
+                continue;
+            }
+            IndicatorSession session(fetched[i].symbol, "1min");
+            for(const IndicatorSession::Spec& spec : SPECS){
+                session.add(spec);
+            }
+            *session.getData().valuesTS = fetched[i].bars;
+            session.computeAll();
+            bool same = result.ok && result.symbol == fetched[i].symbol && result.results.size() == sizeof(SPECS) / sizeof(SPECS[0]);
+            for(size_t j = 0; same && j < result.results.size(); j++){
+                const std::vector<std::pair<std::string, double>>& expected = session.getResult(j);
+                same = !expected.empty() && result.results[j].size() == expected.size();
+                for(size_t k = 0; same && k < expected.size(); k++){
+                    same = result.results[j][k].first == expected[k].first
+                           && std::memcmp(&result.results[j][k].second, &expected[k].second, sizeof(double)) == 0;
+                }
+            }
+            if(!same){
+                std::printf("FAIL %s: %s differs from its own session (%s)\n", check, result.symbol.c_str(), result.error.c_str());
+                failures++;
+            }
+        }
+    }
+}
+
+//EpochTime::Parse against a day by day calendar walk over 1600-2401 (naive leap rule), the text forms it must refuse,
+//and Format(Parse(x)) == x on random timestamps of years 0000-9999
+static void CheckEpochTime(Fixture&){
+    int64_t year = 1600, days = -135140;   //days of 1600-01-01 since 1970-01-01
+    unsigned month = 1, day = 1;
+    char text[32];
+    bool walked = true;
+    while(walked && year <= 2401){
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        const unsigned MONTH_DAYS[] = {31, leap ? 29u : 28u, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        int64_t seconds = (days % 7 + 7) * 12345 % 86400;   //a different time of day every day
+        std::snprintf(text, sizeof(text), "%04lld-%02u-%02u %02lld:%02lld:%02lld", static_cast<long long>(year), month, day,
+                      static_cast<long long>(seconds / 3600), static_cast<long long>(seconds / 60 % 60), static_cast<long long>(seconds % 60));
+        int64_t parsed = 0, dateOnly = 0;
+        walked = EpochTime::Parse(text, 19, parsed) && parsed == days * 86400 + seconds
+                 && EpochTime::Parse(text, 10, dateOnly) && dateOnly == days * 86400
+                 && EpochTime::Format(parsed, true) == text && EpochTime::Format(dateOnly, false) == std::string(text, 10);
+        if(!walked){
+            std::printf("FAIL EpochTime walk: \"%s\" parsed to %lld, expected %lld\n", text, static_cast<long long>(parsed),
+                        static_cast<long long>(days * 86400 + seconds));
+            failures++;
+        }
+        days++;
+        if(++day > MONTH_DAYS[month - 1]){
+            day = 1;
+            if(++month > 12){
+                month = 1;
+                year++;
+            }
+        }
+    }
+
+    struct TextCase{
+        const char *text;
+        bool ok;
+        int64_t expected;
+    };
+    const TextCase TEXTS[] = {
+        {"1970-01-01 00:00:00", true, 0},
+        {"1969-12-31 23:59:59", true, -1},
+        {"2024-02-29 12:34:56", true, 1709210096},
+        {"2024-02-29T12:34:56", true, 1709210096},
+        {"2024-02-29", true, 1709164800},
+        {"2000-02-29", true, 951782400},
+        {"0000-01-01 00:00:00", true, -62167219200},
+        {"9999-12-31 23:59:59", true, 253402300799},
+        {"2023-02-29", false, 0},
+        {"1900-02-29 00:00:00", false, 0},
+        {"2100-02-29", false, 0},
+        {"2024-04-31", false, 0},
+        {"2024-04-00", false, 0},
+        {"2024-00-10", false, 0},
+        {"2024-13-01", false, 0},
+        {"2024-04-09 24:00:00", false, 0},
+        {"2024-04-09 23:60:00", false, 0},
+        {"2024-04-09 23:59:60", false, 0},
+        {"2024-04-09t13:58:00", false, 0},
+        {"2024-04-09_13:58:00", false, 0},
+        {"2024/04/09 13:58:00", false, 0},
+        {"2024-04-09 13.58.00", false, 0},
+        {"2024-04-09 13:58:0a", false, 0},
+        {"2024-04-0: 13:58:00", false, 0},
+        {"+024-04-09", false, 0},
+        {"2024-04-09 13:58", false, 0},
+        {"2024-4-9", false, 0},
+        {" 2024-04-09", false, 0},
+        {"", false, 0},
+    };
+    for(const TextCase& time : TEXTS){
+        int64_t parsed = 0;
+        bool ok = EpochTime::Parse(time.text, std::strlen(time.text), parsed);
+        if(ok != time.ok || (ok && parsed != time.expected)){
+            std::printf("FAIL EpochTime::Parse(\"%s\") is %s %lld, expected %s %lld\n", time.text, ok ? "ok" : "refused",
+                        static_cast<long long>(parsed), time.ok ? "ok" : "refused", static_cast<long long>(time.expected));
+            failures++;
+        }
+    }
+
+    const int64_t FIRST = -62167219200, LAST = 253402300799;   //0000-01-01 00:00:00, 9999-12-31 23:59:59
+    uint64_t state = SEED;
+    for(int n = 0; n < 200000; n++){
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        int64_t epoch = FIRST + static_cast<int64_t>((state >> 11) % static_cast<uint64_t>(LAST - FIRST + 1));
+        std::string formatted = EpochTime::Format(epoch, true);
+        int64_t parsed = 0;
+        if(!EpochTime::Parse(formatted, parsed) || parsed != epoch || EpochTime::Format(parsed, true) != formatted){
+            std::printf("FAIL EpochTime round trip of %lld: \"%s\" parsed to %lld\n", static_cast<long long>(epoch),
+                        formatted.c_str(), static_cast<long long>(parsed));
+            failures++;
+            return;
+        }
+    }
+}
+
+static const Check CHECKS[] = {
+    {"StreamingMovingAverages", CheckStreamingMovingAverages},
+    {"StreamingRanges", CheckStreamingRanges},
+    {"StreamingChaikin", CheckStreamingChaikin},
+    {"StreamingSnapshots", CheckStreamingSnapshots},
+    {"TransformFormulas", CheckTransformFormulas},
+    {"TransformKernels", CheckTransformKernels},
+    {"ExtremaWindow", CheckExtremaWindow},
+    {"ExtremaStreaming", CheckExtremaStreaming},
+    {"MomentsStreaming", CheckMomentsStreaming},
+    {"MomentsIndicators", CheckMomentsIndicators},
+    {"SnapshotRoundTrip", CheckSnapshotRoundTrip},
+    {"SnapshotDamage", CheckSnapshotDamage},
+    {"CsvRoundTrip", CheckCsvRoundTrip},
+    {"CsvLayouts", CheckCsvLayouts},
+    {"CsvNumbers", CheckCsvNumbers},
+    {"RangeQueries", CheckRangeQueries},
+    {"SessionChaikin", CheckSessionChaikin},
+    {"SessionIndicators", CheckSessionIndicators},
+    {"TimeSeriesParser", CheckTimeSeriesParser},
+    {"CacheMerge", CheckCacheMerge},
+    {"ThreadPool", CheckThreadPool},
+    {"ScanFetched", CheckScanFetched},
+    {"EpochTime", CheckEpochTime},
+};
+
+
+//RUNNER
+
+int main(int argc, char **argv){
+    std::string filter;
+    for(int i = 1; i < argc; i++){
+        if(std::strncmp(argv[i], "--filter=", 9) == 0){
+            filter = argv[i] + 9;
+        }
+        else{
+            std::fprintf(stderr, "usage: %s [--filter=NAME]\n", argv[0]);
+            return 2;
+        }
+    }
+    Fixture fixture;
+    fixture.bars = BARS;
+    SyntheticBars::Generate(*fixture.analytics.valuesTS, BARS, SEED);
+    ColumnView<double> closes = fixture.analytics.valuesTS->getCloses();
+    fixture.closes.assign(closes.begin(), closes.end());
+
+    size_t run = 0;
+    for(const Check& check : CHECKS){
+        if(!filter.empty() && std::string(check.name).find(filter) == std::string::npos){
+            continue;
+        }
+        size_t failuresBefore = failures;
+        try{
+            check.run(fixture);
+        }
+        catch(const std::exception& error){
+            std::printf("FAIL %s: threw %s\n", check.name, error.what());
+            failures++;
+        }
+        std::printf("%-28s %s\n", check.name, failures == failuresBefore ? "ok" : "FAILED");
+        std::fflush(stdout);
+        run++;
+    }
+    std::printf("%zu checks, %zu failures\n", run, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+#!/usr/bin/env python3
+"""Local stand-in for the TwelveData REST API, for offline runs, load tests and end to end benchmarks.
+
+Replays the recorded responses in fixtures/ for /time_series, /exchange_rate and /currency_conversion. Point the
+library at it with the environment (or HttpClient::setBaseURL):
+
+    python3 replay/mock_twelvedata.py --port 8080 --latency-ms 40 --jitter-ms 20 --error-rate 0.01 &
+    TWELVEDATA_BASE_URL=http://127.0.0.1:8080 TWELVEDATA_API_KEY=mock ./test
+
+Fixtures: fixtures/<endpoint>_<SYMBOL>.json is replayed for that symbol ('/' in the symbol written as '_'),
+fixtures/<endpoint>.json for every other one. The recorded symbol, interval and amount are replaced by the requested
+ones. New fixtures are recorded with Parse::SetDebugDump(true), which writes every response the library receives.
+
+/time_series answers 'outputsize' bars (30 when missing) and honours 'start_date'. When more bars are asked for than the
+fixture holds, older bars are added by a seeded random walk from the oldest recorded bar, so payloads of any size are
+available (--bars forces the size for every request). Responses are cached per request, so the server stays cheap
+next to the client under load.
+
+Faults, each drawn per request:
+    --error-rate       API error payload ({"code":429,"status":"error"...}), as TwelveData sends on rate limits
+    --http-error-rate  HTTP 503 with an empty body
+    --truncate-rate    the body is cut off half way and the connection closed (malformed/incomplete payload)
+"""
+
+import argparse
+import datetime
+import json
+import os
+import random
+import sys
+import threading
+import time
+import urllib.parse
+import zlib
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+ENDPOINTS = ("time_series", "exchange_rate", "currency_conversion")
+
+DEFAULT_OUTPUT_SIZE = 30
+
+#seconds per bar of the intervals the API knows. Months are counted as 30 days, the walk only needs a spacing
+INTERVAL_SECONDS = {
+    "1min": 60, "5min": 300, "15min": 900, "30min": 1800, "45min": 2700,
+    "1h": 3600, "2h": 7200, "4h": 14400, "8h": 28800,
+    "1day": 86400, "1week": 604800, "1month": 2592000,
+}
+
+CACHE_SIZE = 256
+
+
+class Fixtures:
+    """Recorded responses by endpoint and symbol, loaded once at start."""
+
+    def __init__(self, directory):
+        self.responses = {}
+        for name in sorted(os.listdir(directory)):
+            if not name.endswith(".json"):
+                continue
+            with open(os.path.join(directory, name)) as file:
+                self.responses[name[:-len(".json")]] = json.load(file)
+        missing = [endpoint for endpoint in ENDPOINTS if endpoint not in self.responses]
+        if missing:
+            raise SystemExit("mock_twelvedata: no fixture for %s in %s" % (", ".join(missing), directory))
+
+    def find(self, endpoint, symbol):
+        return self.responses.get(endpoint + "_" + symbol.replace("/", "_"), self.responses[endpoint])
+
+
+def format_datetime(epoch, time_of_day):
+    moment = datetime.datetime.fromtimestamp(epoch, datetime.timezone.utc)
+    return moment.strftime("%Y-%m-%d %H:%M:%S" if time_of_day else "%Y-%m-%d")
+
+
+def parse_datetime(text):
+    for layout in ("%Y-%m-%d %H:%M:%S", "%Y-%m-%dT%H:%M:%S", "%Y-%m-%d"):
+        try:
+            moment = datetime.datetime.strptime(text, layout)
+            return int(moment.replace(tzinfo=datetime.timezone.utc).timestamp())
+        except ValueError:
+            pass
+    return None
+
+
+def extend_bars(values, count, spacing, seed):
+    """'values' (newest first) padded to 'count' bars with older bars of a random walk, or cut to 'count'."""
+    if len(values) >= count:
+        return values[:count]
+    bars = list(values)
+    time_of_day = len(bars[-1]["datetime"]) > 10
+    epoch = parse_datetime(bars[-1]["datetime"])
+    close = float(bars[-1]["open"])
+    walk = random.Random(seed)
+    while len(bars) < count:
+        epoch -= spacing
+        change = (walk.random() - 0.5) * 0.002
+        open_price = close / (1.0 + change)
+        high = max(open_price, close) * (1.0 + walk.random() * 0.001)
+        low = min(open_price, close) * (1.0 - walk.random() * 0.001)
+        bars.append({
+            "datetime": format_datetime(epoch, time_of_day),
+            "open": "%.5f" % open_price,
+            "high": "%.5f" % high,
+            "low": "%.5f" % low,
+            "close": "%.5f" % close,
+            "volume": str(1000 + int(walk.random() * 100000)),
+        })
+        close = open_price
+    return bars
+
+
+class MockApi:
+    """Builds response bodies from the fixtures, and decides per request which fault (if any) to inject."""
+
+    def __init__(self, options):
+        self.options = options
+        self.fixtures = Fixtures(options.fixtures)
+        self.cache = {}
+        self.lock = threading.Lock()
+        self.faults = random.Random(options.seed)
+
+    def body(self, endpoint, query):
+        #the key is left out, responses do not depend on it
+        key = (endpoint, tuple(sorted((name, value) for name, value in query.items() if name != "apikey")))
+        with self.lock:
+            cached = self.cache.get(key)
+        if cached is not None:
+            return cached
+        symbol = query.get("symbol", "")
+        document = json.loads(json.dumps(self.fixtures.find(endpoint, symbol)))
+        if endpoint == "time_series":
+            self.fill_time_series(document, query)
+        elif symbol:
+            document["symbol"] = symbol
+            if endpoint == "currency_conversion":
+                amount = float(query.get("amount", "1"))
+                document["amount"] = round(document["rate"] * amount, 5)
+        body = json.dumps(document, separators=(",", ":")).encode()
+        with self.lock:
+            if len(self.cache) >= CACHE_SIZE:
+                self.cache.clear()
+            self.cache[key] = body
+        return body
+
+    def fill_time_series(self, document, query):
+        interval = query.get("interval", document["meta"].get("interval", "1min"))
+        if self.options.bars:
+            count = self.options.bars
+        else:
+            try:
+                count = max(1, int(query.get("outputsize", DEFAULT_OUTPUT_SIZE)))
+            except ValueError:
+                count = DEFAULT_OUTPUT_SIZE
+        #crc32, not hash(): string hashes change from run to run
+        seed = zlib.crc32(("%d %s %s" % (self.options.seed, query.get("symbol", ""), interval)).encode())
+        values = extend_bars(document["values"], count, INTERVAL_SECONDS.get(interval, 60), seed)
+        start = parse_datetime(query.get("start_date", ""))
+        if start is not None:
+            values = [bar for bar in values if parse_datetime(bar["datetime"]) >= start]
+        document["values"] = values
+        document["meta"]["interval"] = interval
+        if "symbol" in query:
+            document["meta"]["symbol"] = query["symbol"]
+
+    def pick_fault(self):
+        with self.lock:
+            draw = self.faults.random()
+            delay = self.options.latency_ms + self.faults.uniform(-1.0, 1.0) * self.options.jitter_ms
+        fault = None
+        for name, rate in (("api", self.options.error_rate), ("http", self.options.http_error_rate),
+                           ("truncate", self.options.truncate_rate)):
+            if draw < rate:
+                fault = name
+                break
+            draw -= rate
+        return fault, max(0.0, delay) / 1000.0
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    api = None
+
+    def do_GET(self):
+        url = urllib.parse.urlsplit(self.path)
+        endpoint = url.path.strip("/")
+        query = dict(urllib.parse.parse_qsl(url.query))
+        fault, delay = self.api.pick_fault()
+        if delay > 0:
+            time.sleep(delay)
+
+        if endpoint not in ENDPOINTS:
+            self.reply(404, json.dumps({"code": 404, "message": "unknown endpoint /" + endpoint, "status": "error"}).encode())
+        elif fault == "http":
+            self.reply(503, b"")
+        elif fault == "api":
+            self.reply(200, json.dumps({"code": 429, "message": "mock_twelvedata: injected rate limit error",
+                                        "status": "error"}).encode())
+        else:
+            body = self.api.body(endpoint, query)
+            if fault == "truncate":
+                #announce the whole body, send half of it, hang up
+                self.send_response(200)
+                self.send_header("Content-Type", "application/json")
+                self.send_header("Content-Length", str(len(body)))
+                self.end_headers()
+                self.wfile.write(body[:len(body) // 2])
+                self.close_connection = True
+            else:
+                self.reply(200, body)
+        if self.api.options.verbose:
+            sys.stderr.write("%s %s -> %s\n" % (self.command, self.path, fault or "ok"))
+
+    def reply(self, status, body):
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, *arguments):
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Local mock of the TwelveData REST API replaying recorded fixtures.")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8080)
+    parser.add_argument("--fixtures", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "fixtures"),
+                        help="directory of recorded responses (default: fixtures/ next to this script)")
+    parser.add_argument("--latency-ms", type=float, default=0.0, help="delay before every response")
+    parser.add_argument("--jitter-ms", type=float, default=0.0, help="uniform +- spread around --latency-ms")
+    parser.add_argument("--bars", type=int, default=0, help="bars in every /time_series response, overrides outputsize")
+    parser.add_argument("--error-rate", type=float, default=0.0, help="share of requests answered with an API error payload")
+    parser.add_argument("--http-error-rate", type=float, default=0.0, help="share of requests answered with HTTP 503")
+    parser.add_argument("--truncate-rate", type=float, default=0.0, help="share of responses cut off half way")
+    parser.add_argument("--seed", type=int, default=1, help="seed of the fault draws and the generated bars")
+    parser.add_argument("--verbose", action="store_true", help="log every request to stderr")
+    options = parser.parse_args()
+
+    Handler.api = MockApi(options)
+    server = ThreadingHTTPServer((options.host, options.port), Handler)
+    server.daemon_threads = True
+    sys.stderr.write("mock_twelvedata: serving %s on http://%s:%d\n" % (options.fixtures, options.host, options.port))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
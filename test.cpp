@@ -24,13 +24,13 @@ int main() {
     // int i= 1;
     // int j = 1;
 
-    // for (const auto& stockValue : *(dataReport.valuesTS)) {
-    //     std::cout << "Datetime: " << stockValue.dateTime
-    //               << ", Open: " << stockValue.open
-    //               << ", High: " << stockValue.high
-    //               << ", Low: " << stockValue.low
-    //               << ", Close: " << stockValue.close
-    //               << ", Volume: " << stockValue.volume
+    // for (int i = 0; i < dataReport.valuesTS->size(); i++) {
+    //     std::cout << "Datetime: " << dataReport.getTimeStampTSAt(i)
+    //               << ", Open: " << dataReport.getOpenTSAt(i)
+    //               << ", High: " << dataReport.getHighTSAt(i)
+    //               << ", Low: " << dataReport.getLowTSAt(i)
+    //               << ", Close: " << dataReport.getCloseTSAt(i)
+    //               << ", Volume: " << dataReport.getVolumeTSAt(i)
     //               << std::endl;
     // }
     // Analytics a;
@@ -53,9 +53,9 @@ int main() {
     std::vector<double> pass = {0,1,2,3,4,5,6,7,8,9,10};
     int periods = 2; //added periods - 1 intervals
     a.setValuesTS("AAPL", "5min", "11");
-    std::vector<double> highs = a.getHighs();
-    std::vector<double> lows = a.getLows();
-    std::vector<double> closes = a.getCloses();
+    ColumnView<double> highs = a.getHighs();
+    ColumnView<double> lows = a.getLows();
+    ColumnView<double> closes = a.getCloses();
     
     for(auto value : highs){
         std::cout << value << "\n";